@@ -17,6 +17,7 @@ namespace RealtimeMesh
 {
 	FRealtimeMesh::FRealtimeMesh(const FRealtimeMeshSharedResourcesRef& InSharedResources)
 		: SharedResources(InSharedResources)
+		, bMergeCompatibleSections(false)
 	{
 		SharedResources->OnLODBoundsChanged().AddRaw(this, &FRealtimeMesh::HandleLODBoundsChanged);
 	}
@@ -263,6 +264,33 @@ namespace RealtimeMesh
 	}
 
 
+	bool FRealtimeMesh::IsMergingCompatibleSections() const
+	{
+		FRealtimeMeshScopeGuardRead ScopeGuard(SharedResources->GetGuard());
+		return bMergeCompatibleSections;
+	}
+
+	void FRealtimeMesh::SetMergeCompatibleSections(FRealtimeMeshProxyCommandBatch& Commands, bool bInMergeCompatibleSections)
+	{
+		FRealtimeMeshScopeGuardWrite ScopeGuard(SharedResources->GetGuard());
+		bMergeCompatibleSections = bInMergeCompatibleSections;
+
+		if (Commands)
+		{
+			Commands.AddMeshTask([bInMergeCompatibleSections](FRealtimeMeshProxy& Proxy)
+			{
+				Proxy.SetMergeCompatibleSections(bInMergeCompatibleSections);
+			}, true);
+		}
+	}
+
+	TFuture<ERealtimeMeshProxyUpdateStatus> FRealtimeMesh::SetMergeCompatibleSections(bool bInMergeCompatibleSections)
+	{
+		FRealtimeMeshProxyCommandBatch Commands(SharedResources->GetOwner());
+		SetMergeCompatibleSections(Commands, bInMergeCompatibleSections);
+		return Commands.Commit();
+	}
+
 	void FRealtimeMesh::SetDistanceField(FRealtimeMeshProxyCommandBatch& Commands, FRealtimeMeshDistanceField&& InDistanceField)
 	{
 		FRealtimeMeshScopeGuardWrite ScopeGuard(SharedResources->GetGuard());
@@ -456,9 +484,10 @@ namespace RealtimeMesh
 	{
 		if (Commands)
 		{
-			Commands.AddMeshTask([Config = Config](FRealtimeMeshProxy& Proxy)
+			Commands.AddMeshTask([Config = Config, bMerge = bMergeCompatibleSections](FRealtimeMeshProxy& Proxy)
 			{
 				Proxy.Reset();
+				Proxy.SetMergeCompatibleSections(bMerge);
 			}, true);
 
 			// Update existing LODs
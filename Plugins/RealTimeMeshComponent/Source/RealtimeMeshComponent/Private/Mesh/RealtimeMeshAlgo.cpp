@@ -6,6 +6,8 @@
 #include "Mesh/RealtimeMeshBuilder.h"
 #include "Mesh/RealtimeMeshDataStream.h"
 #include "Mesh/RealtimeMeshDataTypes.h"
+#include "Async/ParallelFor.h"
+#include "Containers/HashTable.h"
 
 using namespace RealtimeMesh;
 
@@ -282,126 +284,215 @@ TOptional<TMap<int32, FRealtimeMeshStreamRange>> RealtimeMeshAlgo::GetStreamRang
 }
 
 
-void RealtimeMeshAlgo::GenerateTangents(RealtimeMesh::FRealtimeMeshStreamSet& StreamSet, bool bComputeSmoothNormals)
+namespace RealtimeMeshAlgo::Private
 {
-	if (!StreamSet.Contains(FRealtimeMeshStreams::Triangles) || !StreamSet.Contains(FRealtimeMeshStreams::Position))
+	// Smallest amount of work handed to a single worker by the tangent passes
+	static constexpr int32 TangentsMinBatchSize = 1024;
+
+	// Weld cells are twice the Equals() tolerance so any matching pair lands in the same or an adjacent cell
+	static constexpr double TangentsWeldCellSize = KINDA_SMALL_NUMBER * 2.0;
+
+	struct FTangentsWeldCell
 	{
-		return;
+		int64 X;
+		int64 Y;
+		int64 Z;
+
+		bool operator==(const FTangentsWeldCell& Other) const { return X == Other.X && Y == Other.Y && Z == Other.Z; }
+	};
+
+	static int64 QuantizeWeldCoordinate(float Value)
+	{
+		// Clamped so garbage positions can't overflow the cast, they'll just share an edge cell
+		constexpr double MaxCell = double(1ll << 52);
+		return static_cast<int64>(FMath::Clamp(FMath::FloorToDouble(Value / TangentsWeldCellSize), -MaxCell, MaxCell));
 	}
 
-	TRealtimeMeshStreamBuilder<FVector3f> Positions(StreamSet.FindChecked(FRealtimeMeshStreams::Position));
-	TRealtimeMeshStreamBuilder<TIndex3<uint32>> Triangles(StreamSet.FindChecked(FRealtimeMeshStreams::Triangles));
-	TOptional<TRealtimeMeshStridedStreamBuilder<FVector2f, void>> TexCoords;
+	static uint32 HashWeldCell(int64 X, int64 Y, int64 Z)
+	{
+		return HashCombine(HashCombine(GetTypeHash(X), GetTypeHash(Y)), GetTypeHash(Z));
+	}
 
-	if (StreamSet.Contains(FRealtimeMeshStreams::TexCoords))
+	static void ParallelForTangents(const TCHAR* DebugName, int32 Num, TFunctionRef<void(int32)> Body)
 	{
-		TexCoords = TRealtimeMeshStridedStreamBuilder<FVector2f, void>(StreamSet.FindChecked(FRealtimeMeshStreams::TexCoords));
+#if RMC_ENGINE_ABOVE_5_1
+		ParallelFor(DebugName, Num, TangentsMinBatchSize, Body);
+#else
+		ParallelFor(Num, Body, Num < TangentsMinBatchSize);
+#endif
 	}
+}
 
-	StreamSet.Remove(FRealtimeMeshStreams::Tangents);
-	TRealtimeMeshStreamBuilder<FRealtimeMeshTangentsNormalPrecision> Tangents(StreamSet.AddStream<FRealtimeMeshTangentsNormalPrecision>(FRealtimeMeshStreams::Tangents));
-	Tangents.SetNumZeroed(Positions.Num());
-	
-	uint32 NumIndices = Triangles.Num() * 3;
-	uint32 NumVertices = Positions.Num();
+void RealtimeMeshAlgo::Private::FindOverlappingVertices(TConstArrayView<const FVector3f> Vertices, TArray<int32>& OutOffsets, TArray<uint32>& OutOverlaps)
+{
+	const int32 NumVertices = Vertices.Num();
 
-	// Calculate the duplicate vertices map if we're wanting smooth normals.  Don't find duplicates if we don't want smooth normals
-	// that will cause it to only smooth across faces sharing a common vertex, not across faces with vertices of common position
-	TMultiMap<uint32, uint32> DuplicateVertexMap;
+	OutOffsets.SetNumUninitialized(NumVertices + 1);
+	OutOverlaps.Reset();
+	if (NumVertices == 0)
+	{
+		OutOffsets[0] = 0;
+		return;
+	}
 
-	if (bComputeSmoothNormals)
+	TArray<FTangentsWeldCell> Cells;
+	TArray<float> SortValues;
+	Cells.SetNumUninitialized(NumVertices);
+	SortValues.SetNumUninitialized(NumVertices);
+	ParallelForTangents(TEXT("RealtimeMeshTangentsWeldCells.PF"), NumVertices, [&](int32 Index)
 	{
-		using namespace Private;
+		const FVector3f& Position = Vertices[Index];
+		Cells[Index] = { QuantizeWeldCoordinate(Position.X), QuantizeWeldCoordinate(Position.Y), QuantizeWeldCoordinate(Position.Z) };
+		SortValues[Index] = FRealtimeMeshVertexSortElement(Index, Position).Value;
+	});
 
-		TArray<FRealtimeMeshVertexSortElement> VertexSorter;
-		VertexSorter.Empty(NumVertices);
-		for (uint32 Index = 0; Index < NumVertices; Index++)
-		{
-			new(VertexSorter)FRealtimeMeshVertexSortElement(Index, Positions[Index]);
-		}
+	FHashTable HashTable(FMath::RoundUpToPowerOfTwo(FMath::Clamp(NumVertices, 1024, 1 << 22)), NumVertices);
+	for (int32 Index = 0; Index < NumVertices; Index++)
+	{
+		const FTangentsWeldCell& Cell = Cells[Index];
+		HashTable.Add(HashWeldCell(Cell.X, Cell.Y, Cell.Z), Index);
+	}
 
-		// Sort the list
-		VertexSorter.Sort(FRuntimeMeshVertexSortingFunction());
+	// Same match test as the old sorted sweep, the sort value window and then Equals(), so the pairs don't change
+	const auto ForEachOverlap = [&](int32 Index, auto&& Func)
+	{
+		const FVector3f& Position = Vertices[Index];
+		const float SortValue = SortValues[Index];
+		const FTangentsWeldCell& Cell = Cells[Index];
 
-		// Map out the duplicates.
-		for (uint32 Index = 0; Index < NumVertices; Index++)
+		for (int64 OffsetZ = -1; OffsetZ <= 1; OffsetZ++)
 		{
-			uint32 SrcVertIdx = VertexSorter[Index].Index;
-			float Value = VertexSorter[Index].Value;
-
-			// Search forward adding pairs both ways
-			for (uint32 SubIndex = Index + 1; SubIndex < NumVertices; SubIndex++)
+			for (int64 OffsetY = -1; OffsetY <= 1; OffsetY++)
 			{
-				if (FMath::Abs(VertexSorter[SubIndex].Value - Value) > THRESH_POINTS_ARE_SAME * 4.01f)
+				for (int64 OffsetX = -1; OffsetX <= 1; OffsetX++)
 				{
-					// No more possible duplicates
-					break;
-				}
-
-				uint32 OtherVertIdx = VertexSorter[SubIndex].Index;
-				if (Positions.GetValue(SrcVertIdx).Equals(Positions.GetValue(OtherVertIdx)))
-				{
-					DuplicateVertexMap.AddUnique(SrcVertIdx, OtherVertIdx);
-					DuplicateVertexMap.AddUnique(OtherVertIdx, SrcVertIdx);
+					const FTangentsWeldCell NeighborCell = { Cell.X + OffsetX, Cell.Y + OffsetY, Cell.Z + OffsetZ };
+					const uint32 Hash = HashWeldCell(NeighborCell.X, NeighborCell.Y, NeighborCell.Z);
+					for (uint32 OtherIndex = HashTable.First(Hash); HashTable.IsValid(OtherIndex); OtherIndex = HashTable.Next(OtherIndex))
+					{
+						// Different cells can share a bucket, only visit each vertex from its own cell
+						if (OtherIndex == uint32(Index) || !(Cells[OtherIndex] == NeighborCell))
+						{
+							continue;
+						}
+
+						if (FMath::Abs(SortValues[OtherIndex] - SortValue) <= THRESH_POINTS_ARE_SAME * 4.01f && Position.Equals(Vertices[OtherIndex]))
+						{
+							Func(OtherIndex);
+						}
+					}
 				}
 			}
 		}
+	};
+
+	// Count, then fill, so the result can be written in place without per vertex allocations
+	TArray<int32> Counts;
+	Counts.SetNumUninitialized(NumVertices);
+	ParallelForTangents(TEXT("RealtimeMeshTangentsWeldCount.PF"), NumVertices, [&](int32 Index)
+	{
+		int32 Count = 0;
+		ForEachOverlap(Index, [&Count](uint32) { Count++; });
+		Counts[Index] = Count;
+	});
+
+	OutOffsets[0] = 0;
+	for (int32 Index = 0; Index < NumVertices; Index++)
+	{
+		OutOffsets[Index + 1] = OutOffsets[Index] + Counts[Index];
 	}
 
-	// Number of triangles
-	const uint32 NumTris = NumIndices / 3;
+	OutOverlaps.SetNumUninitialized(OutOffsets[NumVertices]);
+	ParallelForTangents(TEXT("RealtimeMeshTangentsWeldFill.PF"), NumVertices, [&](int32 Index)
+	{
+		int32 WriteIndex = OutOffsets[Index];
+		ForEachOverlap(Index, [&](uint32 OtherIndex) { OutOverlaps[WriteIndex++] = OtherIndex; });
+	});
+}
 
-	// Map of vertex to triangles in Triangles array
-	TMultiMap<uint32, uint32> VertToTriMap;
-	// Map of vertex to triangles to consider for normal calculation
-	TMultiMap<uint32, uint32> VertToTriSmoothMap;
+void RealtimeMeshAlgo::Private::BuildVertexTriangleAdjacency(TConstArrayView<const uint32> Indices, int32 NumVertices, TArray<int32>& OutOffsets,
+                                                             TArray<uint32>& OutTriangles)
+{
+	const int32 NumTris = Indices.Num() / 3;
 
-	// Normal/tangents for each face
-	TArray<FVector3f> FaceTangentX, FaceTangentY, FaceTangentZ;
-	FaceTangentX.AddUninitialized(NumTris);
-	FaceTangentY.AddUninitialized(NumTris);
-	FaceTangentZ.AddUninitialized(NumTris);
+	OutOffsets.SetNumZeroed(NumVertices + 1);
 
-	// Iterate over triangles
-	for (uint32 TriIdx = 0; TriIdx < NumTris; TriIdx++)
+	// Degenerate triangles only count once per vertex, same as the old AddUnique()
+	const auto IsFirstUseInTriangle = [&](int32 TriIdx, int32 CornerIdx)
 	{
-		uint32 CornerIndex[3];
-		FVector3f P[3];
+		const uint32 VertIndex = Indices[TriIdx * 3 + CornerIdx];
+		for (int32 PrevCornerIdx = 0; PrevCornerIdx < CornerIdx; PrevCornerIdx++)
+		{
+			if (Indices[TriIdx * 3 + PrevCornerIdx] == VertIndex)
+			{
+				return false;
+			}
+		}
+		return true;
+	};
 
+	for (int32 TriIdx = 0; TriIdx < NumTris; TriIdx++)
+	{
 		for (int32 CornerIdx = 0; CornerIdx < 3; CornerIdx++)
 		{
-			// Find vert index (clamped within range)
-			uint32 VertIndex = FMath::Min(Triangles.GetElementValue(TriIdx, CornerIdx), NumVertices - 1);
+			if (IsFirstUseInTriangle(TriIdx, CornerIdx))
+			{
+				OutOffsets[Indices[TriIdx * 3 + CornerIdx] + 1]++;
+			}
+		}
+	}
 
-			CornerIndex[CornerIdx] = VertIndex;
-			P[CornerIdx] = Positions.GetValue(VertIndex);
+	for (int32 Index = 0; Index < NumVertices; Index++)
+	{
+		OutOffsets[Index + 1] += OutOffsets[Index];
+	}
 
-			// Find/add this vert to index buffer
-			TArray<uint32> VertOverlaps;
-			DuplicateVertexMap.MultiFind(VertIndex, VertOverlaps);
+	// Filling in triangle order leaves every vertex's list sorted
+	TArray<int32> WriteOffsets(OutOffsets.GetData(), NumVertices);
+	OutTriangles.SetNumUninitialized(OutOffsets[NumVertices]);
+	for (int32 TriIdx = 0; TriIdx < NumTris; TriIdx++)
+	{
+		for (int32 CornerIdx = 0; CornerIdx < 3; CornerIdx++)
+		{
+			if (IsFirstUseInTriangle(TriIdx, CornerIdx))
+			{
+				OutTriangles[WriteOffsets[Indices[TriIdx * 3 + CornerIdx]]++] = TriIdx;
+			}
+		}
+	}
+}
 
-			// Remember which triangles map to this vert
-			VertToTriMap.AddUnique(VertIndex, TriIdx);
-			VertToTriSmoothMap.AddUnique(VertIndex, TriIdx);
+void RealtimeMeshAlgo::Private::ComputeVertexTangents(TConstArrayView<const uint32> Indices, TConstArrayView<const FVector3f> Vertices,
+                                                      TConstArrayView<const FVector2f> UVs, bool bComputeSmoothNormals,
+                                                      TArray<FVector3f>& OutTangentX, TArray<FVector3f>& OutTangentY, TArray<FVector3f>& OutTangentZ)
+{
+	const int32 NumVertices = Vertices.Num();
+	const int32 NumTris = Indices.Num() / 3;
+	const bool bHasUVs = UVs.Num() >= NumVertices;
 
-			// Also update map of triangles that 'overlap' this vert (ie don't match UV, but do match smoothing) and should be considered when calculating normal
-			for (int32 OverlapIdx = 0; OverlapIdx < VertOverlaps.Num(); OverlapIdx++)
-			{
-				// For each vert we overlap..
-				int32 OverlapVertIdx = VertOverlaps[OverlapIdx];
+	// Calculate the duplicate vertices map if we're wanting smooth normals.  Don't find duplicates if we don't want smooth normals
+	// that will cause it to only smooth across faces sharing a common vertex, not across faces with vertices of common position
+	TArray<int32> OverlapOffsets;
+	TArray<uint32> Overlaps;
+	if (bComputeSmoothNormals)
+	{
+		FindOverlappingVertices(Vertices, OverlapOffsets, Overlaps);
+	}
 
-				// Add this triangle to that vert
-				VertToTriSmoothMap.AddUnique(OverlapVertIdx, TriIdx);
+	TArray<int32> VertToTriOffsets;
+	TArray<uint32> VertToTris;
+	BuildVertexTriangleAdjacency(Indices, NumVertices, VertToTriOffsets, VertToTris);
 
-				// And add all of its triangles to us
-				TArray<uint32> OverlapTris;
-				VertToTriMap.MultiFind(OverlapVertIdx, OverlapTris);
-				for (int32 OverlapTriIdx = 0; OverlapTriIdx < OverlapTris.Num(); OverlapTriIdx++)
-				{
-					VertToTriSmoothMap.AddUnique(VertIndex, OverlapTris[OverlapTriIdx]);
-				}
-			}
-		}
+	// Normal/tangents for each face
+	TArray<FVector3f> FaceTangentX, FaceTangentY, FaceTangentZ;
+	FaceTangentX.SetNumUninitialized(NumTris);
+	FaceTangentY.SetNumUninitialized(NumTris);
+	FaceTangentZ.SetNumUninitialized(NumTris);
+
+	ParallelForTangents(TEXT("RealtimeMeshTangentsFaces.PF"), NumTris, [&](int32 TriIdx)
+	{
+		const uint32 CornerIndex[3] = { Indices[TriIdx * 3 + 0], Indices[TriIdx * 3 + 1], Indices[TriIdx * 3 + 2] };
+		const FVector3f P[3] = { Vertices[CornerIndex[0]], Vertices[CornerIndex[1]], Vertices[CornerIndex[2]] };
 
 		// Calculate triangle edge vectors and normal
 		const FVector3f Edge21 = P[1] - P[2];
@@ -409,30 +500,11 @@ void RealtimeMeshAlgo::GenerateTangents(RealtimeMesh::FRealtimeMeshStreamSet& St
 		const FVector3f TriNormal = (Edge21 ^ Edge20).GetSafeNormal();
 
 		// If we have UVs, use those to calculate
-		if (TexCoords.IsSet())
+		if (bHasUVs)
 		{
-			const FVector2f T1 = TexCoords->GetValue(CornerIndex[0]);
-			const FVector2f T2 = TexCoords->GetValue(CornerIndex[1]);
-			const FVector2f T3 = TexCoords->GetValue(CornerIndex[2]);
-
-			// 			float X1 = P[1].X - P[0].X;
-			// 			float X2 = P[2].X - P[0].X;
-			// 			float Y1 = P[1].Y - P[0].Y;
-			// 			float Y2 = P[2].Y - P[0].Y;
-			// 			float Z1 = P[1].Z - P[0].Z;
-			// 			float Z2 = P[2].Z - P[0].Z;
-			// 
-			// 			float S1 = U1.X - U0.X;
-			// 			float S2 = U2.X - U0.X;
-			// 			float T1 = U1.Y - U0.Y;
-			// 			float T2 = U2.Y - U0.Y;
-			// 
-			// 			float R = 1.0f / (S1 * T2 - S2 * T1);
-			// 			FaceTangentX[TriIdx] = FVector((T2 * X1 - T1 * X2) * R, (T2 * Y1 - T1 * Y2) * R,
-			// 				(T2 * Z1 - T1 * Z2) * R);
-			// 			FaceTangentY[TriIdx] = FVector((S1 * X2 - S2 * X1) * R, (S1 * Y2 - S2 * Y1) * R,
-			// 				(S1 * Z2 - S2 * Z1) * R);
-
+			const FVector2f T1 = UVs[CornerIndex[0]];
+			const FVector2f T2 = UVs[CornerIndex[1]];
+			const FVector2f T3 = UVs[CornerIndex[2]];
 
 			FMatrix44f ParameterToLocal(
 				FPlane4f(P[1].X - P[0].X, P[1].Y - P[0].Y, P[1].Z - P[0].Z, 0),
@@ -461,49 +533,57 @@ void RealtimeMeshAlgo::GenerateTangents(RealtimeMesh::FRealtimeMeshStreamSet& St
 		}
 
 		FaceTangentZ[TriIdx] = TriNormal;
-	}
-
+	});
 
-	// Arrays to accumulate tangents into
-	TArray<FVector3f> VertexTangentXSum, VertexTangentYSum, VertexTangentZSum;
-	VertexTangentXSum.AddZeroed(NumVertices);
-	VertexTangentYSum.AddZeroed(NumVertices);
-	VertexTangentZSum.AddZeroed(NumVertices);
+	OutTangentX.SetNumUninitialized(NumVertices);
+	OutTangentY.SetNumUninitialized(NumVertices);
+	OutTangentZ.SetNumUninitialized(NumVertices);
 
-	// For each vertex..
-	for (uint32 VertxIdx = 0; VertxIdx < NumVertices; VertxIdx++)
+	// Each vertex only reads shared data and writes its own slot, and sums in ascending triangle order so the result
+	// doesn't depend on how the work was split
+	ParallelForTangents(TEXT("RealtimeMeshTangentsVertices.PF"), NumVertices, [&](int32 VertIdx)
 	{
-		// Find relevant triangles for normal
-		TArray<uint32> SmoothTris;
-		VertToTriSmoothMap.MultiFind(VertxIdx, SmoothTris);
+		const TConstArrayView<const uint32> TangentTris(VertToTris.GetData() + VertToTriOffsets[VertIdx], VertToTriOffsets[VertIdx + 1] - VertToTriOffsets[VertIdx]);
+
+		FVector3f TangentX = FVector3f::ZeroVector;
+		FVector3f TangentY = FVector3f::ZeroVector;
+		FVector3f TangentZ = FVector3f::ZeroVector;
 
-		for (int i = 0; i < SmoothTris.Num(); i++)
+		for (const uint32 TriIdx : TangentTris)
 		{
-			uint32 TriIdx = SmoothTris[i];
-			VertexTangentZSum[VertxIdx] += FaceTangentZ[TriIdx];
+			TangentX += FaceTangentX[TriIdx];
+			TangentY += FaceTangentY[TriIdx];
 		}
 
-		// Find relevant triangles for tangents
-		TArray<uint32> TangentTris;
-		VertToTriMap.MultiFind(VertxIdx, TangentTris);
-
-		for (int i = 0; i < TangentTris.Num(); i++)
+		const int32 NumOverlaps = bComputeSmoothNormals ? OverlapOffsets[VertIdx + 1] - OverlapOffsets[VertIdx] : 0;
+		if (NumOverlaps == 0)
 		{
-			uint32 TriIdx = TangentTris[i];
-			VertexTangentXSum[VertxIdx] += FaceTangentX[TriIdx];
-			VertexTangentYSum[VertxIdx] += FaceTangentY[TriIdx];
+			for (const uint32 TriIdx : TangentTris)
+			{
+				TangentZ += FaceTangentZ[TriIdx];
+			}
 		}
-	}
+		else
+		{
+			// Normal also considers the triangles of every vertex we overlap (ie don't match UV, but do match smoothing)
+			TArray<uint32, TInlineAllocator<64>> SmoothTris(TangentTris.GetData(), TangentTris.Num());
+			for (int32 OverlapIdx = OverlapOffsets[VertIdx]; OverlapIdx < OverlapOffsets[VertIdx + 1]; OverlapIdx++)
+			{
+				const uint32 OverlapVertIdx = Overlaps[OverlapIdx];
+				SmoothTris.Append(VertToTris.GetData() + VertToTriOffsets[OverlapVertIdx], VertToTriOffsets[OverlapVertIdx + 1] - VertToTriOffsets[OverlapVertIdx]);
+			}
+			SmoothTris.Sort();
 
-	// Finally, normalize tangents and build output arrays	
-	for (uint32 VertxIdx = 0; VertxIdx < NumVertices; VertxIdx++)
-	{
-		FVector3f& TangentX = VertexTangentXSum[VertxIdx];
-		FVector3f& TangentY = VertexTangentYSum[VertxIdx];
-		FVector3f& TangentZ = VertexTangentZSum[VertxIdx];
+			for (int32 Index = 0; Index < SmoothTris.Num(); Index++)
+			{
+				if (Index == 0 || SmoothTris[Index] != SmoothTris[Index - 1])
+				{
+					TangentZ += FaceTangentZ[SmoothTris[Index]];
+				}
+			}
+		}
 
 		TangentX.Normalize();
-		//TangentY.Normalize();
 		TangentZ.Normalize();
 
 		// Use Gram-Schmidt orthogonalization to make sure X is orthonormal with Z
@@ -511,6 +591,72 @@ void RealtimeMeshAlgo::GenerateTangents(RealtimeMesh::FRealtimeMeshStreamSet& St
 		TangentX.Normalize();
 		TangentY.Normalize();
 
-		Tangents.Set(VertxIdx, FRealtimeMeshTangentsNormalPrecision(TangentZ, TangentY, TangentX));
+		OutTangentX[VertIdx] = TangentX;
+		OutTangentY[VertIdx] = TangentY;
+		OutTangentZ[VertIdx] = TangentZ;
+	});
+}
+
+void RealtimeMeshAlgo::GenerateTangents(RealtimeMesh::FRealtimeMeshStreamSet& StreamSet, bool bComputeSmoothNormals)
+{
+	if (!StreamSet.Contains(FRealtimeMeshStreams::Triangles) || !StreamSet.Contains(FRealtimeMeshStreams::Position))
+	{
+		return;
 	}
+
+	TRealtimeMeshStreamBuilder<FVector3f> Positions(StreamSet.FindChecked(FRealtimeMeshStreams::Position));
+	TRealtimeMeshStreamBuilder<TIndex3<uint32>> Triangles(StreamSet.FindChecked(FRealtimeMeshStreams::Triangles));
+	TOptional<TRealtimeMeshStridedStreamBuilder<FVector2f, void>> TexCoords;
+
+	if (StreamSet.Contains(FRealtimeMeshStreams::TexCoords))
+	{
+		TexCoords = TRealtimeMeshStridedStreamBuilder<FVector2f, void>(StreamSet.FindChecked(FRealtimeMeshStreams::TexCoords));
+	}
+
+	StreamSet.Remove(FRealtimeMeshStreams::Tangents);
+	TRealtimeMeshStreamBuilder<FRealtimeMeshTangentsNormalPrecision> Tangents(StreamSet.AddStream<FRealtimeMeshTangentsNormalPrecision>(FRealtimeMeshStreams::Tangents));
+	Tangents.SetNumZeroed(Positions.Num());
+
+	const int32 NumVertices = Positions.Num();
+	const int32 NumTris = Triangles.Num();
+	if (NumVertices == 0)
+	{
+		return;
+	}
+
+	// Pull everything into flat arrays once, the builders convert on access and the passes below touch each value many times
+	TArray<FVector3f> Vertices;
+	Vertices.SetNumUninitialized(NumVertices);
+	TArray<FVector2f> UVs;
+	if (TexCoords.IsSet())
+	{
+		UVs.SetNumUninitialized(NumVertices);
+	}
+	Private::ParallelForTangents(TEXT("RealtimeMeshTangentsGatherVertices.PF"), NumVertices, [&](int32 Index)
+	{
+		Vertices[Index] = Positions.GetValue(Index);
+		if (TexCoords.IsSet())
+		{
+			UVs[Index] = TexCoords->GetValue(Index);
+		}
+	});
+
+	TArray<uint32> Indices;
+	Indices.SetNumUninitialized(NumTris * 3);
+	Private::ParallelForTangents(TEXT("RealtimeMeshTangentsGatherIndices.PF"), NumTris, [&](int32 TriIdx)
+	{
+		for (int32 CornerIdx = 0; CornerIdx < 3; CornerIdx++)
+		{
+			// Find vert index (clamped within range)
+			Indices[TriIdx * 3 + CornerIdx] = FMath::Min(Triangles.GetElementValue(TriIdx, CornerIdx), uint32(NumVertices - 1));
+		}
+	});
+
+	TArray<FVector3f> TangentX, TangentY, TangentZ;
+	Private::ComputeVertexTangents(Indices, Vertices, UVs, bComputeSmoothNormals, TangentX, TangentY, TangentZ);
+
+	Private::ParallelForTangents(TEXT("RealtimeMeshTangentsWrite.PF"), NumVertices, [&](int32 Index)
+	{
+		Tangents.Set(Index, FRealtimeMeshTangentsNormalPrecision(TangentZ[Index], TangentY[Index], TangentX[Index]));
+	});
 }
@@ -0,0 +1,211 @@
+﻿// Copyright TriAxis Games, L.L.C. All Rights Reserved.
+
+
+#include "Mesh/RealtimeMeshStreamPool.h"
+#include "RealtimeMeshCore.h"
+#include "RealtimeMeshMemoryStats.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/LazySingleton.h"
+
+static TAutoConsoleVariable<int32> CVarRealtimeMeshStreamPoolMaxMB(
+	TEXT("r.RealtimeMesh.StreamPool.MaxMB"),
+	128,
+	TEXT("Memory the shared stream pool keeps around for reuse, released streams past this are freed. 0 = disable pooling."),
+	ECVF_Default);
+
+DECLARE_MEMORY_STAT(TEXT("Memory - Stream Pool"), STAT_RealtimeMesh_StreamPoolMemory, STATGROUP_RealtimeMesh);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Stream Pool - Pooled Streams"), STAT_RealtimeMesh_StreamPoolStreams, STATGROUP_RealtimeMesh);
+
+namespace RealtimeMesh
+{
+	FRealtimeMeshStreamPool::FRealtimeMeshStreamPool(int64 InMaxPooledBytes)
+		: PooledBytes(0)
+		, NumPooledStreams(0)
+		, MaxPooledBytes(InMaxPooledBytes)
+	{
+	}
+
+	FRealtimeMeshStreamPool::~FRealtimeMeshStreamPool()
+	{
+		Empty();
+	}
+
+	FRealtimeMeshStreamPool& FRealtimeMeshStreamPool::Get()
+	{
+		return TLazySingleton<FRealtimeMeshStreamPool>::Get();
+	}
+
+	TUniquePtr<FRealtimeMeshStream> FRealtimeMeshStreamPool::Acquire(const FRealtimeMeshStreamKey& StreamKey, const FRealtimeMeshBufferLayout& Layout, int32 MinCapacity)
+	{
+		TUniquePtr<FRealtimeMeshStream> Stream;
+		{
+			FScopeLock ScopeLock(&Lock);
+			if (TArray<TUniquePtr<FRealtimeMeshStream>>* Bucket = FreeStreams.Find(Layout))
+			{
+				// Smallest stream that fits, or failing that the largest so growing it moves the least
+				int32 BestIndex = INDEX_NONE;
+				for (int32 Index = 0; Index < Bucket->Num(); Index++)
+				{
+					const int32 Capacity = (*Bucket)[Index]->Max();
+					if (BestIndex == INDEX_NONE)
+					{
+						BestIndex = Index;
+						continue;
+					}
+					const int32 BestCapacity = (*Bucket)[BestIndex]->Max();
+					const bool bFits = Capacity >= MinCapacity;
+					const bool bBestFits = BestCapacity >= MinCapacity;
+					const bool bIsBetter = bFits != bBestFits ? bFits : (bFits ? Capacity < BestCapacity : Capacity > BestCapacity);
+					if (bIsBetter)
+					{
+						BestIndex = Index;
+					}
+				}
+
+				if (BestIndex != INDEX_NONE)
+				{
+					Stream = MoveTemp((*Bucket)[BestIndex]);
+					Bucket->RemoveAtSwap(BestIndex, 1, false);
+					UpdateStats(-static_cast<int64>(Stream->GetAllocatedSize()), -1);
+				}
+			}
+		}
+
+		if (Stream.IsValid())
+		{
+			Stream->SetStreamKey(StreamKey);
+		}
+		else
+		{
+			LLM_SCOPE_BYTAG(RealtimeMesh);
+			Stream = MakeUnique<FRealtimeMeshStream>(StreamKey, Layout);
+		}
+
+		if (MinCapacity > 0)
+		{
+			LLM_SCOPE_BYTAG(RealtimeMesh);
+			Stream->Reserve(MinCapacity);
+		}
+		return Stream;
+	}
+
+	FRealtimeMeshStream& FRealtimeMeshStreamPool::AddStream(FRealtimeMeshStreamSet& StreamSet, const FRealtimeMeshStreamKey& StreamKey, const FRealtimeMeshBufferLayout& Layout, int32 MinCapacity)
+	{
+		if (TUniquePtr<FRealtimeMeshStream> Existing = StreamSet.Extract(StreamKey))
+		{
+			Release(MoveTemp(Existing));
+		}
+		return StreamSet.AddStream(Acquire(StreamKey, Layout, MinCapacity));
+	}
+
+	void FRealtimeMeshStreamPool::Release(TUniquePtr<FRealtimeMeshStream>&& Stream)
+	{
+		if (!Stream.IsValid())
+		{
+			return;
+		}
+
+		TUniquePtr<FRealtimeMeshStream> LocalStream = MoveTemp(Stream);
+		LocalStream->UnLink();
+		LocalStream->Empty(0, LocalStream->Max());
+
+		const int64 StreamBytes = LocalStream->GetAllocatedSize();
+		if (StreamBytes == 0 || !LocalStream->GetLayout().IsValid())
+		{
+			return;
+		}
+
+		FScopeLock ScopeLock(&Lock);
+		if (PooledBytes + StreamBytes > GetMaxPooledBytes())
+		{
+			// Over budget, let it free once we drop the lock
+			return;
+		}
+
+		FreeStreams.FindOrAdd(LocalStream->GetLayout()).Add(MoveTemp(LocalStream));
+		UpdateStats(StreamBytes, 1);
+	}
+
+	void FRealtimeMeshStreamPool::Release(FRealtimeMeshStreamSet& StreamSet)
+	{
+		TArray<TUniquePtr<FRealtimeMeshStream>, TInlineAllocator<8>> Streams;
+		StreamSet.ExtractAll(Streams);
+		for (TUniquePtr<FRealtimeMeshStream>& Stream : Streams)
+		{
+			Release(MoveTemp(Stream));
+		}
+	}
+
+	void FRealtimeMeshStreamPool::Trim(int64 MaxBytes)
+	{
+		TArray<TUniquePtr<FRealtimeMeshStream>> StreamsToFree;
+		{
+			FScopeLock ScopeLock(&Lock);
+			while (PooledBytes > MaxBytes)
+			{
+				TArray<TUniquePtr<FRealtimeMeshStream>>* LargestBucket = nullptr;
+				int32 LargestIndex = INDEX_NONE;
+				SIZE_T LargestSize = 0;
+				for (auto& Bucket : FreeStreams)
+				{
+					for (int32 Index = 0; Index < Bucket.Value.Num(); Index++)
+					{
+						if (Bucket.Value[Index]->GetAllocatedSize() > LargestSize)
+						{
+							LargestBucket = &Bucket.Value;
+							LargestIndex = Index;
+							LargestSize = Bucket.Value[Index]->GetAllocatedSize();
+						}
+					}
+				}
+
+				if (!LargestBucket)
+				{
+					break;
+				}
+
+				StreamsToFree.Add(MoveTemp((*LargestBucket)[LargestIndex]));
+				LargestBucket->RemoveAtSwap(LargestIndex, 1, false);
+				UpdateStats(-static_cast<int64>(LargestSize), -1);
+			}
+
+			if (NumPooledStreams == 0)
+			{
+				FreeStreams.Empty();
+			}
+		}
+	}
+
+	int64 FRealtimeMeshStreamPool::GetPooledBytes() const
+	{
+		FScopeLock ScopeLock(&Lock);
+		return PooledBytes;
+	}
+
+	int32 FRealtimeMeshStreamPool::GetNumPooledStreams() const
+	{
+		FScopeLock ScopeLock(&Lock);
+		return NumPooledStreams;
+	}
+
+	int64 FRealtimeMeshStreamPool::GetMaxPooledBytes() const
+	{
+		return MaxPooledBytes >= 0 ? MaxPooledBytes : static_cast<int64>(FMath::Max(CVarRealtimeMeshStreamPoolMaxMB.GetValueOnAnyThread(), 0)) * 1024 * 1024;
+	}
+
+	void FRealtimeMeshStreamPool::UpdateStats(int64 DeltaBytes, int32 DeltaStreams)
+	{
+		PooledBytes += DeltaBytes;
+		NumPooledStreams += DeltaStreams;
+
+		if (DeltaBytes > 0)
+		{
+			INC_MEMORY_STAT_BY(STAT_RealtimeMesh_StreamPoolMemory, DeltaBytes);
+		}
+		else if (DeltaBytes < 0)
+		{
+			DEC_MEMORY_STAT_BY(STAT_RealtimeMesh_StreamPoolMemory, -DeltaBytes);
+		}
+		INC_DWORD_STAT_BY(STAT_RealtimeMesh_StreamPoolStreams, DeltaStreams);
+	}
+}
@@ -2,6 +2,7 @@
 
 #include "RealtimeMesh.h"
 #include "RealtimeMeshComponent.h"
+#include "RealtimeMeshCollisionScheduler.h"
 #include "Data/RealtimeMeshData.h"
 #include "Data/RealtimeMeshLOD.h"
 #include "Interface_CollisionDataProviderCore.h"
@@ -33,6 +34,7 @@ URealtimeMesh::URealtimeMesh(const FObjectInitializer& ObjectInitializer)
 	, PendingBodySetup(nullptr)
 	, CollisionUpdateVersionCounter(0)
 	, CurrentCollisionVersion(INDEX_NONE)
+	, TrackedCollisionBytes(0)
 {	
 }
 
@@ -99,6 +101,7 @@ void URealtimeMesh::Initialize(const TSharedRef<RealtimeMesh::FRealtimeMeshShare
 	{
 		SharedResources->OnMeshBoundsChanged().RemoveAll(this);
 		SharedResources->OnMeshRenderDataChanged().RemoveAll(this);
+		SharedResources->GetMemoryCounters().UpdateBytes(RealtimeMesh::ERealtimeMeshMemoryCategory::Collision, TrackedCollisionBytes, 0);
 	}
 
 	SharedResources = InSharedResources;
@@ -138,11 +141,30 @@ void URealtimeMesh::Reset(bool bCreateNewMeshData)
 		PendingBodySetup->AbortPhysicsMeshAsyncCreation();
 	}
 
+	UpdateCollisionMemoryUsage();
+
 	BroadcastBoundsChangedEvent();
 	BroadcastRenderDataChangedEvent(true);
 	BroadcastCollisionBodyUpdatedEvent(nullptr);
 }
 
+FRealtimeMeshMemoryUsage URealtimeMesh::GetMemoryUsage()
+{
+	UpdateCollisionMemoryUsage();
+	return SharedResources ? SharedResources->GetMemoryCounters().GetUsage() : FRealtimeMeshMemoryUsage();
+}
+
+void URealtimeMesh::UpdateCollisionMemoryUsage()
+{
+	check(IsInGameThread());
+
+	if (SharedResources)
+	{
+		const int64 NewCollisionBytes = BodySetup ? BodySetup->GetResourceSizeBytes(EResourceSizeMode::Exclusive) : 0;
+		SharedResources->GetMemoryCounters().UpdateBytes(RealtimeMesh::ERealtimeMeshMemoryCategory::Collision, TrackedCollisionBytes, NewCollisionBytes);
+	}
+}
+
 FBoxSphereBounds URealtimeMesh::GetLocalBounds() const
 {
 	return FBoxSphereBounds(GetMesh()->GetLocalBounds());
@@ -275,6 +297,12 @@ void URealtimeMesh::PostInitProperties()
 
 void URealtimeMesh::BeginDestroy()
 {
+	// The shared resources can outlive us while the render proxy lets go of them, the collision is gone now though
+	if (SharedResources)
+	{
+		SharedResources->GetMemoryCounters().UpdateBytes(RealtimeMesh::ERealtimeMeshMemoryCategory::Collision, TrackedCollisionBytes, 0);
+	}
+
 	Super::BeginDestroy();
 }
 
@@ -334,22 +362,40 @@ private:
 	
 	TSharedRef<TPromise<ERealtimeMeshCollisionUpdateResult>> Promise;
 	bool bIsSet;
+	bool bHoldsCookSlot;
 
 public:
 	FRealtimeMeshCookAutoPromiseOnDestruction(const TSharedRef<TPromise<ERealtimeMeshCollisionUpdateResult>>& InPromise)
 		: Promise(InPromise)
 		, bIsSet(false)
+		, bHoldsCookSlot(false)
 	{
 	}
 
 	~FRealtimeMeshCookAutoPromiseOnDestruction()
 	{
+		ReleaseCookSlot();
 		if (!bIsSet)
 		{
 			Promise->SetValue(ERealtimeMeshCollisionUpdateResult::Ignored);
 		}
 	}
 
+	void TakeCookSlot()
+	{
+		bHoldsCookSlot = true;
+	}
+
+	// Gives the scheduler slot back once the cook is done, or if it never reports back at all
+	void ReleaseCookSlot()
+	{
+		if (bHoldsCookSlot)
+		{
+			RealtimeMesh::FRealtimeMeshCollisionCookScheduler::Get().ReleaseCookSlot();
+			bHoldsCookSlot = false;
+		}
+	}
+
 	void SetResult(ERealtimeMeshCollisionUpdateResult Result)
 	{
 		Promise->SetValue(Result);
@@ -385,14 +431,30 @@ void URealtimeMesh::InitiateCollisionUpdate(const TSharedRef<TPromise<ERealtimeM
 
 	if (!bForceSyncUpdate && GetWorld() && GetWorld()->IsGameWorld() && CollisionUpdate->Config.bUseAsyncCook)
 	{
-		// Copy source info and reset pending
+		// Copy source info and reset pending, this also keeps the body setup alive while it waits for a cook slot
 		PendingBodySetup = NewBodySetup;
 
 		auto ProtectedPromise = MakeShared<FRealtimeMeshCookAutoPromiseOnDestruction>(Promise);
 		
-		// Kick the cook off asynchronously
-		NewBodySetup->CreatePhysicsMeshesAsync(
-			FOnAsyncPhysicsCookFinished::CreateUObject(this, &URealtimeMesh::FinishPhysicsAsyncCook, ProtectedPromise, NewBodySetup, UpdateKey));
+		// Kick the cook off asynchronously once the scheduler has a slot for it. If this mesh updates again before
+		// that, this cook is dropped and the promise resolves as ignored.
+		RealtimeMesh::FRealtimeMeshCollisionCookScheduler::Get().QueueCook(this,
+			[WeakThis = TWeakObjectPtr<URealtimeMesh>(this), ProtectedPromise, NewBodySetup = TWeakObjectPtr<UBodySetup>(NewBodySetup), UpdateKey]()
+			{
+				ProtectedPromise->TakeCookSlot();
+
+				URealtimeMesh* This = WeakThis.Get();
+				UBodySetup* BodySetupToCook = NewBodySetup.Get();
+				if (This && BodySetupToCook && This->PendingBodySetup == BodySetupToCook)
+				{
+					BodySetupToCook->CreatePhysicsMeshesAsync(
+						FOnAsyncPhysicsCookFinished::CreateUObject(This, &URealtimeMesh::FinishPhysicsAsyncCook, ProtectedPromise, BodySetupToCook, UpdateKey));
+				}
+				else
+				{
+					ProtectedPromise->ReleaseCookSlot();
+				}
+			});
 	}
 	else
 	{
@@ -403,6 +465,7 @@ void URealtimeMesh::InitiateCollisionUpdate(const TSharedRef<TPromise<ERealtimeM
 
 		BodySetup = NewBodySetup;
 		PendingCollisionUpdate.Reset();
+		UpdateCollisionMemoryUsage();
 
 		Promise->SetValue(ERealtimeMeshCollisionUpdateResult::Updated);
 		
@@ -412,6 +475,34 @@ void URealtimeMesh::InitiateCollisionUpdate(const TSharedRef<TPromise<ERealtimeM
 
 // ReSharper disable once CppPassValueParameterByConstReference
 void URealtimeMesh::FinishPhysicsAsyncCook(bool bSuccess, TSharedRef<FRealtimeMeshCookAutoPromiseOnDestruction> Promise, UBodySetup* FinishedBodySetup, int32 UpdateKey)
+{
+	check(IsInGameThread());
+	Promise->ReleaseCookSlot();
+
+	// Applying a cook recreates the physics state of every component using this mesh, so those are spread over frames.
+	// Stale or failed cooks are cheap and resolve right away.
+	if (bSuccess && UpdateKey > CurrentCollisionVersion)
+	{
+		RealtimeMesh::FRealtimeMeshCollisionCookScheduler::Get().QueueCompletion(
+			[WeakThis = TWeakObjectPtr<URealtimeMesh>(this), Promise, FinishedBodySetup = TWeakObjectPtr<UBodySetup>(FinishedBodySetup), UpdateKey]()
+			{
+				URealtimeMesh* This = WeakThis.Get();
+				UBodySetup* BodySetupToApply = FinishedBodySetup.Get();
+
+				// A body setup that's gone was replaced by a newer update and collected, the promise resolves as ignored
+				if (This && BodySetupToApply)
+				{
+					This->ApplyPhysicsAsyncCook(true, Promise, BodySetupToApply, UpdateKey);
+				}
+			});
+		return;
+	}
+
+	ApplyPhysicsAsyncCook(bSuccess, Promise, FinishedBodySetup, UpdateKey);
+}
+
+// ReSharper disable once CppPassValueParameterByConstReference
+void URealtimeMesh::ApplyPhysicsAsyncCook(bool bSuccess, TSharedRef<FRealtimeMeshCookAutoPromiseOnDestruction> Promise, UBodySetup* FinishedBodySetup, int32 UpdateKey)
 {
 	check(IsInGameThread());
 	check(SharedResources && MeshRef);
@@ -427,6 +518,7 @@ void URealtimeMesh::FinishPhysicsAsyncCook(bool bSuccess, TSharedRef<FRealtimeMe
 		{
 			BodySetup = FinishedBodySetup;
 			CurrentCollisionVersion = UpdateKey;
+			UpdateCollisionMemoryUsage();
 			Promise->SetResult(ERealtimeMeshCollisionUpdateResult::Updated);
 			bSendEvent = true;
 		}
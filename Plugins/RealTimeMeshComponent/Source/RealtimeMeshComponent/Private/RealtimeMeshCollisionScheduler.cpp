@@ -0,0 +1,219 @@
+﻿// Copyright TriAxis Games, L.L.C. All Rights Reserved.
+
+
+#include "RealtimeMeshCollisionScheduler.h"
+#include "RealtimeMeshCore.h"
+#include "RealtimeMeshThreadingSubsystem.h"
+#include "Async/Async.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/LazySingleton.h"
+
+static TAutoConsoleVariable<int32> CVarRealtimeMeshCollisionGenerationBatchSize(
+	TEXT("r.RealtimeMesh.Collision.GenerationBatchSize"),
+	8,
+	TEXT("Number of collision meshes generated per worker task."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarRealtimeMeshCollisionMaxConcurrentCooks(
+	TEXT("r.RealtimeMesh.Collision.MaxConcurrentCooks"),
+	8,
+	TEXT("Maximum number of async physics cooks in flight at once across all realtime meshes. 0 = unlimited."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarRealtimeMeshCollisionMaxCompletionsPerFrame(
+	TEXT("r.RealtimeMesh.Collision.MaxCompletionsPerFrame"),
+	0,
+	TEXT("Maximum number of finished cooks applied to their mesh per frame. 0 = unlimited."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarRealtimeMeshCollisionCompletionBudgetMs(
+	TEXT("r.RealtimeMesh.Collision.CompletionBudgetMs"),
+	2.0f,
+	TEXT("Game thread time per frame spent applying finished cooks, at least one is always applied. 0 = unlimited."),
+	ECVF_Default);
+
+DECLARE_CYCLE_STAT(TEXT("RealtimeMeshCollisionScheduler - Tick"), STAT_RealtimeMeshCollisionScheduler_Tick, STATGROUP_RealtimeMesh);
+
+namespace RealtimeMesh
+{
+	FRealtimeMeshCollisionCookScheduler::FRealtimeMeshCollisionCookScheduler()
+		: CooksInFlight(0)
+		, bStartingCooks(false)
+	{
+		TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FRealtimeMeshCollisionCookScheduler::Tick));
+	}
+
+	FRealtimeMeshCollisionCookScheduler::~FRealtimeMeshCollisionCookScheduler()
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+	}
+
+	FRealtimeMeshCollisionCookScheduler& FRealtimeMeshCollisionCookScheduler::Get()
+	{
+		return TLazySingleton<FRealtimeMeshCollisionCookScheduler>::Get();
+	}
+
+	void FRealtimeMeshCollisionCookScheduler::QueueGeneration(const void* Owner, const FRealtimeMeshCollisionPromise& ResultPromise,
+	                                                          TUniqueFunction<TFuture<ERealtimeMeshCollisionUpdateResult>()>&& Generate)
+	{
+		check(IsInGameThread());
+
+		// Anyone waiting on a generation that never started gets the result of the one replacing it
+		FPendingGeneration& Pending = PendingGenerations.FindOrAdd(Owner);
+		Pending.ResultPromises.Add(ResultPromise);
+		Pending.Generate = MoveTemp(Generate);
+	}
+
+	void FRealtimeMeshCollisionCookScheduler::QueueCook(const void* Owner, TUniqueFunction<void()>&& StartCook)
+	{
+		check(IsInGameThread());
+
+		if (TUniqueFunction<void()>* ExistingCook = PendingCooks.Find(Owner))
+		{
+			// Dropping the old cook releases whatever it captured, keeps its place in line
+			*ExistingCook = MoveTemp(StartCook);
+		}
+		else
+		{
+			PendingCooks.Add(Owner, MoveTemp(StartCook));
+			PendingCookOrder.Add(Owner);
+		}
+
+		// Start right away if there's room so an uncapped scheduler doesn't add a frame of latency
+		StartCooks();
+	}
+
+	void FRealtimeMeshCollisionCookScheduler::ReleaseCookSlot()
+	{
+		check(CooksInFlight.load() > 0);
+		CooksInFlight--;
+	}
+
+	void FRealtimeMeshCollisionCookScheduler::QueueCompletion(TUniqueFunction<void()>&& Complete)
+	{
+		check(IsInGameThread());
+		PendingCompletions.Add(MoveTemp(Complete));
+	}
+
+	bool FRealtimeMeshCollisionCookScheduler::Tick(float DeltaTime)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_RealtimeMeshCollisionScheduler_Tick);
+
+		DispatchGenerations();
+		StartCooks();
+		RunCompletions();
+		return true;
+	}
+
+	void FRealtimeMeshCollisionCookScheduler::DispatchGenerations()
+	{
+		if (PendingGenerations.Num() == 0)
+		{
+			return;
+		}
+
+		TArray<FPendingGeneration> Generations;
+		Generations.Reserve(PendingGenerations.Num());
+		for (auto& Entry : PendingGenerations)
+		{
+			Generations.Add(MoveTemp(Entry.Value));
+		}
+		PendingGenerations.Reset();
+
+		const int32 BatchSize = FMath::Max(1, CVarRealtimeMeshCollisionGenerationBatchSize.GetValueOnGameThread());
+		URealtimeMeshThreadingSubsystem* ThreadingSubsystem = URealtimeMeshThreadingSubsystem::Get();
+
+		for (int32 BatchStart = 0; BatchStart < Generations.Num(); BatchStart += BatchSize)
+		{
+			TSharedRef<TArray<FPendingGeneration>, ESPMode::ThreadSafe> Batch = MakeShared<TArray<FPendingGeneration>, ESPMode::ThreadSafe>();
+			const int32 BatchEnd = FMath::Min(BatchStart + BatchSize, Generations.Num());
+			for (int32 Index = BatchStart; Index < BatchEnd; Index++)
+			{
+				Batch->Add(MoveTemp(Generations[Index]));
+			}
+
+			auto RunBatch = [Batch]()
+			{
+				for (FPendingGeneration& Generation : *Batch)
+				{
+					Generation.Generate().Next([ResultPromises = MoveTemp(Generation.ResultPromises)](ERealtimeMeshCollisionUpdateResult Result)
+					{
+						for (const FRealtimeMeshCollisionPromise& ResultPromise : ResultPromises)
+						{
+							ResultPromise->SetValue(Result);
+						}
+					});
+				}
+			};
+
+			if (ThreadingSubsystem)
+			{
+				ThreadingSubsystem->LaunchTask(ERealtimeMeshTaskPriority::Streaming, MoveTemp(RunBatch), [Batch]()
+				{
+					for (FPendingGeneration& Generation : *Batch)
+					{
+						for (const FRealtimeMeshCollisionPromise& ResultPromise : Generation.ResultPromises)
+						{
+							ResultPromise->SetValue(ERealtimeMeshCollisionUpdateResult::Ignored);
+						}
+					}
+				});
+			}
+			else
+			{
+				AsyncTask(ENamedThreads::AnyThread, MoveTemp(RunBatch));
+			}
+		}
+	}
+
+	void FRealtimeMeshCollisionCookScheduler::StartCooks()
+	{
+		// A cook queued from inside a StartCook is picked up by the loop already running
+		if (bStartingCooks)
+		{
+			return;
+		}
+		TGuardValue<bool> StartingCooksGuard(bStartingCooks, true);
+
+		const int32 MaxConcurrentCooks = CVarRealtimeMeshCollisionMaxConcurrentCooks.GetValueOnGameThread();
+
+		int32 NumStarted = 0;
+		while (NumStarted < PendingCookOrder.Num() && (MaxConcurrentCooks <= 0 || CooksInFlight < MaxConcurrentCooks))
+		{
+			const void* Owner = PendingCookOrder[NumStarted++];
+			TUniqueFunction<void()> StartCook = PendingCooks.FindAndRemoveChecked(Owner);
+
+			CooksInFlight++;
+			StartCook();
+		}
+		PendingCookOrder.RemoveAt(0, NumStarted);
+	}
+
+	void FRealtimeMeshCollisionCookScheduler::RunCompletions()
+	{
+		if (PendingCompletions.Num() == 0)
+		{
+			return;
+		}
+
+		const int32 MaxCompletions = CVarRealtimeMeshCollisionMaxCompletionsPerFrame.GetValueOnGameThread();
+		const double BudgetSeconds = CVarRealtimeMeshCollisionCompletionBudgetMs.GetValueOnGameThread() / 1000.0;
+		const double StartTime = FPlatformTime::Seconds();
+
+		int32 NumCompleted = 0;
+		while (NumCompleted < PendingCompletions.Num())
+		{
+			// Always make some progress, even if a single completion blows the budget
+			if (NumCompleted > 0 && ((MaxCompletions > 0 && NumCompleted >= MaxCompletions) ||
+				(BudgetSeconds > 0.0 && FPlatformTime::Seconds() - StartTime >= BudgetSeconds)))
+			{
+				break;
+			}
+
+			// Moved out first, completions can queue more completions
+			TUniqueFunction<void()> Complete = MoveTemp(PendingCompletions[NumCompleted++]);
+			Complete();
+		}
+		PendingCompletions.RemoveAt(0, NumCompleted);
+	}
+}
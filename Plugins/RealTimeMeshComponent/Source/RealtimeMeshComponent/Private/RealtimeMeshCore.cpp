@@ -45,6 +45,7 @@ namespace RealtimeMesh
 	void FRealtimeMeshSharedResources::SetOwnerMesh(URealtimeMesh* InOwningMesh, const FRealtimeMeshRef& InOwner)
 	{
 		OwningMesh = InOwningMesh, Owner = InOwner;
+		MemoryCounters.SetOwnerName(InOwningMesh ? InOwningMesh->GetPathName() : FString());
 	}
 
 	ERHIFeatureLevel::Type FRealtimeMeshSharedResources::GetFeatureLevel() const
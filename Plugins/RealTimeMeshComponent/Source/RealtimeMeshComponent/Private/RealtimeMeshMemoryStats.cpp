@@ -0,0 +1,196 @@
+﻿// Copyright TriAxis Games, L.L.C. All Rights Reserved.
+
+#include "RealtimeMeshMemoryStats.h"
+#include "RealtimeMeshCore.h"
+#include "RealtimeMesh.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectIterator.h"
+
+LLM_DEFINE_TAG(RealtimeMesh);
+
+DECLARE_MEMORY_STAT(TEXT("Memory - CPU Streams"), STAT_RealtimeMesh_CPUStreamMemory, STATGROUP_RealtimeMesh);
+DECLARE_MEMORY_STAT(TEXT("Memory - GPU Buffers"), STAT_RealtimeMesh_GPUBufferMemory, STATGROUP_RealtimeMesh);
+DECLARE_MEMORY_STAT(TEXT("Memory - Collision"), STAT_RealtimeMesh_CollisionMemory, STATGROUP_RealtimeMesh);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Memory - Tracked Meshes"), STAT_RealtimeMesh_TrackedMeshes, STATGROUP_RealtimeMesh);
+
+static FAutoConsoleCommandWithArgsAndOutputDevice CmdRealtimeMeshDumpMemory(
+	TEXT("RealtimeMesh.DumpMemory"),
+	TEXT("Logs the memory held by realtime meshes and the largest consumers. Usage: RealtimeMesh.DumpMemory [Count=20]"),
+	FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, FOutputDevice& Ar)
+	{
+		// Collision is measured lazily since the sync path cooks on first use, catch up before reporting
+		for (TObjectIterator<URealtimeMesh> It; It; ++It)
+		{
+			It->UpdateCollisionMemoryUsage();
+		}
+
+		const int32 Count = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 20;
+		RealtimeMesh::FRealtimeMeshMemoryTracker::DumpTopConsumers(Ar, Count);
+	}));
+
+namespace RealtimeMesh
+{
+	namespace MemoryStats::Private
+	{
+		std::atomic<int64> GlobalBytes[static_cast<int32>(ERealtimeMeshMemoryCategory::Num)];
+
+		FCriticalSection& GetRegistryLock()
+		{
+			static FCriticalSection Lock;
+			return Lock;
+		}
+
+		TSet<FRealtimeMeshMemoryCounters*>& GetRegistry()
+		{
+			static TSet<FRealtimeMeshMemoryCounters*> Registry;
+			return Registry;
+		}
+
+		void UpdateStat(ERealtimeMeshMemoryCategory Category, int64 Delta)
+		{
+			switch (Category)
+			{
+			case ERealtimeMeshMemoryCategory::CPUStreams:
+				if (Delta > 0) { INC_MEMORY_STAT_BY(STAT_RealtimeMesh_CPUStreamMemory, Delta); }
+				else { DEC_MEMORY_STAT_BY(STAT_RealtimeMesh_CPUStreamMemory, -Delta); }
+				break;
+			case ERealtimeMeshMemoryCategory::GPUBuffers:
+				if (Delta > 0) { INC_MEMORY_STAT_BY(STAT_RealtimeMesh_GPUBufferMemory, Delta); }
+				else { DEC_MEMORY_STAT_BY(STAT_RealtimeMesh_GPUBufferMemory, -Delta); }
+				break;
+			case ERealtimeMeshMemoryCategory::Collision:
+				if (Delta > 0) { INC_MEMORY_STAT_BY(STAT_RealtimeMesh_CollisionMemory, Delta); }
+				else { DEC_MEMORY_STAT_BY(STAT_RealtimeMesh_CollisionMemory, -Delta); }
+				break;
+			default:
+				checkNoEntry();
+			}
+		}
+
+		FString FormatBytes(int64 Bytes)
+		{
+			return FString::Printf(TEXT("%.2f MB"), static_cast<double>(Bytes) / (1024.0 * 1024.0));
+		}
+	}
+
+	FRealtimeMeshMemoryCounters::FRealtimeMeshMemoryCounters()
+	{
+		for (std::atomic<int64>& Counter : Bytes)
+		{
+			Counter.store(0, std::memory_order_relaxed);
+		}
+
+		FScopeLock Lock(&MemoryStats::Private::GetRegistryLock());
+		MemoryStats::Private::GetRegistry().Add(this);
+		INC_DWORD_STAT(STAT_RealtimeMesh_TrackedMeshes);
+	}
+
+	FRealtimeMeshMemoryCounters::~FRealtimeMeshMemoryCounters()
+	{
+		{
+			FScopeLock Lock(&MemoryStats::Private::GetRegistryLock());
+			MemoryStats::Private::GetRegistry().Remove(this);
+			DEC_DWORD_STAT(STAT_RealtimeMesh_TrackedMeshes);
+		}
+
+		// Whatever is still reported leaves the global totals with us
+		for (int32 Index = 0; Index < static_cast<int32>(ERealtimeMeshMemoryCategory::Num); Index++)
+		{
+			AddBytes(static_cast<ERealtimeMeshMemoryCategory>(Index), -GetBytes(static_cast<ERealtimeMeshMemoryCategory>(Index)));
+		}
+	}
+
+	void FRealtimeMeshMemoryCounters::SetOwnerName(const FString& InOwnerName)
+	{
+		FScopeLock Lock(&MemoryStats::Private::GetRegistryLock());
+		OwnerName = InOwnerName;
+	}
+
+	FString FRealtimeMeshMemoryCounters::GetOwnerName() const
+	{
+		FScopeLock Lock(&MemoryStats::Private::GetRegistryLock());
+		return OwnerName;
+	}
+
+	FRealtimeMeshMemoryUsage FRealtimeMeshMemoryCounters::GetUsage() const
+	{
+		FRealtimeMeshMemoryUsage Usage;
+		Usage.CPUStreamBytes = GetBytes(ERealtimeMeshMemoryCategory::CPUStreams);
+		Usage.GPUBufferBytes = GetBytes(ERealtimeMeshMemoryCategory::GPUBuffers);
+		Usage.CollisionBytes = GetBytes(ERealtimeMeshMemoryCategory::Collision);
+		return Usage;
+	}
+
+	void FRealtimeMeshMemoryCounters::AddBytes(ERealtimeMeshMemoryCategory Category, int64 Delta)
+	{
+		check(Category < ERealtimeMeshMemoryCategory::Num);
+
+		if (Delta != 0)
+		{
+			Bytes[static_cast<int32>(Category)].fetch_add(Delta, std::memory_order_relaxed);
+			MemoryStats::Private::GlobalBytes[static_cast<int32>(Category)].fetch_add(Delta, std::memory_order_relaxed);
+			MemoryStats::Private::UpdateStat(Category, Delta);
+		}
+	}
+
+	FRealtimeMeshMemoryUsage FRealtimeMeshMemoryTracker::GetGlobalUsage()
+	{
+		using namespace MemoryStats::Private;
+
+		FRealtimeMeshMemoryUsage Usage;
+		Usage.CPUStreamBytes = GlobalBytes[static_cast<int32>(ERealtimeMeshMemoryCategory::CPUStreams)].load(std::memory_order_relaxed);
+		Usage.GPUBufferBytes = GlobalBytes[static_cast<int32>(ERealtimeMeshMemoryCategory::GPUBuffers)].load(std::memory_order_relaxed);
+		Usage.CollisionBytes = GlobalBytes[static_cast<int32>(ERealtimeMeshMemoryCategory::Collision)].load(std::memory_order_relaxed);
+		return Usage;
+	}
+
+	int32 FRealtimeMeshMemoryTracker::GetNumTrackedMeshes()
+	{
+		FScopeLock Lock(&MemoryStats::Private::GetRegistryLock());
+		return MemoryStats::Private::GetRegistry().Num();
+	}
+
+	TArray<TPair<FString, FRealtimeMeshMemoryUsage>> FRealtimeMeshMemoryTracker::GetTopConsumers(int32 MaxCount)
+	{
+		TArray<TPair<FString, FRealtimeMeshMemoryUsage>> Consumers;
+		{
+			FScopeLock Lock(&MemoryStats::Private::GetRegistryLock());
+			Consumers.Reserve(MemoryStats::Private::GetRegistry().Num());
+			for (const FRealtimeMeshMemoryCounters* Counters : MemoryStats::Private::GetRegistry())
+			{
+				// The owner name is guarded by the lock we already hold, so read it directly
+				Consumers.Emplace(Counters->OwnerName, Counters->GetUsage());
+			}
+		}
+
+		Consumers.Sort([](const TPair<FString, FRealtimeMeshMemoryUsage>& A, const TPair<FString, FRealtimeMeshMemoryUsage>& B)
+		{
+			return A.Value.GetTotalBytes() > B.Value.GetTotalBytes();
+		});
+
+		if (Consumers.Num() > MaxCount)
+		{
+			Consumers.SetNum(FMath::Max(MaxCount, 0));
+		}
+		return Consumers;
+	}
+
+	void FRealtimeMeshMemoryTracker::DumpTopConsumers(FOutputDevice& Ar, int32 MaxCount)
+	{
+		using namespace MemoryStats::Private;
+
+		const FRealtimeMeshMemoryUsage Global = GetGlobalUsage();
+		Ar.Logf(TEXT("RealtimeMesh memory: %d meshes, %s total (CPU streams %s, GPU buffers %s, collision %s)"),
+			GetNumTrackedMeshes(), *FormatBytes(Global.GetTotalBytes()), *FormatBytes(Global.CPUStreamBytes),
+			*FormatBytes(Global.GPUBufferBytes), *FormatBytes(Global.CollisionBytes));
+
+		const TArray<TPair<FString, FRealtimeMeshMemoryUsage>> Consumers = GetTopConsumers(MaxCount);
+		for (int32 Index = 0; Index < Consumers.Num(); Index++)
+		{
+			const FRealtimeMeshMemoryUsage& Usage = Consumers[Index].Value;
+			Ar.Logf(TEXT("  %3d. %10s  CPU %10s  GPU %10s  Collision %10s  %s"), Index + 1,
+				*FormatBytes(Usage.GetTotalBytes()), *FormatBytes(Usage.CPUStreamBytes), *FormatBytes(Usage.GPUBufferBytes),
+				*FormatBytes(Usage.CollisionBytes), Consumers[Index].Key.IsEmpty() ? TEXT("<unowned>") : *Consumers[Index].Key);
+		}
+	}
+}
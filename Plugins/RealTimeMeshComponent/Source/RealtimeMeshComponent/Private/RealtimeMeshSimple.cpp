@@ -2,8 +2,10 @@
 
 #include "RealtimeMeshSimple.h"
 #include "RealtimeMeshCore.h"
+#include "RealtimeMeshCollisionScheduler.h"
 #include "Mesh/RealtimeMeshBuilder.h"
 #include "Mesh/RealtimeMeshSimpleData.h"
+#include "Mesh/RealtimeMeshStreamPool.h"
 #include "RenderProxy/RealtimeMeshProxyCommandBatch.h"
 #include "RenderProxy/RealtimeMeshSectionGroupProxy.h"
 #include "RenderProxy/RealtimeMeshVertexFactory.h"
@@ -125,10 +127,22 @@ namespace RealtimeMesh
 						const int32 MaterialSlot = GetConfig().MaterialSlot;
 
 						TRealtimeMeshStreamBuilder<const TIndex3<uint32>, void> TrianglesData(*TriangleStream);
-						CollisionTriangles.Reserve(TrianglesData.Num());
-						CollisionMaterials.Reserve(TrianglesData.Num());
 
-						for (int32 TriIdx = 0; TriIdx < TrianglesData.Num(); TriIdx++)
+						// Only cook the triangles this section draws. The group can hold more than one index range
+						// (other polygroups, or alternate index ranges the section switches between)
+						int32 FirstTriangle = 0;
+						int32 LastTriangle = TrianglesData.Num();
+						const FRealtimeMeshStreamRange SectionRange = GetStreamRange();
+						if (SectionRange.Indices.HasLowerBound() && SectionRange.Indices.HasUpperBound() && !SectionRange.Indices.IsEmpty())
+						{
+							FirstTriangle = FMath::Clamp(SectionRange.GetMinIndex() / 3, 0, TrianglesData.Num());
+							LastTriangle = FMath::Clamp((SectionRange.GetMaxIndex() + 1) / 3, FirstTriangle, TrianglesData.Num());
+						}
+						
+						CollisionTriangles.Reserve(CollisionTriangles.Num() + LastTriangle - FirstTriangle);
+						CollisionMaterials.Reserve(CollisionMaterials.Num() + LastTriangle - FirstTriangle);
+
+						for (int32 TriIdx = FirstTriangle; TriIdx < LastTriangle; TriIdx++)
 						{
 							FTriIndices& Tri = CollisionTriangles.AddDefaulted_GetRef();
 							Tri.v0 = TrianglesData[TriIdx].GetElement(0).GetValue() + StartVertexIndex;
@@ -212,6 +226,11 @@ namespace RealtimeMesh
 
 	
 
+	FRealtimeMeshSectionGroupSimple::~FRealtimeMeshSectionGroupSimple()
+	{
+		SharedResources->GetMemoryCounters().UpdateBytes(ERealtimeMeshMemoryCategory::CPUStreams, TrackedStreamBytes, 0);
+	}
+
 	FRealtimeMeshSectionPtr FRealtimeMeshSectionGroupSimple::GetStandaloneSection() const
 	{
 		FRealtimeMeshScopeGuardRead ScopeGuard(SharedResources->GetGuard());
@@ -282,8 +301,10 @@ namespace RealtimeMesh
 	{
 		FRealtimeMeshProxyCommandBatch Commands(SharedResources);
 		FRealtimeMeshScopeGuardWrite ScopeGuard(SharedResources->GetGuard());
+		LLM_SCOPE_BYTAG(RealtimeMesh);
 
 		auto UpdatedStreams = EditFunc(Streams);
+		UpdateMemoryStats();
 
 		for (const auto& UpdatedStream : UpdatedStreams)
 		{
@@ -311,9 +332,12 @@ namespace RealtimeMesh
 	void FRealtimeMeshSectionGroupSimple::CreateOrUpdateStream(FRealtimeMeshProxyCommandBatch& Commands, FRealtimeMeshStream&& Stream)
 	{
 		FRealtimeMeshScopeGuardWrite ScopeGuard(SharedResources->GetGuard());
+		LLM_SCOPE_BYTAG(RealtimeMesh);
 
 		// Replace the stored stream (We allow this to copy as we then pass the stream to the RT command queue)
-		Streams.AddStream(Stream);
+		// The copy goes into a pooled allocation and the stream it replaces is handed back to the pool
+		FRealtimeMeshStreamPool::Get().AddStream(Streams, Stream.GetStreamKey(), Stream.GetLayout(), Stream.Num()).Append(Stream);
+		UpdateMemoryStats();
 		
 		// If this stream is a segments stream or polygon group stream lets update the sections
 		if (bAutoCreateSectionsForPolygonGroups && !Simple::Private::bShouldDeferPolyGroupUpdates)
@@ -340,6 +364,129 @@ namespace RealtimeMesh
 		}		
 	}
 
+	TFuture<ERealtimeMeshProxyUpdateStatus> FRealtimeMeshSectionGroupSimple::UpdateStreamRange(int32 FirstElement, FRealtimeMeshStream&& Data)
+	{
+		FRealtimeMeshProxyCommandBatch Commands(SharedResources);
+		UpdateStreamRange(Commands, FirstElement, MoveTemp(Data));
+		return Commands.Commit();
+	}
+
+	void FRealtimeMeshSectionGroupSimple::UpdateStreamRange(FRealtimeMeshProxyCommandBatch& Commands, int32 FirstElement, FRealtimeMeshStream&& Data)
+	{
+		FRealtimeMeshScopeGuardWrite ScopeGuard(SharedResources->GetGuard());
+
+		const FRealtimeMeshStreamKey StreamKey = Data.GetStreamKey();
+		FRealtimeMeshStream* ExistingStream = Streams.Find(StreamKey);
+
+		if (!ExistingStream || ExistingStream->GetLayout() != Data.GetLayout() || FirstElement < 0)
+		{
+			FMessageLog("RealtimeMesh").Error(
+				FText::Format(LOCTEXT("UpdateStreamRange_InvalidStream", "Unable to update range of stream {0} in mesh {1}"),
+							  FText::FromString(StreamKey.ToString()), FText::FromName(SharedResources->GetMeshName())));
+			return;
+		}
+
+		if (Data.Num() == 0)
+		{
+			return;
+		}
+
+		// Growing the stream needs a new GPU buffer, so fall back to a full update
+		if (FirstElement + Data.Num() > ExistingStream->Num())
+		{
+			FRealtimeMeshStream GrownStream(*ExistingStream);
+			GrownStream.SetNumZeroed(FirstElement + Data.Num());
+			FMemory::Memcpy(GrownStream.GetDataRawAtVertex(FirstElement), Data.GetData(), Data.GetResourceDataSize());
+			FRealtimeMeshStreamPool::Get().Release(MakeUnique<FRealtimeMeshStream>(MoveTemp(Data)));
+			CreateOrUpdateStream(Commands, MoveTemp(GrownStream));
+			return;
+		}
+
+		FMemory::Memcpy(ExistingStream->GetDataRawAtVertex(FirstElement), Data.GetData(), Data.GetResourceDataSize());
+
+		// The range update hands the rows back to the pool once the render thread has uploaded them
+		if (Commands && SharedResources->WantsStreamOnGPU(StreamKey))
+		{
+			// Only the ray tracing geometry is rebuilt from the buffer contents, everything else keeps pointing at the same buffers
+			const bool bAffectsRayTracing = StreamKey == FRealtimeMeshStreams::Position || StreamKey == FRealtimeMeshStreams::Triangles;
+			const auto UpdateData = MakeShared<FRealtimeMeshSectionGroupStreamRangeUpdateData>(MoveTemp(Data), FirstElement);
+
+			Commands.AddSectionGroupTask(Key, [UpdateData](FRealtimeMeshSectionGroupProxy& Proxy)
+			{
+				Proxy.UpdateStreamRange(UpdateData);
+			}, bAffectsRayTracing && ShouldRecreateProxyOnStreamChange());
+		}
+		else
+		{
+			FRealtimeMeshStreamPool::Get().Release(MakeUnique<FRealtimeMeshStream>(MoveTemp(Data)));
+		}
+
+		if (bAutoCreateSectionsForPolygonGroups && !Simple::Private::bShouldDeferPolyGroupUpdates)
+		{
+			if (StreamKey == FRealtimeMeshStreams::PolyGroups ||
+				StreamKey == FRealtimeMeshStreams::PolyGroupSegments ||
+				StreamKey == FRealtimeMeshStreams::Triangles)
+			{
+				UpdatePolyGroupSections(Commands, false);
+			}
+			else if (StreamKey == FRealtimeMeshStreams::DepthOnlyPolyGroups ||
+				StreamKey == FRealtimeMeshStreams::DepthOnlyPolyGroupSegments ||
+				StreamKey == FRealtimeMeshStreams::DepthOnlyTriangles)
+			{
+				UpdatePolyGroupSections(Commands, true);
+			}
+		}
+
+		SharedResources->BroadcastStreamChanged(Key, StreamKey, ERealtimeMeshChangeType::Updated);
+	}
+
+	TFuture<ERealtimeMeshProxyUpdateStatus> FRealtimeMeshSectionGroupSimple::UpdateStreamsInPlace(FRealtimeMeshStreamSet&& InStreams)
+	{
+		FRealtimeMeshProxyCommandBatch Commands(SharedResources);
+		UpdateStreamsInPlace(Commands, MoveTemp(InStreams));
+		return Commands.Commit();
+	}
+
+	void FRealtimeMeshSectionGroupSimple::UpdateStreamsInPlace(FRealtimeMeshProxyCommandBatch& Commands, FRealtimeMeshStreamSet&& InStreams)
+	{
+		FRealtimeMeshScopeGuardWrite ScopeGuard(SharedResources->GetGuard());
+
+		bool bCanWriteInPlace = InStreams.Num() == Streams.Num();
+		InStreams.ForEach([&](const FRealtimeMeshStream& Stream)
+		{
+			const FRealtimeMeshStream* ExistingStream = Streams.Find(Stream.GetStreamKey());
+			bCanWriteInPlace &= ExistingStream && ExistingStream->GetLayout() == Stream.GetLayout() && ExistingStream->Num() == Stream.Num();
+		});
+
+		if (!bCanWriteInPlace)
+		{
+			SetAllStreams(Commands, MoveTemp(InStreams));
+			return;
+		}
+
+		const bool bWantsPolyGroupUpdate = bAutoCreateSectionsForPolygonGroups && (InStreams.Contains(FRealtimeMeshStreams::PolyGroups) ||
+			InStreams.Contains(FRealtimeMeshStreams::PolyGroupSegments) || InStreams.Contains(FRealtimeMeshStreams::Triangles));
+		const bool bWantsDepthOnlyPolyGroupUpdate = bAutoCreateSectionsForPolygonGroups && (InStreams.Contains(FRealtimeMeshStreams::DepthOnlyPolyGroups) ||
+			InStreams.Contains(FRealtimeMeshStreams::DepthOnlyPolyGroupSegments) || InStreams.Contains(FRealtimeMeshStreams::DepthOnlyTriangles));
+
+		// Defer the section updates until all streams are written, same as SetAllStreams
+		Simple::Private::bShouldDeferPolyGroupUpdates = true;
+		InStreams.ForEach([&](FRealtimeMeshStream& Stream)
+		{
+			UpdateStreamRange(Commands, 0, MoveTemp(Stream));
+		});
+		Simple::Private::bShouldDeferPolyGroupUpdates = false;
+
+		if (bWantsPolyGroupUpdate)
+		{
+			UpdatePolyGroupSections(Commands, false);
+		}
+		if (bWantsDepthOnlyPolyGroupUpdate)
+		{
+			UpdatePolyGroupSections(Commands, true);
+		}
+	}
+
 	PRAGMA_DISABLE_DEPRECATION_WARNINGS
 	TFuture<ERealtimeMeshProxyUpdateStatus> FRealtimeMeshSectionGroupSimple::UpdateFromSimpleMesh(const FRealtimeMeshSimpleMeshData& MeshData)
 	{
@@ -397,13 +544,16 @@ namespace RealtimeMesh
 	{
 		FRealtimeMeshScopeGuardWrite ScopeGuard(SharedResources->GetGuard());
 
-		// Replace the stored stream
-		if (Streams.Remove(StreamKey) == 0)
+		// Remove the stored stream, its allocation goes back to the pool
+		TUniquePtr<FRealtimeMeshStream> RemovedStream = Streams.Extract(StreamKey);
+		if (!RemovedStream.IsValid())
 		{
 			FMessageLog("RealtimeMesh").Error(
 				FText::Format(LOCTEXT("RemoveStreamInvalid", "Attempted to remove invalid stream {0} in Mesh:{1}"),
 				              FText::FromString(StreamKey.ToString()), FText::FromName(SharedResources->GetMeshName())));
 		}
+		FRealtimeMeshStreamPool::Get().Release(MoveTemp(RemovedStream));
+		UpdateMemoryStats();
 
 		FRealtimeMeshSectionGroup::RemoveStream(Commands, StreamKey);
 	}
@@ -467,6 +617,7 @@ namespace RealtimeMesh
 	{
 		FRealtimeMeshScopeGuardWrite ScopeGuard(SharedResources->GetGuard());
 		Streams.Empty();
+		UpdateMemoryStats();
 		FRealtimeMeshSectionGroup::Reset(Commands);
 	}
 
@@ -476,7 +627,13 @@ namespace RealtimeMesh
 
 		if (ensure(bResult))
 		{
+			LLM_SCOPE_BYTAG(RealtimeMesh);
 			Ar << Streams;
+
+			if (Ar.IsLoading())
+			{
+				UpdateMemoryStats();
+			}
 		}
 
 		return bResult;
@@ -531,6 +688,11 @@ namespace RealtimeMesh
 		}
 	}
 
+	void FRealtimeMeshSectionGroupSimple::UpdateMemoryStats()
+	{
+		SharedResources->GetMemoryCounters().UpdateBytes(ERealtimeMeshMemoryCategory::CPUStreams, TrackedStreamBytes, Streams.GetAllocatedSize());
+	}
+
 	FRealtimeMeshSectionConfig FRealtimeMeshSectionGroupSimple::DefaultPolyGroupSectionHandler(int32 PolyGroupIndex) const
 	{
 		return FRealtimeMeshSectionConfig(ERealtimeMeshSectionDrawType::Static, PolyGroupIndex);
@@ -903,34 +1065,33 @@ namespace RealtimeMesh
 
 			const bool bGenerateOnOtherThread = bAsyncCook && IsInGameThread();
 
-			auto GenerationPromise = MakeShared<TPromise<TSharedPtr<FRealtimeMeshCollisionData>>>();
-
-			auto GenerateMeshDataLambda = [ThisWeak, GenerationPromise, CollisionData]() mutable
-			{
-				FRealtimeMeshTriMeshData CollisionMesh;
-				if (const auto ThisShared = ThisWeak.Pin())
-				{
-					if (ThisShared->GenerateCollisionMesh(CollisionMesh))
-					{
-						CollisionData->ComplexGeometry = MoveTemp(CollisionMesh);
-					}
-				}
-				GenerationPromise->SetValue(CollisionData);
-			};
-
-
 			if (bGenerateOnOtherThread)
 			{
-				AsyncTask(ENamedThreads::AnyThread, MoveTemp(GenerateMeshDataLambda));
+				// Generated on a worker along with every other mesh updating this frame, a newer update replaces this one if it hasn't started
+				FRealtimeMeshCollisionCookScheduler::Get().QueueGeneration(this, PendingCollisionPromise.ToSharedRef(),
+					[ThisWeak, CollisionData]() -> TFuture<ERealtimeMeshCollisionUpdateResult>
+					{
+						if (const auto ThisShared = ThisWeak.Pin())
+						{
+							FRealtimeMeshTriMeshData CollisionMesh;
+							if (ThisShared->GenerateCollisionMesh(CollisionMesh))
+							{
+								CollisionData->ComplexGeometry = MoveTemp(CollisionMesh);
+							}
+							return ThisShared->UpdateCollision(MoveTemp(*CollisionData));
+						}
+						return MakeFulfilledPromise<ERealtimeMeshCollisionUpdateResult>(ERealtimeMeshCollisionUpdateResult::Ignored).GetFuture();
+					});
 			}
 			else
 			{
-				GenerateMeshDataLambda();
-			}
+				FRealtimeMeshTriMeshData CollisionMesh;
+				if (GenerateCollisionMesh(CollisionMesh))
+				{
+					CollisionData->ComplexGeometry = MoveTemp(CollisionMesh);
+				}
 
-			GenerationPromise->GetFuture().Next([ThisWeak, ResultPromise = PendingCollisionPromise](const TSharedPtr<FRealtimeMeshCollisionData>& CollisionData) mutable
-			{
-				auto SendCollisionUpdate = [ThisWeak, ResultPromise, CollisionData]() mutable
+				auto SendCollisionUpdate = [ThisWeak, ResultPromise = PendingCollisionPromise, CollisionData]() mutable
 				{
 					if (const auto ThisShared = ThisWeak.Pin())
 					{
@@ -950,7 +1111,7 @@ namespace RealtimeMesh
 				{
 					SendCollisionUpdate();
 				}
-			});
+			}
 
 			PendingCollisionPromise.Reset();
 		}
@@ -1041,6 +1202,32 @@ TFuture<ERealtimeMeshProxyUpdateStatus> URealtimeMeshSimple::UpdateSectionGroup(
 	return UpdateSectionGroup(SectionGroupKey, MoveTemp(Copy));
 }
 
+TFuture<ERealtimeMeshProxyUpdateStatus> URealtimeMeshSimple::UpdateSectionGroupStreamRange(const FRealtimeMeshSectionGroupKey& SectionGroupKey, int32 FirstElement, FRealtimeMeshStream&& Data)
+{
+	if (const auto SectionGroup = GetSectionGroup(SectionGroupKey))
+	{
+		return SectionGroup->UpdateStreamRange(FirstElement, MoveTemp(Data));
+	}
+
+	FMessageLog("RealtimeMesh").Error(
+		FText::Format(LOCTEXT("UpdateSectionGroupStreamRange_InvalidSectionGroupKey", "UpdateSectionGroupStreamRange: Invalid SectionGroupKey key {0}"),
+					  FText::FromString(SectionGroupKey.ToString())));
+	return MakeFulfilledPromise<ERealtimeMeshProxyUpdateStatus>(ERealtimeMeshProxyUpdateStatus::NoUpdate).GetFuture();
+}
+
+TFuture<ERealtimeMeshProxyUpdateStatus> URealtimeMeshSimple::UpdateSectionGroupInPlace(const FRealtimeMeshSectionGroupKey& SectionGroupKey, FRealtimeMeshStreamSet&& MeshData)
+{
+	if (const auto SectionGroup = GetSectionGroup(SectionGroupKey))
+	{
+		return SectionGroup->UpdateStreamsInPlace(MoveTemp(MeshData));
+	}
+
+	FMessageLog("RealtimeMesh").Error(
+		FText::Format(LOCTEXT("UpdateSectionGroupInPlace_InvalidSectionGroupKey", "UpdateSectionGroupInPlace: Invalid SectionGroupKey key {0}"),
+					  FText::FromString(SectionGroupKey.ToString())));
+	return MakeFulfilledPromise<ERealtimeMeshProxyUpdateStatus>(ERealtimeMeshProxyUpdateStatus::NoUpdate).GetFuture();
+}
+
 
 // ReSharper disable once CppMemberFunctionMayBeConst
 PRAGMA_DISABLE_DEPRECATION_WARNINGS
@@ -1678,6 +1865,28 @@ TFuture<ERealtimeMeshProxyUpdateStatus> URealtimeMeshSimple::RemoveSectionGroup(
 	}
 }
 
+bool URealtimeMeshSimple::IsMergingCompatibleSections() const
+{
+	return GetMeshAs<FRealtimeMeshSimple>()->IsMergingCompatibleSections();
+}
+
+TFuture<ERealtimeMeshProxyUpdateStatus> URealtimeMeshSimple::SetMergeCompatibleSections(bool bMergeCompatibleSections)
+{
+	return GetMeshAs<FRealtimeMeshSimple>()->SetMergeCompatibleSections(bMergeCompatibleSections);
+}
+
+void URealtimeMeshSimple::SetMergeCompatibleSections(bool bMergeCompatibleSections, const FRealtimeMeshSimpleCompletionCallback& CompletionCallback)
+{
+	SetMergeCompatibleSections(bMergeCompatibleSections)
+		.Next([CompletionCallback](ERealtimeMeshProxyUpdateStatus Status)
+		{
+			if (CompletionCallback.IsBound())
+			{
+				CompletionCallback.Execute(Status);
+			}
+		});
+}
+
 const FRealtimeMeshDistanceField& URealtimeMeshSimple::GetDistanceField() const
 {
 	return GetMeshAs<FRealtimeMeshSimple>()->GetDistanceField();
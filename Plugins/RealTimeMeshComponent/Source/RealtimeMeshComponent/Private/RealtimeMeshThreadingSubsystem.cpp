@@ -2,7 +2,242 @@
 
 
 #include "RealtimeMeshThreadingSubsystem.h"
+#include "RealtimeMeshCore.h"
 #include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+#include <atomic>
+
+static TAutoConsoleVariable<int32> CVarRealtimeMeshThreadPoolNumThreads(
+	TEXT("r.RealtimeMesh.ThreadPool.NumThreads"),
+	4,
+	TEXT("Number of worker threads in the realtime mesh thread pool. Only read when the pool is created."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarRealtimeMeshThreadPoolThreadPriority(
+	TEXT("r.RealtimeMesh.ThreadPool.ThreadPriority"),
+	0,
+	TEXT("Thread priority of the realtime mesh workers. 0 = Normal, 1 = BelowNormal, 2 = Lowest, 3 = AboveNormal. Only read when the pool is created."),
+	ECVF_Default);
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("ThreadPool - Interactive Queue Depth"), STAT_RealtimeMeshThreadPool_InteractiveQueueDepth, STATGROUP_RealtimeMesh);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("ThreadPool - Streaming Queue Depth"), STAT_RealtimeMeshThreadPool_StreamingQueueDepth, STATGROUP_RealtimeMesh);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("ThreadPool - Background Queue Depth"), STAT_RealtimeMeshThreadPool_BackgroundQueueDepth, STATGROUP_RealtimeMesh);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("ThreadPool - Interactive Avg Queue Latency (ms)"), STAT_RealtimeMeshThreadPool_InteractiveLatency, STATGROUP_RealtimeMesh);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("ThreadPool - Streaming Avg Queue Latency (ms)"), STAT_RealtimeMeshThreadPool_StreamingLatency, STATGROUP_RealtimeMesh);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("ThreadPool - Background Avg Queue Latency (ms)"), STAT_RealtimeMeshThreadPool_BackgroundLatency, STATGROUP_RealtimeMesh);
+
+namespace RealtimeMesh
+{
+	enum class ERealtimeMeshTaskStatus : uint8
+	{
+		Queued,
+		Running,
+		Completed,
+		Cancelled
+	};
+
+	struct FRealtimeMeshTaskState
+	{
+		std::atomic<ERealtimeMeshTaskStatus> Status { ERealtimeMeshTaskStatus::Queued };
+		ERealtimeMeshTaskPriority Priority;
+
+		explicit FRealtimeMeshTaskState(ERealtimeMeshTaskPriority InPriority)
+			: Priority(InPriority) { }
+	};
+
+	namespace Private
+	{
+		struct FRealtimeMeshTaskLaneCounters
+		{
+			std::atomic<int32> QueueDepth { 0 };
+			std::atomic<int64> NumStarted { 0 };
+			std::atomic<int64> NumCompleted { 0 };
+			std::atomic<int64> NumCancelled { 0 };
+			std::atomic<int64> TotalLatencyMicroseconds { 0 };
+			std::atomic<int64> MaxLatencyMicroseconds { 0 };
+		};
+
+		static FRealtimeMeshTaskLaneCounters GTaskLaneCounters[static_cast<int32>(ERealtimeMeshTaskPriority::Num)];
+
+		static FRealtimeMeshTaskLaneCounters& GetLaneCounters(ERealtimeMeshTaskPriority Priority)
+		{
+			return GTaskLaneCounters[static_cast<int32>(Priority)];
+		}
+
+		static void UpdateQueueDepthStat(ERealtimeMeshTaskPriority Priority, bool bEnteredQueue)
+		{
+			switch (Priority)
+			{
+			case ERealtimeMeshTaskPriority::Interactive:
+				if (bEnteredQueue) { INC_DWORD_STAT(STAT_RealtimeMeshThreadPool_InteractiveQueueDepth); }
+				else { DEC_DWORD_STAT(STAT_RealtimeMeshThreadPool_InteractiveQueueDepth); }
+				break;
+			case ERealtimeMeshTaskPriority::Streaming:
+				if (bEnteredQueue) { INC_DWORD_STAT(STAT_RealtimeMeshThreadPool_StreamingQueueDepth); }
+				else { DEC_DWORD_STAT(STAT_RealtimeMeshThreadPool_StreamingQueueDepth); }
+				break;
+			default:
+				if (bEnteredQueue) { INC_DWORD_STAT(STAT_RealtimeMeshThreadPool_BackgroundQueueDepth); }
+				else { DEC_DWORD_STAT(STAT_RealtimeMeshThreadPool_BackgroundQueueDepth); }
+				break;
+			}
+		}
+
+		static void UpdateLatencyStat(ERealtimeMeshTaskPriority Priority, float AverageLatencyMs)
+		{
+			switch (Priority)
+			{
+			case ERealtimeMeshTaskPriority::Interactive:
+				SET_FLOAT_STAT(STAT_RealtimeMeshThreadPool_InteractiveLatency, AverageLatencyMs);
+				break;
+			case ERealtimeMeshTaskPriority::Streaming:
+				SET_FLOAT_STAT(STAT_RealtimeMeshThreadPool_StreamingLatency, AverageLatencyMs);
+				break;
+			default:
+				SET_FLOAT_STAT(STAT_RealtimeMeshThreadPool_BackgroundLatency, AverageLatencyMs);
+				break;
+			}
+		}
+
+		static EQueuedWorkPriority GetQueuedWorkPriority(ERealtimeMeshTaskPriority Priority)
+		{
+			switch (Priority)
+			{
+			case ERealtimeMeshTaskPriority::Interactive:
+				return EQueuedWorkPriority::High;
+			case ERealtimeMeshTaskPriority::Streaming:
+				return EQueuedWorkPriority::Normal;
+			default:
+				return EQueuedWorkPriority::Low;
+			}
+		}
+
+		static EThreadPriority GetThreadPriorityFromCVar()
+		{
+			switch (CVarRealtimeMeshThreadPoolThreadPriority.GetValueOnAnyThread())
+			{
+			case 1:
+				return TPri_BelowNormal;
+			case 2:
+				return TPri_Lowest;
+			case 3:
+				return TPri_AboveNormal;
+			default:
+				return TPri_Normal;
+			}
+		}
+
+		/*
+		 * Cancelled tasks aren't pulled out of the pool's queue, a worker still picks them up and just runs the
+		 * cancellation callback. Retracting would need the pool to outlive every handle, which we can't promise.
+		 */
+		class FRealtimeMeshQueuedTask final : public IQueuedWork
+		{
+			TSharedRef<FRealtimeMeshTaskState, ESPMode::ThreadSafe> State;
+			TUniqueFunction<void()> Work;
+			TUniqueFunction<void()> OnCancelled;
+			double QueuedTime;
+
+		public:
+			FRealtimeMeshQueuedTask(const TSharedRef<FRealtimeMeshTaskState, ESPMode::ThreadSafe>& InState, TUniqueFunction<void()>&& InWork,
+			                        TUniqueFunction<void()>&& InOnCancelled)
+				: State(InState)
+				, Work(MoveTemp(InWork))
+				, OnCancelled(MoveTemp(InOnCancelled))
+				, QueuedTime(FPlatformTime::Seconds())
+			{
+				GetLaneCounters(State->Priority).QueueDepth++;
+				UpdateQueueDepthStat(State->Priority, true);
+			}
+
+			virtual void DoThreadedWork() override
+			{
+				FRealtimeMeshTaskLaneCounters& Counters = GetLaneCounters(State->Priority);
+				LeaveQueue();
+
+				// A task cancelled while queued was already counted by Cancel(), it never started so it stays out of the latency
+				ERealtimeMeshTaskStatus Expected = ERealtimeMeshTaskStatus::Queued;
+				if (State->Status.compare_exchange_strong(Expected, ERealtimeMeshTaskStatus::Running))
+				{
+					const int64 LatencyMicroseconds = static_cast<int64>((FPlatformTime::Seconds() - QueuedTime) * 1000000.0);
+					const int64 NumStarted = ++Counters.NumStarted;
+					const int64 TotalLatency = Counters.TotalLatencyMicroseconds += LatencyMicroseconds;
+					int64 MaxLatency = Counters.MaxLatencyMicroseconds.load();
+					while (LatencyMicroseconds > MaxLatency && !Counters.MaxLatencyMicroseconds.compare_exchange_weak(MaxLatency, LatencyMicroseconds)) { }
+					UpdateLatencyStat(State->Priority, static_cast<float>(TotalLatency / NumStarted) / 1000.0f);
+
+					Work();
+					State->Status = ERealtimeMeshTaskStatus::Completed;
+					Counters.NumCompleted++;
+				}
+				else if (OnCancelled)
+				{
+					OnCancelled();
+				}
+
+				delete this;
+			}
+
+			virtual void Abandon() override
+			{
+				LeaveQueue();
+
+				ERealtimeMeshTaskStatus Expected = ERealtimeMeshTaskStatus::Queued;
+				if (State->Status.compare_exchange_strong(Expected, ERealtimeMeshTaskStatus::Cancelled))
+				{
+					GetLaneCounters(State->Priority).NumCancelled++;
+				}
+
+				if (OnCancelled)
+				{
+					OnCancelled();
+				}
+
+				delete this;
+			}
+
+		private:
+			void LeaveQueue() const
+			{
+				GetLaneCounters(State->Priority).QueueDepth--;
+				UpdateQueueDepthStat(State->Priority, false);
+			}
+		};
+	}
+
+	bool FRealtimeMeshTaskHandle::IsDone() const
+	{
+		if (!State.IsValid())
+		{
+			return false;
+		}
+		const ERealtimeMeshTaskStatus Status = State->Status.load();
+		return Status == ERealtimeMeshTaskStatus::Completed || Status == ERealtimeMeshTaskStatus::Cancelled;
+	}
+
+	bool FRealtimeMeshTaskHandle::IsCancelled() const
+	{
+		return State.IsValid() && State->Status.load() == ERealtimeMeshTaskStatus::Cancelled;
+	}
+
+	bool FRealtimeMeshTaskHandle::Cancel() const
+	{
+		if (!State.IsValid())
+		{
+			return false;
+		}
+
+		ERealtimeMeshTaskStatus Expected = ERealtimeMeshTaskStatus::Queued;
+		if (State->Status.compare_exchange_strong(Expected, ERealtimeMeshTaskStatus::Cancelled))
+		{
+			Private::GetLaneCounters(State->Priority).NumCancelled++;
+			return true;
+		}
+		return false;
+	}
+}
+
+using namespace RealtimeMesh;
 
 void URealtimeMeshThreadingSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
@@ -21,11 +256,54 @@ URealtimeMeshThreadingSubsystem* URealtimeMeshThreadingSubsystem::Get()
 
 FQueuedThreadPool& URealtimeMeshThreadingSubsystem::GetThreadPool()
 {
+	FScopeLock Lock(&ThreadPoolLock);
 	if (!ThreadPool.IsValid())
 	{
+		const int32 NumThreads = FMath::Max(1, ConfiguredNumThreads.Get(CVarRealtimeMeshThreadPoolNumThreads.GetValueOnAnyThread()));
+		const EThreadPriority ThreadPriority = ConfiguredThreadPriority.Get(Private::GetThreadPriorityFromCVar());
+		
 		ThreadPool = TUniquePtr<FQueuedThreadPool>(FQueuedThreadPool::Allocate());
-		ThreadPool->Create(4,  64 * 1024, TPri_Normal, TEXT("RealtimeMeshThreadPool"));
+		ThreadPool->Create(NumThreads,  64 * 1024, ThreadPriority, TEXT("RealtimeMeshThreadPool"));
 	}
 	
 	return *ThreadPool;
 }
+
+bool URealtimeMeshThreadingSubsystem::SetThreadPoolConfig(int32 NumThreads, EThreadPriority ThreadPriority)
+{
+	FScopeLock Lock(&ThreadPoolLock);
+	if (ThreadPool.IsValid())
+	{
+		return false;
+	}
+
+	ConfiguredNumThreads = NumThreads;
+	ConfiguredThreadPriority = ThreadPriority;
+	return true;
+}
+
+FRealtimeMeshTaskHandle URealtimeMeshThreadingSubsystem::LaunchTask(ERealtimeMeshTaskPriority Priority, TUniqueFunction<void()>&& Work,
+	TUniqueFunction<void()>&& OnCancelled)
+{
+	check(Priority < ERealtimeMeshTaskPriority::Num);
+	
+	TSharedRef<FRealtimeMeshTaskState, ESPMode::ThreadSafe> State = MakeShared<FRealtimeMeshTaskState, ESPMode::ThreadSafe>(Priority);
+	GetThreadPool().AddQueuedWork(new Private::FRealtimeMeshQueuedTask(State, MoveTemp(Work), MoveTemp(OnCancelled)),
+		Private::GetQueuedWorkPriority(Priority));
+	return FRealtimeMeshTaskHandle(State);
+}
+
+FRealtimeMeshTaskLaneStats URealtimeMeshThreadingSubsystem::GetLaneStats(ERealtimeMeshTaskPriority Priority)
+{
+	check(Priority < ERealtimeMeshTaskPriority::Num);
+	const Private::FRealtimeMeshTaskLaneCounters& Counters = Private::GetLaneCounters(Priority);
+
+	FRealtimeMeshTaskLaneStats Stats;
+	Stats.QueueDepth = Counters.QueueDepth.load();
+	Stats.NumCompleted = Counters.NumCompleted.load();
+	Stats.NumCancelled = Counters.NumCancelled.load();
+	const int64 NumStarted = Counters.NumStarted.load();
+	Stats.AverageLatencySeconds = NumStarted > 0 ? static_cast<double>(Counters.TotalLatencyMicroseconds.load()) / NumStarted / 1000000.0 : 0.0;
+	Stats.MaxLatencySeconds = static_cast<double>(Counters.MaxLatencyMicroseconds.load()) / 1000000.0;
+	return Stats;
+}
@@ -85,7 +85,8 @@ namespace RealtimeMesh
 				{
 					if (SectionGroup->GetDrawMask().IsAnySet(DrawTypeMask))
 					{
-						SectionGroup->CreateMeshBatches(Params, Materials, WireframeMaterial, DrawType, EnumHasAllFlags(InclusionFlags, ERealtimeMeshBatchCreationFlags::ForceAllDynamic));
+						SectionGroup->CreateMeshBatches(Params, Materials, WireframeMaterial, DrawType, EnumHasAllFlags(InclusionFlags, ERealtimeMeshBatchCreationFlags::ForceAllDynamic),
+						                                EnumHasAllFlags(InclusionFlags, ERealtimeMeshBatchCreationFlags::MergeCompatibleSections));
 					}
 				}
 			}
@@ -11,6 +11,7 @@ namespace RealtimeMesh
 		: SharedResources(InSharedResources)
 		  , ValidLODRange(TRange<int8>::Empty())
 		  , bIsStateDirty(true)
+		  , bMergeCompatibleSections(false)
 	{
 	}
 
@@ -33,6 +34,17 @@ namespace RealtimeMesh
 		return ScreenSizeRangeByLOD.IsValidIndex(LODKey) ? ScreenSizeRangeByLOD[LODKey] : TRange<float>(0.0f, 0.0f);
 	}
 
+	void FRealtimeMeshProxy::SetMergeCompatibleSections(bool bInMergeCompatibleSections)
+	{
+		check(IsInRenderingThread());
+
+		if (bMergeCompatibleSections != bInMergeCompatibleSections)
+		{
+			bMergeCompatibleSections = bInMergeCompatibleSections;
+			MarkStateDirty();
+		}
+	}
+
 	void FRealtimeMeshProxy::SetDistanceField(FRealtimeMeshDistanceField&& InDistanceField)
 	{
 		check(IsInRenderingThread());
@@ -113,6 +125,12 @@ namespace RealtimeMesh
 	void FRealtimeMeshProxy::CreateMeshBatches(int32 LODIndex, const FRealtimeMeshBatchCreationParams& Params, const TMap<int32, TTuple<FMaterialRenderProxy*, bool>>& Materials,
 	                                           const FMaterialRenderProxy* WireframeMaterial, ERealtimeMeshSectionDrawType DrawType, ERealtimeMeshBatchCreationFlags InclusionFlags) const
 	{
+		// Ray traced instances map one batch to one geometry segment, so those are never merged
+		if (bMergeCompatibleSections && !EnumHasAnyFlags(InclusionFlags, ERealtimeMeshBatchCreationFlags::SkipStaticRayTracedSections))
+		{
+			InclusionFlags |= ERealtimeMeshBatchCreationFlags::MergeCompatibleSections;
+		}
+
 		const auto& LOD = LODs[LODIndex];
 		LOD->CreateMeshBatches(Params, Materials, WireframeMaterial, DrawType, InclusionFlags);
 	}
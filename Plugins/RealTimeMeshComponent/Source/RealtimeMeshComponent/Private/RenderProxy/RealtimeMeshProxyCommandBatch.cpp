@@ -10,6 +10,11 @@
 
 namespace RealtimeMesh
 {
+	namespace Private
+	{
+		static thread_local FRealtimeMeshUpdateBatch* GActiveUpdateBatch = nullptr;
+	}
+
 	FRealtimeMeshProxyCommandBatch::FRealtimeMeshProxyCommandBatch(const FRealtimeMeshSharedResourcesPtr& InSharedResources, bool bInRequiresProxyRecreate):
 		Mesh(InSharedResources.IsValid() ? InSharedResources->GetOwner() : nullptr)
 		, bRequiresProxyRecreate(bInRequiresProxyRecreate)
@@ -25,6 +30,7 @@ namespace RealtimeMesh
 	struct FRealtimeMeshCommandBatchIntermediateFuture : public TSharedFromThis<FRealtimeMeshCommandBatchIntermediateFuture>
 	{
 		TSharedRef<TPromise<ERealtimeMeshProxyUpdateStatus>> FinalPromise;
+		TArray<TPromise<ERealtimeMeshProxyUpdateStatus>> DependentPromises;
 		ERealtimeMeshProxyUpdateStatus Result;
 		uint8 bRenderThreadReady : 1;
 		uint8 bGameThreadReady : 1;
@@ -48,8 +54,7 @@ namespace RealtimeMesh
 
 				if (!ThisShared->bFinalized)
 				{
-					ThisShared->FinalPromise->EmplaceValue(ThisShared->Result);
-					ThisShared->bFinalized = true;
+					ThisShared->Finalize();
 				}
 			});
 		}
@@ -60,10 +65,21 @@ namespace RealtimeMesh
 
 			if (bRenderThreadReady && !bFinalized)
 			{
-				FinalPromise->EmplaceValue(Result);
-				bFinalized = true;
+				Finalize();
 			}
 		}
+
+	private:
+		void Finalize()
+		{
+			FinalPromise->EmplaceValue(Result);
+			for (TPromise<ERealtimeMeshProxyUpdateStatus>& Promise : DependentPromises)
+			{
+				Promise.EmplaceValue(Result);
+			}
+			DependentPromises.Empty();
+			bFinalized = true;
+		}
 	};
 
 
@@ -81,6 +97,15 @@ namespace RealtimeMesh
 			return MakeFulfilledPromise<ERealtimeMeshProxyUpdateStatus>(ERealtimeMeshProxyUpdateStatus::NoProxy).GetFuture();
 		}
 
+		// Hand the tasks to the open transaction, it submits them together with everything else
+		if (FRealtimeMeshUpdateBatch* UpdateBatch = FRealtimeMeshUpdateBatch::GetActive())
+		{
+			TFuture<ERealtimeMeshProxyUpdateStatus> Future = UpdateBatch->AddCommands(Mesh, MoveTemp(Tasks), bRequiresProxyRecreate);
+			Tasks.Empty();
+			bRequiresProxyRecreate = false;
+			return Future;
+		}
+
 		// Skip if no proxy
 		const FRealtimeMeshProxyPtr Proxy = Mesh->GetRenderProxy(true);
 
@@ -121,6 +146,124 @@ namespace RealtimeMesh
 	}
 
 
+	FRealtimeMeshUpdateBatch::FRealtimeMeshUpdateBatch()
+		: Outer(Private::GActiveUpdateBatch)
+		, bCommitted(false)
+	{
+		if (!Outer)
+		{
+			Private::GActiveUpdateBatch = this;
+		}
+	}
+
+	FRealtimeMeshUpdateBatch::~FRealtimeMeshUpdateBatch()
+	{
+		if (!bCommitted)
+		{
+			Commit();
+		}
+	}
+
+	FRealtimeMeshUpdateBatch* FRealtimeMeshUpdateBatch::GetActive()
+	{
+		return Private::GActiveUpdateBatch;
+	}
+
+	TFuture<ERealtimeMeshProxyUpdateStatus> FRealtimeMeshUpdateBatch::Commit()
+	{
+		check(!bCommitted);
+		bCommitted = true;
+
+		// Nested transactions complete with the outermost one
+		if (Outer)
+		{
+			return Outer->AddDependentFuture();
+		}
+
+		check(Private::GActiveUpdateBatch == this);
+		Private::GActiveUpdateBatch = nullptr;
+
+		if (Meshes.IsEmpty())
+		{
+			for (TPromise<ERealtimeMeshProxyUpdateStatus>& Promise : DependentPromises)
+			{
+				Promise.EmplaceValue(ERealtimeMeshProxyUpdateStatus::NoUpdate);
+			}
+			DependentPromises.Empty();
+			return MakeFulfilledPromise<ERealtimeMeshProxyUpdateStatus>(ERealtimeMeshProxyUpdateStatus::NoUpdate).GetFuture();
+		}
+
+		auto ThreadState = MakeShared<FRealtimeMeshCommandBatchIntermediateFuture>();
+		ThreadState->DependentPromises = MoveTemp(DependentPromises);
+
+		TArray<TTuple<FRealtimeMeshWeakPtr, bool>> MeshesToMarkDirty;
+		MeshesToMarkDirty.Reserve(Meshes.Num());
+		for (const FMeshCommands& MeshCommands : Meshes)
+		{
+			MeshesToMarkDirty.Emplace(MeshCommands.Mesh, MeshCommands.bRequiresProxyRecreate);
+		}
+
+		ENQUEUE_RENDER_COMMAND(FRealtimeMeshProxy_BatchUpdate)([ThreadState, Meshes = MoveTemp(Meshes)](FRHICommandListImmediate&)
+		{
+			bool bAnyUpdated = false;
+			for (const FMeshCommands& MeshCommands : Meshes)
+			{
+				if (const auto& Proxy = MeshCommands.Proxy.Pin())
+				{
+					for (const auto& Task : MeshCommands.Tasks)
+					{
+						Task(*Proxy.Get());
+					}
+					Proxy->UpdatedCachedState(false);
+					bAnyUpdated = true;
+				}
+			}
+			ThreadState->FinalizeRenderThread(bAnyUpdated ? ERealtimeMeshProxyUpdateStatus::Updated : ERealtimeMeshProxyUpdateStatus::NoProxy);
+		});
+
+		AsyncTask(ENamedThreads::GameThread, [ThreadState, MeshesToMarkDirty = MoveTemp(MeshesToMarkDirty)]()
+		{
+			for (const TTuple<FRealtimeMeshWeakPtr, bool>& Entry : MeshesToMarkDirty)
+			{
+				if (const FRealtimeMeshPtr MeshToMarkDirty = Entry.Get<0>().Pin())
+				{
+					MeshToMarkDirty->MarkRenderStateDirty(Entry.Get<1>());
+				}
+			}
+
+			ThreadState->FinalizeGameThread();
+		});
+
+		Meshes.Empty();
+		MeshIndices.Empty();
+
+		return ThreadState->FinalPromise->GetFuture();
+	}
+
+	TFuture<ERealtimeMeshProxyUpdateStatus> FRealtimeMeshUpdateBatch::AddCommands(const FRealtimeMeshPtr& InMesh, TArray<TaskFunctionType>&& InTasks,
+	                                                                             bool bInRequiresProxyRecreate)
+	{
+		check(!bCommitted);
+
+		int32& MeshIndex = MeshIndices.FindOrAdd(InMesh.Get(), INDEX_NONE);
+		if (MeshIndex == INDEX_NONE)
+		{
+			MeshIndex = Meshes.Emplace(FMeshCommands { InMesh, InMesh->GetRenderProxy(true), { }, false });
+		}
+
+		FMeshCommands& MeshCommands = Meshes[MeshIndex];
+		MeshCommands.Tasks.Append(MoveTemp(InTasks));
+		MeshCommands.bRequiresProxyRecreate |= bInRequiresProxyRecreate;
+
+		return AddDependentFuture();
+	}
+
+	TFuture<ERealtimeMeshProxyUpdateStatus> FRealtimeMeshUpdateBatch::AddDependentFuture()
+	{
+		checkf(!bCommitted, TEXT("Nested FRealtimeMeshUpdateBatch outlived the batch it was nested in."));
+		return DependentPromises.Emplace_GetRef().GetFuture();
+	}
+
 	void FRealtimeMeshProxyCommandBatch::AddMeshTask(TUniqueFunction<void(FRealtimeMeshProxy&)>&& Function, bool bInRequiresProxyRecreate)
 	{
 		check(Mesh.IsValid());
@@ -19,6 +19,7 @@ namespace RealtimeMesh
 		: SharedResources(InSharedResources)
 		  , Key(InKey)
 		  , VertexFactory(SharedResources->CreateVertexFactory())
+		  , TrackedGPUBytes(0)
 		  , bIsStateDirty(true)
 	{
 	}
@@ -86,6 +87,8 @@ namespace RealtimeMesh
 
 	void FRealtimeMeshSectionGroupProxy::CreateOrUpdateStream(const FRealtimeMeshSectionGroupStreamUpdateDataRef& InStream)
 	{
+		LLM_SCOPE_BYTAG(RealtimeMesh);
+
 		// If we didn't create the buffers async, create them now
 		InStream->InitializeIfRequired();
 
@@ -129,21 +132,43 @@ namespace RealtimeMesh
 		TRHIResourceUpdateBatcher<FRealtimeMeshGPUBuffer::RHIUpdateBatchSize> Batcher;
 		GPUBuffer->ApplyBufferUpdate(Batcher, InStream);
 
+		UpdateMemoryStats();
 		MarkStateDirty();
 	}
 
+	void FRealtimeMeshSectionGroupProxy::UpdateStreamRange(const FRealtimeMeshSectionGroupStreamRangeUpdateDataRef& InStreamRange)
+	{
+		const FRealtimeMeshStreamKey StreamKey = InStreamRange->GetStreamKey();
+		const TSharedPtr<FRealtimeMeshGPUBuffer, ESPMode::ThreadSafe>* FoundBuffer = Streams.Find(StreamKey);
+
+		if (!FoundBuffer || !(*FoundBuffer)->ApplyBufferRangeUpdate(InStreamRange))
+		{
+			UE_LOG(RealtimeMeshLog, Warning, TEXT("Unable to update range [%d, %d) of stream %s, it is outside of the current GPU buffer."),
+				InStreamRange->GetFirstElement(), InStreamRange->GetFirstElement() + InStreamRange->GetNumElements(), *StreamKey.ToString());
+			return;
+		}
+
+		// The buffers are the same, only the ray tracing geometry depends on their contents
+		if (StreamKey == FRealtimeMeshStreams::Position || StreamKey == FRealtimeMeshStreams::Triangles)
+		{
+			MarkStateDirty();
+		}
+	}
+
 	void FRealtimeMeshSectionGroupProxy::RemoveStream(const FRealtimeMeshStreamKey& StreamKey)
 	{
 		if (const auto* Stream = Streams.Find(StreamKey))
 		{
 			(*Stream)->ReleaseUnderlyingResource();
 			Streams.Remove(StreamKey);
+			UpdateMemoryStats();
 			MarkStateDirty();
 		}
 	}
 
 	void FRealtimeMeshSectionGroupProxy::CreateMeshBatches(const FRealtimeMeshBatchCreationParams& Params, const TMap<int32, TTuple<FMaterialRenderProxy*, bool>>& Materials,
-	                                                       const FMaterialRenderProxy* WireframeMaterial, ERealtimeMeshSectionDrawType DrawType, bool bForceAllDynamic) const
+	                                                       const FMaterialRenderProxy* WireframeMaterial, ERealtimeMeshSectionDrawType DrawType, bool bForceAllDynamic,
+	                                                       bool bMergeCompatibleSections) const
 	{
 		const ERealtimeMeshDrawMask DrawTypeMask = bForceAllDynamic
 			                                           ? ERealtimeMeshDrawMask::DrawPassMask
@@ -153,37 +178,69 @@ namespace RealtimeMesh
 
 		check(DrawMask.IsAnySet(DrawTypeMask));
 
-		for (const auto& Section : Sections)
+		const bool bIsWireframe = WireframeMaterial != nullptr;
+
+		const auto ResolveMaterial = [&](int32 MaterialSlot, bool& bOutSupportsDithering) -> const FMaterialRenderProxy*
 		{
-			if (Section->GetDrawMask().IsAnySet(DrawTypeMask))
+			bOutSupportsDithering = false;
+			if (bIsWireframe)
 			{
-				check(GetVertexFactory() && GetVertexFactory().IsValid() && GetVertexFactory()->IsInitialized());
-
-				const bool bIsWireframe = WireframeMaterial != nullptr;
+				return WireframeMaterial;
+			}
 
-				FMaterialRenderProxy* SectionMaterial = nullptr;
-				bool bSupportsDithering = false;
+			FMaterialRenderProxy* SectionMaterial = nullptr;
+			const TTuple<FMaterialRenderProxy*, bool>* MatEntry = Materials.Find(MaterialSlot);
+			if (MatEntry != nullptr && MatEntry->Get<0>() != nullptr)
+			{
+				SectionMaterial = MatEntry->Get<0>();
+				bOutSupportsDithering = MatEntry->Get<1>();
+			}
+			else
+			{
+				SectionMaterial = UMaterial::GetDefaultMaterial(MD_Surface)->GetRenderProxy();
+			}
+			ensure(SectionMaterial);
+			return SectionMaterial;
+		};
 
-				if (!bIsWireframe)
+		if (bMergeCompatibleSections)
+		{
+			// One batch per material/draw mask, each joined index range becomes an element of it
+			for (const FRealtimeMeshSectionDrawRun& Run : DrawRuns)
+			{
+				if (Run.DrawMask.IsAnySet(DrawTypeMask))
 				{
-					const TTuple<FMaterialRenderProxy*, bool>* MatEntry = Materials.Find(Section->GetMaterialSlot());
-					if (MatEntry != nullptr && MatEntry->Get<0>() != nullptr)
-					{
-						SectionMaterial = MatEntry->Get<0>();
-						bSupportsDithering = MatEntry->Get<1>();
-					}
-					else
-					{
-						SectionMaterial = UMaterial::GetDefaultMaterial(MD_Surface)->GetRenderProxy();
-					}
-					ensure(SectionMaterial);
+					check(GetVertexFactory() && GetVertexFactory().IsValid() && GetVertexFactory()->IsInitialized());
+
+					bool bSupportsDithering;
+					const FMaterialRenderProxy* RunMaterial = ResolveMaterial(Run.MaterialSlot, bSupportsDithering);
+
+#if RHI_RAYTRACING
+					FRealtimeMeshSectionProxy::CreateMeshBatchForRanges(Params, GetVertexFactory().ToSharedRef(), RunMaterial, bIsWireframe, bSupportsDithering,
+					                                                    Key.LOD(), Run.DrawMask, Run.Ranges, &RayTracingGeometry);
+#else
+					FRealtimeMeshSectionProxy::CreateMeshBatchForRanges(Params, GetVertexFactory().ToSharedRef(), RunMaterial, bIsWireframe, bSupportsDithering,
+					                                                    Key.LOD(), Run.DrawMask, Run.Ranges);
+#endif
 				}
+			}
+			return;
+		}
+
+		for (const auto& Section : Sections)
+		{
+			if (Section->GetDrawMask().IsAnySet(DrawTypeMask))
+			{
+				check(GetVertexFactory() && GetVertexFactory().IsValid() && GetVertexFactory()->IsInitialized());
+
+				bool bSupportsDithering;
+				const FMaterialRenderProxy* SectionMaterial = ResolveMaterial(Section->GetMaterialSlot(), bSupportsDithering);
 
 #if RHI_RAYTRACING
-				Section->CreateMeshBatch(Params, GetVertexFactory().ToSharedRef(), bIsWireframe ? WireframeMaterial : SectionMaterial, bIsWireframe, bSupportsDithering,
+				Section->CreateMeshBatch(Params, GetVertexFactory().ToSharedRef(), SectionMaterial, bIsWireframe, bSupportsDithering,
 				                         &RayTracingGeometry);
 #else
-				Section->CreateMeshBatch(Params, GetVertexFactory().ToSharedRef(), bIsWireframe? WireframeMaterial : SectionMaterial, bIsWireframe, bSupportsDithering);
+				Section->CreateMeshBatch(Params, GetVertexFactory().ToSharedRef(), SectionMaterial, bIsWireframe, bSupportsDithering);
 #endif
 			}
 		}
@@ -221,7 +278,8 @@ namespace RealtimeMesh
 		const bool bStateChanged = DrawMask != NewDrawMask;
 		DrawMask = NewDrawMask;		
 		bIsStateDirty = false;
-		
+
+		UpdateDrawRuns();
 		UpdateRayTracingInfo();
 		
 		return bStateChanged;
@@ -249,6 +307,7 @@ namespace RealtimeMesh
 			Stream.Value->ReleaseUnderlyingResource();
 		}
 		Streams.Empty();
+		UpdateMemoryStats();
 
 		// Reset the sections and clear them
 		for (const auto& Section : Sections)
@@ -257,6 +316,7 @@ namespace RealtimeMesh
 		}
 		Sections.Empty();
 		SectionMap.Reset();
+		DrawRuns.Empty();
 
 		DrawMask = FRealtimeMeshDrawMask();
 		bIsStateDirty = true;
@@ -327,6 +387,63 @@ namespace RealtimeMesh
 #endif
 	}
 
+	void FRealtimeMeshSectionGroupProxy::UpdateDrawRuns()
+	{
+		DrawRuns.Reset();
+
+		for (const auto& Section : Sections)
+		{
+			const FRealtimeMeshDrawMask SectionDrawMask = Section->GetDrawMask();
+			if (!SectionDrawMask.HasAnyFlags())
+			{
+				continue;
+			}
+
+			FRealtimeMeshSectionDrawRun* Run = DrawRuns.FindByPredicate([&](const FRealtimeMeshSectionDrawRun& Existing)
+			{
+				return Existing.MaterialSlot == Section->GetMaterialSlot() && Existing.DrawMask == SectionDrawMask;
+			});
+
+			if (!Run)
+			{
+				Run = &DrawRuns.AddDefaulted_GetRef();
+				Run->MaterialSlot = Section->GetMaterialSlot();
+				Run->DrawMask = SectionDrawMask;
+			}
+			Run->Ranges.Add(Section->GetStreamRange());
+		}
+
+		// Sections laid out back to back in the index buffer collapse into a single element
+		for (FRealtimeMeshSectionDrawRun& Run : DrawRuns)
+		{
+			Run.Ranges.Sort([](const FRealtimeMeshStreamRange& A, const FRealtimeMeshStreamRange& B) { return A.GetMinIndex() < B.GetMinIndex(); });
+
+			int32 WriteIndex = 0;
+			for (int32 ReadIndex = 1; ReadIndex < Run.Ranges.Num(); ReadIndex++)
+			{
+				if (Run.Ranges[ReadIndex].GetMinIndex() == Run.Ranges[WriteIndex].GetMaxIndex() + 1)
+				{
+					Run.Ranges[WriteIndex] = Run.Ranges[WriteIndex].Hull(Run.Ranges[ReadIndex]);
+				}
+				else
+				{
+					Run.Ranges[++WriteIndex] = Run.Ranges[ReadIndex];
+				}
+			}
+			Run.Ranges.SetNum(WriteIndex + 1);
+		}
+	}
+
+	void FRealtimeMeshSectionGroupProxy::UpdateMemoryStats()
+	{
+		int64 NewGPUBytes = 0;
+		for (const auto& Stream : Streams)
+		{
+			NewGPUBytes += Stream.Value->GetAllocatedSize();
+		}
+		SharedResources->GetMemoryCounters().UpdateBytes(ERealtimeMeshMemoryCategory::GPUBuffers, TrackedGPUBytes, NewGPUBytes);
+	}
+
 	void FRealtimeMeshSectionGroupProxy::RebuildSectionMap()
 	{
 		SectionMap.Empty();
@@ -41,13 +41,36 @@ namespace RealtimeMesh
 #endif
 	) const
 	{
+#if RHI_RAYTRACING
+		return CreateMeshBatchForRanges(Params, VertexFactory, Material, bIsWireframe, bSupportsDithering, Key.LOD(), DrawMask, MakeArrayView(&StreamRange, 1), RayTracingGeometry);
+#else
+		return CreateMeshBatchForRanges(Params, VertexFactory, Material, bIsWireframe, bSupportsDithering, Key.LOD(), DrawMask, MakeArrayView(&StreamRange, 1));
+#endif
+	}
+
+	bool FRealtimeMeshSectionProxy::CreateMeshBatchForRanges(
+		const FRealtimeMeshBatchCreationParams& Params,
+		const FRealtimeMeshVertexFactoryRef& VertexFactory,
+		const FMaterialRenderProxy* Material,
+		bool bIsWireframe,
+		bool bSupportsDithering,
+		int32 LODIndex,
+		FRealtimeMeshDrawMask InDrawMask,
+		TConstArrayView<FRealtimeMeshStreamRange> Ranges
+#if RHI_RAYTRACING
+		, const FRayTracingGeometry* RayTracingGeometry
+#endif
+	)
+	{
+		check(Ranges.Num() > 0);
+
 		if (!VertexFactory->GatherVertexBufferResources(Params.ResourceSubmitter))
 		{
 			return false;
 		}
 
 		FMeshBatch& MeshBatch = Params.BatchAllocator();
-		MeshBatch.LODIndex = Key.LOD();
+		MeshBatch.LODIndex = LODIndex;
 #if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
 		MeshBatch.VisualizeLODIndex = MeshBatch.LODIndex;
 #endif
@@ -71,28 +94,34 @@ namespace RealtimeMesh
 		MeshBatch.VertexFactory = &VertexFactory.Get();
 		MeshBatch.Type = VertexFactory->GetPrimitiveType();
 
-		MeshBatch.CastShadow = DrawMask.ShouldRenderShadow();
+		MeshBatch.CastShadow = InDrawMask.ShouldRenderShadow();
 #if RHI_RAYTRACING
 		MeshBatch.CastRayTracedShadow = MeshBatch.CastShadow && Params.bCastRayTracedShadow;
 #endif
-		
-
-		FMeshBatchElement& BatchElement = MeshBatch.Elements[0];
-		//BatchElement.UserIndex = Key;
-		
-		BatchElement.PrimitiveUniformBuffer = Params.UniformBuffer;
-		BatchElement.IndexBuffer = &VertexFactory->GetIndexBuffer(bDepthOnly, bMatrixInverted, Params.ResourceSubmitter);
-		BatchElement.FirstIndex = StreamRange.GetMinIndex();
-		BatchElement.NumPrimitives = StreamRange.NumPrimitives(REALTIME_MESH_NUM_INDICES_PER_PRIMITIVE);
-		BatchElement.MinVertexIndex = StreamRange.GetMinVertex();
-		BatchElement.MaxVertexIndex = StreamRange.GetMaxVertex();
 
-		check(BatchElement.NumPrimitives <= (static_cast<const FRealtimeMeshIndexBuffer*>(BatchElement.IndexBuffer)->Num() - BatchElement.FirstIndex) / 3);
-		check((int32)BatchElement.NumPrimitives <= StreamRange.NumPrimitives(REALTIME_MESH_NUM_INDICES_PER_PRIMITIVE))
-		check((int32)BatchElement.MaxVertexIndex <= StreamRange.GetMaxVertex())
+		const FIndexBuffer* IndexBuffer = &VertexFactory->GetIndexBuffer(bDepthOnly, bMatrixInverted, Params.ResourceSubmitter);
 
-		BatchElement.MinScreenSize = Params.ScreenSizeLimits.GetLowerBoundValue();
-		BatchElement.MaxScreenSize = Params.ScreenSizeLimits.GetUpperBoundValue();
+		MeshBatch.Elements.SetNum(Ranges.Num());
+		for (int32 RangeIndex = 0; RangeIndex < Ranges.Num(); RangeIndex++)
+		{
+			const FRealtimeMeshStreamRange& StreamRange = Ranges[RangeIndex];
+			FMeshBatchElement& BatchElement = MeshBatch.Elements[RangeIndex];
+			//BatchElement.UserIndex = Key;
+
+			BatchElement.PrimitiveUniformBuffer = Params.UniformBuffer;
+			BatchElement.IndexBuffer = IndexBuffer;
+			BatchElement.FirstIndex = StreamRange.GetMinIndex();
+			BatchElement.NumPrimitives = StreamRange.NumPrimitives(REALTIME_MESH_NUM_INDICES_PER_PRIMITIVE);
+			BatchElement.MinVertexIndex = StreamRange.GetMinVertex();
+			BatchElement.MaxVertexIndex = StreamRange.GetMaxVertex();
+
+			check(BatchElement.NumPrimitives <= (static_cast<const FRealtimeMeshIndexBuffer*>(BatchElement.IndexBuffer)->Num() - BatchElement.FirstIndex) / 3);
+			check((int32)BatchElement.NumPrimitives <= StreamRange.NumPrimitives(REALTIME_MESH_NUM_INDICES_PER_PRIMITIVE))
+			check((int32)BatchElement.MaxVertexIndex <= StreamRange.GetMaxVertex())
+
+			BatchElement.MinScreenSize = Params.ScreenSizeLimits.GetLowerBoundValue();
+			BatchElement.MaxScreenSize = Params.ScreenSizeLimits.GetUpperBoundValue();
+		}
 
 #if RHI_RAYTRACING
 		Params.BatchSubmitter(MeshBatch, Params.ScreenSizeLimits.GetLowerBoundValue(), RayTracingGeometry);
@@ -144,7 +173,8 @@ namespace RealtimeMesh
 			}
 		}
 
-		const bool bStateChanged = DrawMask != NewDrawMask;
+		// A new config or stream range changes how the parent group batches this section, even if the mask is the same
+		const bool bStateChanged = bIsStateDirty || DrawMask != NewDrawMask;
 		DrawMask = NewDrawMask;
 		bIsStateDirty = false;
 		return bStateChanged;
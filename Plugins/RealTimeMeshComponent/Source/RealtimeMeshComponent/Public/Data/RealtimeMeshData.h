@@ -28,6 +28,7 @@ namespace RealtimeMesh
 		TFixedLODArray<FRealtimeMeshLODDataRef> LODs;
 		FRealtimeMeshConfig Config;
 		FRealtimeMeshBounds Bounds;
+		bool bMergeCompatibleSections;
 
 		TSharedPtr<IRealtimeMeshNaniteResources> NaniteResources;
 	public:
@@ -74,6 +75,10 @@ namespace RealtimeMesh
 		virtual void ClearNaniteResources(FRealtimeMeshProxyCommandBatch& Commands);
 		TFuture<ERealtimeMeshProxyUpdateStatus> ClearNaniteResources();
 		
+		bool IsMergingCompatibleSections() const;
+		virtual void SetMergeCompatibleSections(FRealtimeMeshProxyCommandBatch& Commands, bool bInMergeCompatibleSections);
+		TFuture<ERealtimeMeshProxyUpdateStatus> SetMergeCompatibleSections(bool bInMergeCompatibleSections);
+
 		virtual void SetDistanceField(FRealtimeMeshProxyCommandBatch& Commands, FRealtimeMeshDistanceField&& InDistanceField);
 		TFuture<ERealtimeMeshProxyUpdateStatus> SetDistanceField(FRealtimeMeshDistanceField&& InDistanceField);
 		virtual void ClearDistanceField(FRealtimeMeshProxyCommandBatch& Commands);
@@ -5,6 +5,7 @@
 #include "RealtimeMeshCore.h"
 #include "RealtimeMeshConfig.h"
 #include "RealtimeMeshGuard.h"
+#include "RealtimeMeshMemoryStats.h"
 #include "Mesh/RealtimeMeshDataStream.h"
 
 struct FRealtimeMeshSimpleGeometry;
@@ -120,6 +121,7 @@ namespace RealtimeMesh
 	class REALTIMEMESHCOMPONENT_API FRealtimeMeshSharedResources : public TSharedFromThis<FRealtimeMeshSharedResources>
 	{
 		mutable FRealtimeMeshGuard Guard;
+		mutable FRealtimeMeshMemoryCounters MemoryCounters;
 		FName MeshName;
 
 		TWeakObjectPtr<URealtimeMesh> OwningMesh;
@@ -172,6 +174,7 @@ namespace RealtimeMesh
 		virtual void SetProxy(const FRealtimeMeshProxyRef& InProxy) { Proxy = InProxy; }
 
 		FRealtimeMeshGuard& GetGuard() const { return Guard; }
+		FRealtimeMeshMemoryCounters& GetMemoryCounters() const { return MemoryCounters; }
 		FName GetMeshName() const { return MeshName; }
 		void SetMeshName(FName InName) { MeshName = InName; }
 
@@ -307,220 +307,66 @@ namespace RealtimeMeshAlgo
 	                                                                      const RealtimeMesh::FRealtimeMeshStream& Indices, TMap<int32, FRealtimeMeshStreamRange>& OutStreamRanges);
 
 
+	namespace Private
+	{
+		/**
+		 * Finds every pair of vertices that the tangent generator treats as the same position. Uses a spatial hash
+		 * instead of a sorted sweep so it scales to large meshes, but applies the same match test as before so the
+		 * pairs found are identical. Result is a CSR list, overlaps of vertex N are OutOverlaps[OutOffsets[N]..OutOffsets[N+1]).
+		 */
+		REALTIMEMESHCOMPONENT_API void FindOverlappingVertices(TConstArrayView<const FVector3f> Vertices, TArray<int32>& OutOffsets, TArray<uint32>& OutOverlaps);
+
+		/**
+		 * Builds the vertex to triangle adjacency for a flat index list as a CSR list, triangles of vertex N are
+		 * OutTriangles[OutOffsets[N]..OutOffsets[N+1]) in ascending order. Indices must already be within range.
+		 */
+		REALTIMEMESHCOMPONENT_API void BuildVertexTriangleAdjacency(TConstArrayView<const uint32> Indices, int32 NumVertices, TArray<int32>& OutOffsets,
+		                                                            TArray<uint32>& OutTriangles);
+
+		/**
+		 * Computes the final per vertex tangent basis. Face and vertex passes run in parallel, UVs may be empty.
+		 */
+		REALTIMEMESHCOMPONENT_API void ComputeVertexTangents(TConstArrayView<const uint32> Indices, TConstArrayView<const FVector3f> Vertices,
+		                                                     TConstArrayView<const FVector2f> UVs, bool bComputeSmoothNormals,
+		                                                     TArray<FVector3f>& OutTangentX, TArray<FVector3f>& OutTangentY, TArray<FVector3f>& OutTangentZ);
+	}
+
 	template <typename TriangleType>
 	void GenerateTangents(TConstArrayView<const TriangleType> Triangles, TConstArrayView<const FVector3f> Vertices,
 	                      const TFunction<FVector2f(int32)>& UVGetter, const TFunctionRef<void(int32, FVector3f, FVector3f)>& TangentsSetter, bool bComputeSmoothNormals = true)
 	{
-		uint32 NumIndices = Triangles.Num();
-		uint32 NumVertices = Vertices.Num();
-
-		// Calculate the duplicate vertices map if we're wanting smooth normals.  Don't find duplicates if we don't want smooth normals
-		// that will cause it to only smooth across faces sharing a common vertex, not across faces with vertices of common position
-		TMultiMap<uint32, uint32> DuplicateVertexMap;
-
-		if (bComputeSmoothNormals)
+		const int32 NumVertices = Vertices.Num();
+		const int32 NumIndices = (Triangles.Num() / 3) * 3;
+		if (NumVertices == 0)
 		{
-			using namespace Private;
-
-			TArray<FRealtimeMeshVertexSortElement> VertexSorter;
-			VertexSorter.Empty(NumVertices);
-			for (uint32 Index = 0; Index < NumVertices; Index++)
-			{
-				new(VertexSorter)FRealtimeMeshVertexSortElement(Index, Vertices[Index]);
-			}
-
-			// Sort the list
-			VertexSorter.Sort(FRuntimeMeshVertexSortingFunction());
-
-			// Map out the duplicates.
-			for (uint32 Index = 0; Index < NumVertices; Index++)
-			{
-				uint32 SrcVertIdx = VertexSorter[Index].Index;
-				float Value = VertexSorter[Index].Value;
-
-				// Search forward adding pairs both ways
-				for (uint32 SubIndex = Index + 1; SubIndex < NumVertices; SubIndex++)
-				{
-					if (FMath::Abs(VertexSorter[SubIndex].Value - Value) > THRESH_POINTS_ARE_SAME * 4.01f)
-					{
-						// No more possible duplicates
-						break;
-					}
-
-					uint32 OtherVertIdx = VertexSorter[SubIndex].Index;
-					if (Vertices[SrcVertIdx].Equals(Vertices[OtherVertIdx]))
-					{
-						DuplicateVertexMap.AddUnique(SrcVertIdx, OtherVertIdx);
-						DuplicateVertexMap.AddUnique(OtherVertIdx, SrcVertIdx);
-					}
-				}
-			}
+			return;
 		}
 
-		// Number of triangles
-		const uint32 NumTris = NumIndices / 3;
-
-		// Map of vertex to triangles in Triangles array
-		TMultiMap<uint32, uint32> VertToTriMap;
-		// Map of vertex to triangles to consider for normal calculation
-		TMultiMap<uint32, uint32> VertToTriSmoothMap;
-
-		// Normal/tangents for each face
-		TArray<FVector3f> FaceTangentX, FaceTangentY, FaceTangentZ;
-		FaceTangentX.AddUninitialized(NumTris);
-		FaceTangentY.AddUninitialized(NumTris);
-		FaceTangentZ.AddUninitialized(NumTris);
-
-		// Iterate over triangles
-		for (uint32 TriIdx = 0; TriIdx < NumTris; TriIdx++)
+		// Flatten to clamped indices so the parallel passes don't depend on the source index type
+		TArray<uint32> Indices;
+		Indices.SetNumUninitialized(NumIndices);
+		for (int32 Index = 0; Index < NumIndices; Index++)
 		{
-			uint32 CornerIndex[3];
-			FVector3f P[3];
-
-			for (int32 CornerIdx = 0; CornerIdx < 3; CornerIdx++)
-			{
-				// Find vert index (clamped within range)
-				uint32 VertIndex = FMath::Min(uint32(Triangles[(TriIdx * 3) + CornerIdx]), NumVertices - 1);
-
-				CornerIndex[CornerIdx] = VertIndex;
-				P[CornerIdx] = Vertices[VertIndex];
-
-				// Find/add this vert to index buffer
-				TArray<uint32> VertOverlaps;
-				DuplicateVertexMap.MultiFind(VertIndex, VertOverlaps);
-
-				// Remember which triangles map to this vert
-				VertToTriMap.AddUnique(VertIndex, TriIdx);
-				VertToTriSmoothMap.AddUnique(VertIndex, TriIdx);
-
-				// Also update map of triangles that 'overlap' this vert (ie don't match UV, but do match smoothing) and should be considered when calculating normal
-				for (int32 OverlapIdx = 0; OverlapIdx < VertOverlaps.Num(); OverlapIdx++)
-				{
-					// For each vert we overlap..
-					int32 OverlapVertIdx = VertOverlaps[OverlapIdx];
-
-					// Add this triangle to that vert
-					VertToTriSmoothMap.AddUnique(OverlapVertIdx, TriIdx);
-
-					// And add all of its triangles to us
-					TArray<uint32> OverlapTris;
-					VertToTriMap.MultiFind(OverlapVertIdx, OverlapTris);
-					for (int32 OverlapTriIdx = 0; OverlapTriIdx < OverlapTris.Num(); OverlapTriIdx++)
-					{
-						VertToTriSmoothMap.AddUnique(VertIndex, OverlapTris[OverlapTriIdx]);
-					}
-				}
-			}
-
-			// Calculate triangle edge vectors and normal
-			const FVector3f Edge21 = P[1] - P[2];
-			const FVector3f Edge20 = P[0] - P[2];
-			const FVector3f TriNormal = (Edge21 ^ Edge20).GetSafeNormal();
-
-			// If we have UVs, use those to calculate
-			if (UVGetter)
-			{
-				const FVector2f T1 = UVGetter(CornerIndex[0]);
-				const FVector2f T2 = UVGetter(CornerIndex[1]);
-				const FVector2f T3 = UVGetter(CornerIndex[2]);
-
-				// 			float X1 = P[1].X - P[0].X;
-				// 			float X2 = P[2].X - P[0].X;
-				// 			float Y1 = P[1].Y - P[0].Y;
-				// 			float Y2 = P[2].Y - P[0].Y;
-				// 			float Z1 = P[1].Z - P[0].Z;
-				// 			float Z2 = P[2].Z - P[0].Z;
-				// 
-				// 			float S1 = U1.X - U0.X;
-				// 			float S2 = U2.X - U0.X;
-				// 			float T1 = U1.Y - U0.Y;
-				// 			float T2 = U2.Y - U0.Y;
-				// 
-				// 			float R = 1.0f / (S1 * T2 - S2 * T1);
-				// 			FaceTangentX[TriIdx] = FVector((T2 * X1 - T1 * X2) * R, (T2 * Y1 - T1 * Y2) * R,
-				// 				(T2 * Z1 - T1 * Z2) * R);
-				// 			FaceTangentY[TriIdx] = FVector((S1 * X2 - S2 * X1) * R, (S1 * Y2 - S2 * Y1) * R,
-				// 				(S1 * Z2 - S2 * Z1) * R);
-
-
-				FMatrix44f ParameterToLocal(
-					FPlane4f(P[1].X - P[0].X, P[1].Y - P[0].Y, P[1].Z - P[0].Z, 0),
-					FPlane4f(P[2].X - P[0].X, P[2].Y - P[0].Y, P[2].Z - P[0].Z, 0),
-					FPlane4f(P[0].X, P[0].Y, P[0].Z, 0),
-					FPlane4f(0, 0, 0, 1)
-				);
-
-				FMatrix44f ParameterToTexture(
-					FPlane4f(T2.X - T1.X, T2.Y - T1.Y, 0, 0),
-					FPlane4f(T3.X - T1.X, T3.Y - T1.Y, 0, 0),
-					FPlane4f(T1.X, T1.Y, 1, 0),
-					FPlane4f(0, 0, 0, 1)
-				);
-
-				// Use InverseSlow to catch singular matrices.  Inverse can miss this sometimes.
-				const FMatrix44f TextureToLocal = ParameterToTexture.Inverse() * ParameterToLocal;
-
-				FaceTangentX[TriIdx] = TextureToLocal.TransformVector(FVector3f(1, 0, 0)).GetSafeNormal();
-				FaceTangentY[TriIdx] = TextureToLocal.TransformVector(FVector3f(0, 1, 0)).GetSafeNormal();
-			}
-			else
-			{
-				FaceTangentX[TriIdx] = Edge20.GetSafeNormal();
-				FaceTangentY[TriIdx] = (FaceTangentX[TriIdx] ^ TriNormal).GetSafeNormal();
-			}
-
-			FaceTangentZ[TriIdx] = TriNormal;
+			Indices[Index] = FMath::Min(uint32(Triangles[Index]), uint32(NumVertices - 1));
 		}
 
-
-		// Arrays to accumulate tangents into
-		TArray<FVector3f> VertexTangentXSum, VertexTangentYSum, VertexTangentZSum;
-		VertexTangentXSum.AddZeroed(NumVertices);
-		VertexTangentYSum.AddZeroed(NumVertices);
-		VertexTangentZSum.AddZeroed(NumVertices);
-
-		// For each vertex..
-		for (uint32 VertxIdx = 0; VertxIdx < NumVertices; VertxIdx++)
+		// Gather the UVs up front so the getter is only ever called from this thread
+		TArray<FVector2f> UVs;
+		if (UVGetter)
 		{
-			// Find relevant triangles for normal
-			TArray<uint32> SmoothTris;
-			VertToTriSmoothMap.MultiFind(VertxIdx, SmoothTris);
-
-			for (int i = 0; i < SmoothTris.Num(); i++)
+			UVs.SetNumUninitialized(NumVertices);
+			for (int32 Index = 0; Index < NumVertices; Index++)
 			{
-				uint32 TriIdx = SmoothTris[i];
-				VertexTangentZSum[VertxIdx] += FaceTangentZ[TriIdx];
-			}
-
-			// Find relevant triangles for tangents
-			TArray<uint32> TangentTris;
-			VertToTriMap.MultiFind(VertxIdx, TangentTris);
-
-			for (int i = 0; i < TangentTris.Num(); i++)
-			{
-				uint32 TriIdx = TangentTris[i];
-				VertexTangentXSum[VertxIdx] += FaceTangentX[TriIdx];
-				VertexTangentYSum[VertxIdx] += FaceTangentY[TriIdx];
+				UVs[Index] = UVGetter(Index);
 			}
 		}
 
-		// Finally, normalize tangents and build output arrays	
-		for (uint32 VertxIdx = 0; VertxIdx < NumVertices; VertxIdx++)
-		{
-			FVector3f& TangentX = VertexTangentXSum[VertxIdx];
-			FVector3f& TangentY = VertexTangentYSum[VertxIdx];
-			FVector3f& TangentZ = VertexTangentZSum[VertxIdx];
-
-			TangentX.Normalize();
-			//TangentY.Normalize();
-			TangentZ.Normalize();
+		TArray<FVector3f> TangentX, TangentY, TangentZ;
+		Private::ComputeVertexTangents(Indices, Vertices, UVs, bComputeSmoothNormals, TangentX, TangentY, TangentZ);
 
-			// Use Gram-Schmidt orthogonalization to make sure X is orthonormal with Z
-			TangentX -= TangentZ * (TangentZ | TangentX);
-			TangentX.Normalize();
-			TangentY.Normalize();
-
-			TangentsSetter(VertxIdx, TangentX, TangentZ);
+		for (int32 Index = 0; Index < NumVertices; Index++)
+		{
+			TangentsSetter(Index, TangentX[Index], TangentZ[Index]);
 		}
 	}
 
@@ -7,6 +7,7 @@
 #include "RealtimeMeshDataStream.h"
 #include "Templates/Invoke.h"
 #include "Traits/IsVoidType.h"
+#include "Traits/IsContiguousContainer.h"
 
 #if RMC_ENGINE_ABOVE_5_4
 #include "Templates/ChooseClass.h"
@@ -967,19 +968,6 @@ namespace RealtimeMesh
 			}
 		}
 
-		template <typename U = AccessType>
-		FORCEINLINE TEnableIfWritable<void, U> Append(TArrayView<AccessType> Elements)
-		{
-			const SizeType StartIndex = AddUninitialized(Elements.Num());
-			SetRange(StartIndex, Elements);
-		}
-
-		template <typename InAllocatorType>
-		FORCEINLINE TEnableIfWritable<void, InAllocatorType> Append(const TArray<AccessType, InAllocatorType>& Elements)
-		{
-			Append(MakeArrayView(Elements));
-		}
-
 		template <typename U = AccessType>
 		FORCEINLINE TEnableIfWritable<void, U> Append(AccessType* Elements, int32 Count)
 		{
@@ -1002,10 +990,89 @@ namespace RealtimeMesh
 			}
 		}
 
+		/**
+		 * Appends a run of values converting them to the stream format in bulk.
+		 * When the stream is tightly packed the values are converted straight into the stream memory,
+		 * using the vectorized kernels from TRealtimeMeshBulkConverter where available.
+		 * @param Elements Any contiguous range (TArray, TArrayView, ...) of values in the access type or the buffer type of this builder
+		 */
+		template <typename RangeType, typename U = AccessType>
+		TEnableIfWritable<std::enable_if_t<TIsContiguousContainer<std::decay_t<RangeType>>::Value>, U> Append(RangeType&& Elements)
+		{
+			const int32 Count = static_cast<int32>(::GetNum(Elements));
+			if (Count > 0)
+			{
+				const SizeType StartIndex = AddUninitialized<U>(Count);
+				WriteConverted(StartIndex, ::GetData(Elements), Count);
+			}
+		}
+
+		/**
+		 * Appends Source[Indices[0]], Source[Indices[1]], ... converting them to the stream format in bulk.
+		 * Useful for expanding indexed vertex data into per-corner streams without building intermediate arrays.
+		 * @param Source Contiguous range of values to gather from, either in the access type or the buffer type of this builder
+		 * @param Indices Contiguous range of indices into Source, in the order they should be appended
+		 */
+		template <typename SourceRangeType, typename IndexRangeType, typename U = AccessType>
+		TEnableIfWritable<std::enable_if_t<TIsContiguousContainer<std::decay_t<SourceRangeType>>::Value &&
+			TIsContiguousContainer<std::decay_t<IndexRangeType>>::Value>, U> AppendIndexed(SourceRangeType&& Source, IndexRangeType&& Indices)
+		{
+			using SourceType = std::remove_cv_t<std::remove_pointer_t<decltype(::GetData(Source))>>;
+
+			const auto* SourceData = ::GetData(Source);
+			const int64 NumSource = static_cast<int64>(::GetNum(Source));
+			const auto* IndexData = ::GetData(Indices);
+			const int32 NumIndices = static_cast<int32>(::GetNum(Indices));
+			if (NumIndices == 0)
+			{
+				return;
+			}
+			
+			const SizeType StartIndex = AddUninitialized<U>(NumIndices);
+
+			// Gather in small chunks so the conversion still runs over contiguous memory
+			constexpr int32 ChunkSize = 64;
+			TArray<SourceType, TInlineAllocator<ChunkSize>> Gathered;
+			Gathered.SetNumUninitialized(ChunkSize);
+			
+			for (int32 ChunkStart = 0; ChunkStart < NumIndices; ChunkStart += ChunkSize)
+			{
+				const int32 Count = FMath::Min(ChunkSize, NumIndices - ChunkStart);
+				for (int32 Index = 0; Index < Count; Index++)
+				{
+					const int64 SourceIndex = static_cast<int64>(IndexData[ChunkStart + Index]);
+					checkf(SourceIndex >= 0 && SourceIndex < NumSource, TEXT("Gather index out of bounds: %lld from a source of size %lld"), SourceIndex, NumSource);
+					Gathered[Index] = SourceData[SourceIndex];
+				}
+				WriteConverted(StartIndex + ChunkStart, Gathered.GetData(), Count);
+			}
+		}
 		
 
 
 	protected:
+		template <typename SourceType>
+		void WriteConverted(SizeType StartIndex, const SourceType* Source, int32 Count)
+		{
+			RangeCheck(StartIndex + Count - 1);
+			
+			if constexpr (!std::is_void_v<BufferType> && (std::is_same_v<SourceType, AccessType> || std::is_same_v<SourceType, BufferType>))
+			{
+				// Tightly packed stream, we can convert straight into the stream memory
+				if (Context.Stream.GetStride() == sizeof(BufferType))
+				{
+					BufferType* Destination = reinterpret_cast<BufferType*>(Context.Stream.GetDataRawAtVertex(StartIndex));
+					TRealtimeMeshBulkConverter<SourceType, BufferType>::Convert(Source, Destination, Count);
+					return;
+				}
+			}
+
+			for (int32 Index = 0; Index < Count; Index++)
+			{
+				StreamDataAccessor::SetBufferValue(Context, StartIndex + Index, ConvertRealtimeMeshType<SourceType, AccessType>(Source[Index]));
+			}
+		}
+		
 		static FORCEINLINE void ElementCheck(int32 ElementIndex)
 		{
 			checkf((ElementIndex >= 0) & (ElementIndex < NumElements), TEXT("Element index out of bounds: %d from an element list of size %d"), ElementIndex,
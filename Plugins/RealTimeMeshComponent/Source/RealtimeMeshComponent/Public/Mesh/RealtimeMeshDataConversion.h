@@ -129,5 +129,89 @@ namespace RealtimeMesh
 	template<> FORCEINLINE_DEBUGGABLE FPackedRGBA16N ConvertRealtimeMeshType<FPackedNormal, FPackedRGBA16N>(const FPackedNormal& Source) { return FPackedRGBA16N(Source.ToFVector4f()); }
 
 
+	namespace Internal
+	{
+		/** Narrows a flat run of doubles to floats, four lanes at a time. */
+		FORCEINLINE void ConvertDoublesToFloats(const double* RESTRICT Source, float* RESTRICT Destination, int32 Count)
+		{
+			int32 Index = 0;
+			for (; Index + 4 <= Count; Index += 4)
+			{
+				VectorStore(MakeVectorRegisterFloatFromDouble(VectorLoad(Source + Index)), Destination + Index);
+			}
+			for (; Index < Count; Index++)
+			{
+				Destination[Index] = static_cast<float>(Source[Index]);
+			}
+		}
+
+		/** Packs a flat run of floats to halves, four lanes at a time. */
+		FORCEINLINE void ConvertFloatsToHalves(const float* RESTRICT Source, uint16* RESTRICT Destination, int32 Count)
+		{
+			int32 Index = 0;
+			for (; Index + 4 <= Count; Index += 4)
+			{
+				FPlatformMath::VectorStoreHalf(Destination + Index, Source + Index);
+			}
+			for (; Index < Count; Index++)
+			{
+				FPlatformMath::StoreHalf(Destination + Index, Source[Index]);
+			}
+		}
+	}
+
+	/**
+	 * Converts a contiguous run of elements from one type to another.
+	 * The generic version falls back to ConvertRealtimeMeshType per element, the specializations below
+	 * cover the common double->float and float->half narrowing cases with vectorized kernels.
+	 */
+	template<typename SourceType, typename DestinationType>
+	struct TRealtimeMeshBulkConverter
+	{
+		static void Convert(const SourceType* RESTRICT Source, DestinationType* RESTRICT Destination, int32 Count)
+		{
+			if constexpr (std::is_same_v<SourceType, DestinationType>)
+			{
+				FMemory::Memcpy(Destination, Source, Count * sizeof(SourceType));
+			}
+			else
+			{
+				for (int32 Index = 0; Index < Count; Index++)
+				{
+					Destination[Index] = ConvertRealtimeMeshType<SourceType, DestinationType>(Source[Index]);
+				}
+			}
+		}
+	};
+
+	template<>
+	struct TRealtimeMeshBulkConverter<FVector3d, FVector3f>
+	{
+		static void Convert(const FVector3d* RESTRICT Source, FVector3f* RESTRICT Destination, int32 Count)
+		{
+			static_assert(sizeof(FVector3d) == sizeof(double) * 3 && sizeof(FVector3f) == sizeof(float) * 3);
+			Internal::ConvertDoublesToFloats(reinterpret_cast<const double*>(Source), reinterpret_cast<float*>(Destination), Count * 3);
+		}
+	};
+
+	template<>
+	struct TRealtimeMeshBulkConverter<FVector2d, FVector2f>
+	{
+		static void Convert(const FVector2d* RESTRICT Source, FVector2f* RESTRICT Destination, int32 Count)
+		{
+			static_assert(sizeof(FVector2d) == sizeof(double) * 2 && sizeof(FVector2f) == sizeof(float) * 2);
+			Internal::ConvertDoublesToFloats(reinterpret_cast<const double*>(Source), reinterpret_cast<float*>(Destination), Count * 2);
+		}
+	};
+
+	template<>
+	struct TRealtimeMeshBulkConverter<FVector2f, FVector2DHalf>
+	{
+		static void Convert(const FVector2f* RESTRICT Source, FVector2DHalf* RESTRICT Destination, int32 Count)
+		{
+			static_assert(sizeof(FVector2f) == sizeof(float) * 2 && sizeof(FVector2DHalf) == sizeof(uint16) * 2);
+			Internal::ConvertFloatsToHalves(reinterpret_cast<const float*>(Source), reinterpret_cast<uint16*>(Destination), Count * 2);
+		}
+	};
 	
 }
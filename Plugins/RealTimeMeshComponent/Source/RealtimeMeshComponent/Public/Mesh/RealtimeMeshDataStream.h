@@ -303,6 +303,7 @@ namespace RealtimeMesh
 			CacheStrides();
 			
 			ArrayNum = Other.ArrayNum;
+			ArrayMax = Other.ArrayMax;
 			Allocator.MoveToEmpty(Other.Allocator);
 
 			Other.ArrayNum = 0;
@@ -1353,6 +1354,30 @@ namespace RealtimeMesh
 			return Streams.Remove(StreamKey);
 		}
 
+		/** Removes the stream from the set and hands ownership of it to the caller */
+		TUniquePtr<FRealtimeMeshStream> Extract(const FRealtimeMeshStreamKey& StreamKey)
+		{
+			TUniquePtr<FRealtimeMeshStream> Stream;
+			if (Streams.RemoveAndCopyValue(StreamKey, Stream) && Stream->IsLinked())
+			{
+				Stream->UnLink();
+				CleanUpLinkages();
+			}
+			return Stream;
+		}
+
+		/** Moves every stream out to the caller, leaving the set empty */
+		void ExtractAll(TArray<TUniquePtr<FRealtimeMeshStream>>& OutStreams)
+		{
+			OutStreams.Reserve(OutStreams.Num() + Streams.Num());
+			for (auto SetIt = Streams.CreateIterator(); SetIt; ++SetIt)
+			{
+				SetIt->Value->UnLink();
+				OutStreams.Add(MoveTemp(SetIt->Value));
+			}
+			Empty();
+		}
+
 		int32 RemoveAll(const TSet<FRealtimeMeshStreamKey>& StreamKeys)
 		{
 			int32 RemovedCount = 0;
@@ -1423,6 +1448,16 @@ namespace RealtimeMesh
 			return Streams.Contains(StreamKey);
 		}
 
+		SIZE_T GetAllocatedSize() const
+		{
+			SIZE_T Size = 0;
+			for (auto SetIt = Streams.CreateConstIterator(); SetIt; ++SetIt)
+			{
+				Size += SetIt->Value->GetAllocatedSize();
+			}
+			return Size;
+		}
+
 		TSet<FRealtimeMeshStreamKey> GetStreamKeys() const
 		{
 			TSet<FRealtimeMeshStreamKey> Keys;
@@ -1491,6 +1526,14 @@ namespace RealtimeMesh
 			return *Entry.Get();
 		}
 
+		FRealtimeMeshStream& AddStream(TUniquePtr<FRealtimeMeshStream>&& Stream)
+		{
+			check(Stream.IsValid());
+			auto& Entry = Streams.FindOrAdd(Stream->GetStreamKey());
+			Entry = MoveTemp(Stream);
+			return *Entry.Get();
+		}
+
 
 		void ForEach(const TFunctionRef<void(FRealtimeMeshStream&)>& Func)
 		{
@@ -0,0 +1,59 @@
+﻿// Copyright TriAxis Games, L.L.C. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Mesh/RealtimeMeshDataStream.h"
+
+namespace RealtimeMesh
+{
+	/**
+	 * Keeps emptied streams around, bucketed by layout, so rebuilding a mesh can reuse their allocations instead of
+	 * going back to the heap for every stream. Streams handed back are reset to zero rows but keep their capacity, up
+	 * to the pool's byte budget. Safe to use from any thread.
+	 */
+	class REALTIMEMESHCOMPONENT_API FRealtimeMeshStreamPool
+	{
+	private:
+		TMap<FRealtimeMeshBufferLayout, TArray<TUniquePtr<FRealtimeMeshStream>>> FreeStreams;
+		mutable FCriticalSection Lock;
+		int64 PooledBytes;
+		int32 NumPooledStreams;
+		int64 MaxPooledBytes;
+
+	public:
+		/** A negative budget follows the r.RealtimeMesh.StreamPool.MaxMB console variable */
+		explicit FRealtimeMeshStreamPool(int64 InMaxPooledBytes = -1);
+		~FRealtimeMeshStreamPool();
+		UE_NONCOPYABLE(FRealtimeMeshStreamPool);
+
+		/** Pool shared by everything that doesn't bring its own */
+		static FRealtimeMeshStreamPool& Get();
+
+		/**
+		 * Gets an empty stream with the given key and layout, reusing a pooled allocation when there is one.
+		 * The smallest pooled stream holding at least MinCapacity rows is preferred, otherwise the result is grown to it.
+		 */
+		TUniquePtr<FRealtimeMeshStream> Acquire(const FRealtimeMeshStreamKey& StreamKey, const FRealtimeMeshBufferLayout& Layout, int32 MinCapacity = 0);
+
+		/** Acquires a stream into the set, any stream already there under the same key is released first */
+		FRealtimeMeshStream& AddStream(FRealtimeMeshStreamSet& StreamSet, const FRealtimeMeshStreamKey& StreamKey, const FRealtimeMeshBufferLayout& Layout, int32 MinCapacity = 0);
+
+		/** Resets the stream and keeps its allocation for reuse, or frees it if that would go over budget */
+		void Release(TUniquePtr<FRealtimeMeshStream>&& Stream);
+
+		/** Releases every stream in the set, leaving it empty */
+		void Release(FRealtimeMeshStreamSet& StreamSet);
+
+		/** Frees pooled streams, largest first, until at most MaxBytes are held */
+		void Trim(int64 MaxBytes);
+		void Empty() { Trim(0); }
+
+		int64 GetPooledBytes() const;
+		int32 GetNumPooledStreams() const;
+
+	private:
+		int64 GetMaxPooledBytes() const;
+		void UpdateStats(int64 DeltaBytes, int32 DeltaStreams);
+	};
+}
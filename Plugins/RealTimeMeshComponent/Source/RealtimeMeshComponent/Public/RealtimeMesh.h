@@ -5,6 +5,7 @@
 #include "RealtimeMeshCore.h"
 #include "Data/RealtimeMeshData.h"
 #include "RealtimeMeshCollision.h"
+#include "RealtimeMeshMemoryStats.h"
 #include "Interfaces/Interface_CollisionDataProvider.h"
 #if RMC_ENGINE_ABOVE_5_2
 #include "Tickable.h"
@@ -75,6 +76,9 @@ protected:
 	/* Currently applied collision version, used for ignoring old cooks in async */
 	int32 CurrentCollisionVersion;
 
+	/* Size of the current body setup as last reported to the memory counters */
+	int64 TrackedCollisionBytes;
+
 public:
 	/**
 	 * @brief GetMesh returns the FRealtimeMesh data container.
@@ -103,6 +107,16 @@ public:
 	 */
 	UBodySetup* GetBodySetup() const { return BodySetup; }
 
+	/**
+	 * Gets the memory held by this mesh's streams, GPU buffers and collision.
+	 * RealtimeMesh.DumpMemory lists the largest consumers across all meshes.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Components|RealtimeMesh")
+	FRealtimeMeshMemoryUsage GetMemoryUsage();
+
+	/** Re-measures the body setup, cooked data created lazily after the collision update is only picked up here */
+	void UpdateCollisionMemoryUsage();
+
 	/**
 	 * Reset the RealtimeMesh.
 	 *
@@ -261,6 +275,7 @@ protected: // Collision
 	void InitiateCollisionUpdate(const TSharedRef<TPromise<ERealtimeMeshCollisionUpdateResult>>& Promise, const TSharedRef<FRealtimeMeshCollisionData>& CollisionUpdate,
 	                             bool bForceSyncUpdate);
 	void FinishPhysicsAsyncCook(bool bSuccess, TSharedRef<struct FRealtimeMeshCookAutoPromiseOnDestruction> Promise, UBodySetup* FinishedBodySetup, int32 UpdateKey);
+	void ApplyPhysicsAsyncCook(bool bSuccess, TSharedRef<struct FRealtimeMeshCookAutoPromiseOnDestruction> Promise, UBodySetup* FinishedBodySetup, int32 UpdateKey);
 
 	
 	friend struct FRealtimeMeshEndOfFrameUpdateManager;
@@ -0,0 +1,84 @@
+﻿// Copyright TriAxis Games, L.L.C. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RealtimeMeshCollision.h"
+#include "Async/Future.h"
+#include "Containers/Ticker.h"
+#include <atomic>
+
+namespace RealtimeMesh
+{
+	using FRealtimeMeshCollisionPromise = TSharedRef<TPromise<ERealtimeMeshCollisionUpdateResult>>;
+
+	/**
+	 *	Schedules the async side of complex collision updates across every realtime mesh, instead of each mesh
+	 *	kicking its own work the moment it's dirtied.
+	 *
+	 *	- Collision mesh generation is queued per mesh and sent to the realtime mesh thread pool in batches once a frame.
+	 *	  A mesh that's dirtied again before its generation starts replaces the queued one, and the callers of both
+	 *	  get the result of the newer one.
+	 *	- Physics cooks are capped to a number in flight, a queued cook that gets replaced before it starts is dropped.
+	 *	- Finished cooks are applied to their mesh within a per frame budget, since that's what triggers the physics
+	 *	  state recreation on the components.
+	 *
+	 *	Budgets come from the r.RealtimeMesh.Collision.* console variables. Everything here is game thread only.
+	 */
+	class REALTIMEMESHCOMPONENT_API FRealtimeMeshCollisionCookScheduler
+	{
+	public:
+		FRealtimeMeshCollisionCookScheduler();
+		~FRealtimeMeshCollisionCookScheduler();
+
+		static FRealtimeMeshCollisionCookScheduler& Get();
+
+		/**
+		 *	Queues collision generation for Owner. Generate runs on a worker and returns the future of the finished update,
+		 *	ResultPromise is fulfilled with it. Owner is only used as a key and never dereferenced.
+		 */
+		void QueueGeneration(const void* Owner, const FRealtimeMeshCollisionPromise& ResultPromise,
+		                     TUniqueFunction<TFuture<ERealtimeMeshCollisionUpdateResult>()>&& Generate);
+
+		/**
+		 *	Queues the start of a physics cook for Owner, replacing any queued cook for it that hasn't started yet.
+		 *	StartCook must call ReleaseCookSlot once the cook is finished or aborted.
+		 */
+		void QueueCook(const void* Owner, TUniqueFunction<void()>&& StartCook);
+
+		/** Frees the in flight slot taken by a cook started through QueueCook, safe from any thread */
+		void ReleaseCookSlot();
+
+		/** Queues applying a finished cook, run within the per frame completion budget */
+		void QueueCompletion(TUniqueFunction<void()>&& Complete);
+
+		int32 NumQueuedGenerations() const { return PendingGenerations.Num(); }
+		int32 NumQueuedCooks() const { return PendingCooks.Num(); }
+		int32 NumCooksInFlight() const { return CooksInFlight.load(); }
+		int32 NumQueuedCompletions() const { return PendingCompletions.Num(); }
+
+	private:
+		struct FPendingGeneration
+		{
+			TArray<FRealtimeMeshCollisionPromise> ResultPromises;
+			TUniqueFunction<TFuture<ERealtimeMeshCollisionUpdateResult>()> Generate;
+		};
+
+		TMap<const void*, FPendingGeneration> PendingGenerations;
+
+		/* Cooks waiting on a slot, in the order they were first queued */
+		TArray<const void*> PendingCookOrder;
+		TMap<const void*, TUniqueFunction<void()>> PendingCooks;
+		std::atomic<int32> CooksInFlight;
+		bool bStartingCooks;
+
+		TArray<TUniqueFunction<void()>> PendingCompletions;
+
+		FTSTicker::FDelegateHandle TickHandle;
+
+		bool Tick(float DeltaTime);
+		void DispatchGenerations();
+		void StartCooks();
+		void RunCompletions();
+	};
+}
@@ -160,6 +160,7 @@ enum class ERealtimeMeshBatchCreationFlags : uint8
 	None = 0,
 	ForceAllDynamic = 0x1,
 	SkipStaticRayTracedSections = 0x2,
+	MergeCompatibleSections = 0x4,
 };
 ENUM_CLASS_FLAGS(ERealtimeMeshBatchCreationFlags);
 
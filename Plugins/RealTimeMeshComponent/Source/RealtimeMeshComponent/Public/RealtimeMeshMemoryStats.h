@@ -0,0 +1,95 @@
+﻿// Copyright TriAxis Games, L.L.C. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+#include <atomic>
+#include "RealtimeMeshMemoryStats.generated.h"
+
+LLM_DECLARE_TAG_API(RealtimeMesh, REALTIMEMESHCOMPONENT_API);
+
+/** Bytes held by a realtime mesh, or by all of them */
+USTRUCT(BlueprintType)
+struct REALTIMEMESHCOMPONENT_API FRealtimeMeshMemoryUsage
+{
+	GENERATED_BODY()
+
+public:
+	/** Stream data kept on the game thread */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="RealtimeMesh|Memory")
+	int64 CPUStreamBytes = 0;
+
+	/** Vertex and index buffers held by the render proxy */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="RealtimeMesh|Memory")
+	int64 GPUBufferBytes = 0;
+
+	/** Simple and cooked complex collision of the current body setup */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="RealtimeMesh|Memory")
+	int64 CollisionBytes = 0;
+
+	int64 GetTotalBytes() const { return CPUStreamBytes + GPUBufferBytes + CollisionBytes; }
+
+	FRealtimeMeshMemoryUsage& operator+=(const FRealtimeMeshMemoryUsage& Other)
+	{
+		CPUStreamBytes += Other.CPUStreamBytes;
+		GPUBufferBytes += Other.GPUBufferBytes;
+		CollisionBytes += Other.CollisionBytes;
+		return *this;
+	}
+};
+
+namespace RealtimeMesh
+{
+	enum class ERealtimeMeshMemoryCategory : uint8
+	{
+		CPUStreams,
+		GPUBuffers,
+		Collision,
+		Num,
+	};
+
+	/**
+	 * Byte counters for a single mesh. These live in the mesh's shared resources so both the game thread data and the
+	 * render proxy can report into them, every change is forwarded to the global totals and the RealtimeMesh memory stats.
+	 */
+	class REALTIMEMESHCOMPONENT_API FRealtimeMeshMemoryCounters
+	{
+	private:
+		std::atomic<int64> Bytes[static_cast<int32>(ERealtimeMeshMemoryCategory::Num)];
+		FString OwnerName;
+
+	public:
+		FRealtimeMeshMemoryCounters();
+		~FRealtimeMeshMemoryCounters();
+		UE_NONCOPYABLE(FRealtimeMeshMemoryCounters);
+
+		void SetOwnerName(const FString& InOwnerName);
+		FString GetOwnerName() const;
+
+		int64 GetBytes(ERealtimeMeshMemoryCategory Category) const { return Bytes[static_cast<int32>(Category)].load(std::memory_order_relaxed); }
+		FRealtimeMeshMemoryUsage GetUsage() const;
+
+		/** Adds a possibly negative number of bytes to this mesh and to the global totals */
+		void AddBytes(ERealtimeMeshMemoryCategory Category, int64 Delta);
+
+		/** Replaces a previously reported measurement with a new one, TrackedBytes holds what the caller last reported */
+		void UpdateBytes(ERealtimeMeshMemoryCategory Category, int64& TrackedBytes, int64 NewBytes)
+		{
+			AddBytes(Category, NewBytes - TrackedBytes);
+			TrackedBytes = NewBytes;
+		}
+	};
+
+	struct REALTIMEMESHCOMPONENT_API FRealtimeMeshMemoryTracker
+	{
+		static FRealtimeMeshMemoryUsage GetGlobalUsage();
+		static int32 GetNumTrackedMeshes();
+
+		/** Usage of the live meshes holding the most memory, largest first */
+		static TArray<TPair<FString, FRealtimeMeshMemoryUsage>> GetTopConsumers(int32 MaxCount);
+
+		/** Logs the global totals and the top consumers, backs the RealtimeMesh.DumpMemory console command */
+		static void DumpTopConsumers(FOutputDevice& Ar, int32 MaxCount = 20);
+	};
+}
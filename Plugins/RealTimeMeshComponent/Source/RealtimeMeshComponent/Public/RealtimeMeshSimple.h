@@ -113,6 +113,7 @@ namespace RealtimeMesh
 	{		
 		FRealtimeMeshStreamSet Streams;
 		FRealtimeMeshPolyGroupConfigHandler ConfigHandler;		
+		int64 TrackedStreamBytes;
 		uint8 bAutoCreateSectionsForPolygonGroups : 1;
 		uint8 bIsStandalone : 1;
 
@@ -120,10 +121,12 @@ namespace RealtimeMesh
 	public:
 		FRealtimeMeshSectionGroupSimple(const FRealtimeMeshSharedResourcesRef& InSharedResources, const FRealtimeMeshSectionGroupKey& InKey)
 			: FRealtimeMeshSectionGroup(InSharedResources, InKey)
+			, TrackedStreamBytes(0)
 			, bAutoCreateSectionsForPolygonGroups(true)
 			, bIsStandalone(false)
 		{
 		}
+		virtual ~FRealtimeMeshSectionGroupSimple() override;
 
 		void FlagStandalone() { bIsStandalone = true; }
 		bool IsStandalone() const { return bIsStandalone; }
@@ -143,6 +146,20 @@ namespace RealtimeMesh
 		virtual void CreateOrUpdateStream(FRealtimeMeshProxyCommandBatch& Commands, FRealtimeMeshStream&& Stream) override;
 		virtual void RemoveStream(FRealtimeMeshProxyCommandBatch& Commands, const FRealtimeMeshStreamKey& StreamKey) override;
 
+		/**
+		 * Replaces rows [FirstElement, FirstElement + Data.Num()) of an existing stream.
+		 * Ranges inside the current stream are written into the existing GPU buffer, ranges past the end grow the stream and re-upload it.
+		 */
+		TFuture<ERealtimeMeshProxyUpdateStatus> UpdateStreamRange(int32 FirstElement, FRealtimeMeshStream&& Data);
+		virtual void UpdateStreamRange(FRealtimeMeshProxyCommandBatch& Commands, int32 FirstElement, FRealtimeMeshStream&& Data);
+
+		/**
+		 * Replaces the contents of all streams, writing into the existing GPU buffers when the new streams match the current ones in
+		 * keys, layouts and sizes. Otherwise this behaves like SetAllStreams.
+		 */
+		TFuture<ERealtimeMeshProxyUpdateStatus> UpdateStreamsInPlace(FRealtimeMeshStreamSet&& InStreams);
+		virtual void UpdateStreamsInPlace(FRealtimeMeshProxyCommandBatch& Commands, FRealtimeMeshStreamSet&& InStreams);
+
 		using FRealtimeMeshSectionGroup::SetAllStreams;
 		virtual void SetAllStreams(FRealtimeMeshProxyCommandBatch& Commands, FRealtimeMeshStreamSet&& InStreams) override;
 
@@ -164,6 +181,8 @@ namespace RealtimeMesh
 
 		virtual void UpdatePolyGroupSections(FRealtimeMeshProxyCommandBatch& Commands, bool bUpdateDepthOnly);
 		virtual FRealtimeMeshSectionConfig DefaultPolyGroupSectionHandler(int32 PolyGroupIndex) const;
+
+		void UpdateMemoryStats();
 	};
 
 	class REALTIMEMESHCOMPONENT_API FRealtimeMeshLODSimple : public FRealtimeMeshLODData
@@ -301,6 +320,11 @@ public:
 	
 	TFuture<ERealtimeMeshProxyUpdateStatus> UpdateSectionGroup(const FRealtimeMeshSectionGroupKey& SectionGroupKey, FRealtimeMeshStreamSet&& MeshData);
 	TFuture<ERealtimeMeshProxyUpdateStatus> UpdateSectionGroup(const FRealtimeMeshSectionGroupKey& SectionGroupKey, const FRealtimeMeshStreamSet& MeshData);
+
+	/* Replaces rows [FirstElement, FirstElement + Data.Num()) of one stream without reallocating its GPU buffer */
+	TFuture<ERealtimeMeshProxyUpdateStatus> UpdateSectionGroupStreamRange(const FRealtimeMeshSectionGroupKey& SectionGroupKey, int32 FirstElement, FRealtimeMeshStream&& Data);
+	/* Like UpdateSectionGroup, but writes into the existing GPU buffers when the stream layouts and sizes are unchanged */
+	TFuture<ERealtimeMeshProxyUpdateStatus> UpdateSectionGroupInPlace(const FRealtimeMeshSectionGroupKey& SectionGroupKey, FRealtimeMeshStreamSet&& MeshData);
 	
 	// DEPRECATE
 	PRAGMA_DISABLE_DEPRECATION_WARNINGS
@@ -415,6 +439,18 @@ public:
 
 	TFuture<ERealtimeMeshProxyUpdateStatus> RemoveSectionGroup(const FRealtimeMeshSectionGroupKey& SectionGroupKey);
 
+	UFUNCTION(BlueprintCallable, Category = "Components|RealtimeMesh")
+	bool IsMergingCompatibleSections() const;
+
+	/**
+	 * Submits sections of a section group that share a material and draw mask as one batch, with sections laid out back to back
+	 * in the group's buffers drawn as a single element. Useful for meshes made of many small sections.
+	 */
+	TFuture<ERealtimeMeshProxyUpdateStatus> SetMergeCompatibleSections(bool bMergeCompatibleSections);
+
+	UFUNCTION(BlueprintCallable, Category = "Components|RealtimeMesh", DisplayName="SetMergeCompatibleSections", meta = (AutoCreateRefTerm = "CompletionCallback"))
+	void SetMergeCompatibleSections(bool bMergeCompatibleSections, const FRealtimeMeshSimpleCompletionCallback& CompletionCallback);
+
 
 	const FRealtimeMeshDistanceField& GetDistanceField() const;
 	
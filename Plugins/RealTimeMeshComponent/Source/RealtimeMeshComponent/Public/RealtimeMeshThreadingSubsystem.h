@@ -8,7 +8,76 @@
 #include "RealtimeMeshThreadingSubsystem.generated.h"
 
 /**
- * 
+ *	Priority lanes for work queued on the realtime mesh thread pool.
+ *	Workers always pick up queued interactive work before streaming work, and streaming work before background work.
+ */
+UENUM()
+enum class ERealtimeMeshTaskPriority : uint8
+{
+	/* Work something on screen is waiting for right now, like a chunk that is about to become visible */
+	Interactive,
+	/* Regular streaming work, new chunks, collision cooks, etc */
+	Streaming,
+	/* Work nothing is waiting on, compression, distance fields, precomputation */
+	Background,
+
+	Num UMETA(Hidden)
+};
+
+namespace RealtimeMesh
+{
+	struct FRealtimeMeshTaskState;
+
+	/**
+	 *	Handle to a task launched through URealtimeMeshThreadingSubsystem::LaunchTask.
+	 *	Copies share the same task, the task itself doesn't depend on any handle staying alive.
+	 */
+	class REALTIMEMESHCOMPONENT_API FRealtimeMeshTaskHandle
+	{
+	public:
+		FRealtimeMeshTaskHandle() = default;
+		explicit FRealtimeMeshTaskHandle(const TSharedRef<FRealtimeMeshTaskState, ESPMode::ThreadSafe>& InState)
+			: State(InState) { }
+
+		bool IsValid() const { return State.IsValid(); }
+
+		/* True once the task has either run to completion or been cancelled */
+		bool IsDone() const;
+
+		/* True if the task was cancelled before it started, its work will never run */
+		bool IsCancelled() const;
+
+		/*
+		 * Cancels the task if it hasn't started yet. Returns true if it was cancelled, in which case the cancellation
+		 * callback has been or will be called instead of the work. A task that already started always runs to completion.
+		 */
+		bool Cancel() const;
+		
+	private:
+		TSharedPtr<FRealtimeMeshTaskState, ESPMode::ThreadSafe> State;
+	};
+
+	/**
+	 *	Counters for one priority lane, all updated lock free from the workers.
+	 */
+	struct FRealtimeMeshTaskLaneStats
+	{
+		/* Tasks queued but not picked up by a worker yet */
+		int32 QueueDepth = 0;
+		/* Tasks that have run to completion */
+		int64 NumCompleted = 0;
+		/* Tasks that were cancelled before they started */
+		int64 NumCancelled = 0;
+		/* Average and worst time tasks have spent in the queue before a worker picked them up */
+		double AverageLatencySeconds = 0.0;
+		double MaxLatencySeconds = 0.0;
+	};
+}
+
+/**
+ *	Owns the thread pool the realtime mesh uses for async work.
+ *	Worker count and thread priority come from the r.RealtimeMesh.ThreadPool.* console variables or SetThreadPoolConfig,
+ *	both only take effect if set before the pool is first used.
  */
 UCLASS()
 class REALTIMEMESHCOMPONENT_API URealtimeMeshThreadingSubsystem : public UEngineSubsystem
@@ -16,6 +85,10 @@ class REALTIMEMESHCOMPONENT_API URealtimeMeshThreadingSubsystem : public UEngine
 	GENERATED_BODY()
 private:
 	TUniquePtr<FQueuedThreadPool> ThreadPool;
+	FCriticalSection ThreadPoolLock;
+
+	TOptional<int32> ConfiguredNumThreads;
+	TOptional<EThreadPriority> ConfiguredThreadPriority;
 public:
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 	virtual void Deinitialize() override;
@@ -23,4 +96,22 @@ public:
 	static URealtimeMeshThreadingSubsystem* Get();
 
 	FQueuedThreadPool& GetThreadPool();
+
+	/**
+	 *	Overrides the console variable configuration of the pool. Returns false if the pool is already running,
+	 *	in which case nothing changes.
+	 */
+	bool SetThreadPoolConfig(int32 NumThreads, EThreadPriority ThreadPriority);
+
+	/**
+	 *	Queues work on the pool in the given priority lane.
+	 *	OnCancelled runs instead of Work if the task is cancelled before it starts, or if the pool shuts down first.
+	 */
+	RealtimeMesh::FRealtimeMeshTaskHandle LaunchTask(ERealtimeMeshTaskPriority Priority, TUniqueFunction<void()>&& Work,
+		TUniqueFunction<void()>&& OnCancelled = nullptr);
+
+	/**
+	 *	Snapshot of the counters for one priority lane.
+	 */
+	static RealtimeMesh::FRealtimeMeshTaskLaneStats GetLaneStats(ERealtimeMeshTaskPriority Priority);
 };
@@ -5,6 +5,7 @@
 #include "Mesh/RealtimeMeshDataTypes.h"
 #include "Containers/ResourceArray.h"
 #include "Mesh/RealtimeMeshDataStream.h"
+#include "Mesh/RealtimeMeshStreamPool.h"
 #if RMC_ENGINE_ABOVE_5_2
 #include "RHIResourceUpdates.h"
 #include "DataDrivenShaderPlatformInfo.h"
@@ -118,6 +119,38 @@ namespace RealtimeMesh
 
 	using FRealtimeMeshSectionGroupStreamUpdateDataRef = TSharedRef<FRealtimeMeshSectionGroupStreamUpdateData>;
 
+	/**
+	 * Holds a contiguous run of rows to write into an existing GPU buffer, starting at FirstElement.
+	 * The stream only contains the rows being replaced, not the whole buffer, and goes back to the stream pool once the
+	 * render thread is done with it.
+	 */
+	struct REALTIMEMESHCOMPONENT_API FRealtimeMeshSectionGroupStreamRangeUpdateData
+	{
+	private:
+		FRealtimeMeshStream Stream;
+		int32 FirstElement;
+
+	public:
+		FRealtimeMeshSectionGroupStreamRangeUpdateData(FRealtimeMeshStream&& InStream, int32 InFirstElement)
+			: Stream(MoveTemp(InStream))
+			  , FirstElement(InFirstElement)
+		{
+		}
+
+		~FRealtimeMeshSectionGroupStreamRangeUpdateData()
+		{
+			FRealtimeMeshStreamPool::Get().Release(MakeUnique<FRealtimeMeshStream>(MoveTemp(Stream)));
+		}
+
+		const FRealtimeMeshStream& GetStream() const { return Stream; }
+		FRealtimeMeshBufferLayout GetBufferLayout() const { return Stream.GetLayout(); }
+		FRealtimeMeshStreamKey GetStreamKey() const { return Stream.GetStreamKey(); }
+		int32 GetFirstElement() const { return FirstElement; }
+		int32 GetNumElements() const { return Stream.Num(); }
+	};
+
+	using FRealtimeMeshSectionGroupStreamRangeUpdateDataRef = TSharedRef<FRealtimeMeshSectionGroupStreamRangeUpdateData>;
+
 	class REALTIMEMESHCOMPONENT_API FRealtimeMeshGPUBuffer
 	{
 	protected:
@@ -159,6 +192,7 @@ namespace RealtimeMesh
 		virtual void InitializeResources() = 0;
 		virtual void ReleaseUnderlyingResource() = 0;
 		virtual bool IsResourceInitialized() const = 0;
+		virtual FRHIBuffer* GetRHIBuffer() const = 0;
 
 		FORCEINLINE const FRealtimeMeshBufferLayout& GetBufferLayout() const { return BufferLayout; }
 		FORCEINLINE EPixelFormat GetElementFormat() const { return ElementDetails.GetPixelFormat(); }
@@ -168,6 +202,10 @@ namespace RealtimeMesh
 
 		FORCEINLINE int32 NumElements() const { return BufferLayout.GetNumElements(); }
 
+		/** Index buffers track their size in indices, this is always in rows like the stream itself */
+		FORCEINLINE int32 NumRows() const { return GetStreamType() == ERealtimeMeshStreamType::Index ? BufferNum / FMath::Max(NumElements(), 1) : BufferNum; }
+		FORCEINLINE int64 GetAllocatedSize() const { return static_cast<int64>(NumRows()) * GetStride(); }
+
 
 		static constexpr int32 RHIUpdateBatchSize = 16;
 
@@ -184,6 +222,42 @@ namespace RealtimeMesh
 			check(BufferLayout.IsValid());
 			check(GetStride() > 0);
 		}
+
+		/**
+		 * Writes a run of rows into the existing RHI buffer without reallocating it.
+		 * @return false if the range doesn't fit the current buffer, in which case nothing is written.
+		 */
+		virtual bool ApplyBufferRangeUpdate(const FRealtimeMeshSectionGroupStreamRangeUpdateDataRef& UpdateData)
+		{
+			check(IsInRenderingThread());
+
+			FRHIBuffer* Buffer = GetRHIBuffer();
+
+			if (BufferLayout != UpdateData->GetBufferLayout() || Buffer == nullptr || UpdateData->GetFirstElement() < 0 ||
+				UpdateData->GetFirstElement() + UpdateData->GetNumElements() > NumRows())
+			{
+				return false;
+			}
+
+			if (UpdateData->GetNumElements() > 0)
+			{
+				check(UpdateData->GetStream().GetStride() == static_cast<int32>(GetStride()));
+				const uint32 Offset = UpdateData->GetFirstElement() * GetStride();
+				const uint32 Size = UpdateData->GetNumElements() * GetStride();
+
+#if RMC_ENGINE_ABOVE_5_3
+				FRHICommandListImmediate& RHICmdList = FRHICommandListImmediate::Get();
+				void* Data = RHICmdList.LockBuffer(Buffer, Offset, Size, RLM_WriteOnly);
+				FMemory::Memcpy(Data, UpdateData->GetStream().GetData(), Size);
+				RHICmdList.UnlockBuffer(Buffer);
+#else
+				void* Data = RHILockBuffer(Buffer, Offset, Size, RLM_WriteOnly);
+				FMemory::Memcpy(Data, UpdateData->GetStream().GetData(), Size);
+				RHIUnlockBuffer(Buffer);
+#endif
+			}
+			return true;
+		}
 	};
 
 	class REALTIMEMESHCOMPONENT_API FRealtimeMeshVertexBuffer : public FRealtimeMeshGPUBuffer, public FVertexBufferWithSRV
@@ -210,6 +284,8 @@ namespace RealtimeMesh
 
 		virtual bool IsResourceInitialized() const override { return IsInitialized(); }
 
+		virtual FRHIBuffer* GetRHIBuffer() const override { return VertexBufferRHI.GetReference(); }
+
 		/** Gets the format of the vertex */
 		FORCEINLINE EVertexElementType GetVertexType() const { return ElementDetails.GetVertexType(); }
 
@@ -296,6 +372,8 @@ namespace RealtimeMesh
 		virtual void ReleaseUnderlyingResource() override { ReleaseResource(); }
 
 		virtual bool IsResourceInitialized() const override { return IsInitialized(); }
+
+		virtual FRHIBuffer* GetRHIBuffer() const override { return IndexBufferRHI.GetReference(); }
 		
 #if RMC_ENGINE_ABOVE_5_3
 		virtual void InitRHI(FRHICommandListBase& RHICmdList) override
@@ -26,6 +26,7 @@ namespace RealtimeMesh
 		TRange<int8> ValidLODRange;
 		TArray<TRange<float>> ScreenSizeRangeByLOD;
 		uint32 bIsStateDirty : 1;
+		uint32 bMergeCompatibleSections : 1;
 
 		TUniquePtr<FDistanceFieldVolumeData> DistanceField;
 		TUniquePtr<FCardRepresentationData> CardRepresentation;
@@ -42,6 +43,10 @@ namespace RealtimeMesh
 		TRange<int8> GetValidLODRange() const { return ValidLODRange; }
 		TRange<float> GetScreenSizeRangeForLOD(const FRealtimeMeshLODKey& LODKey) const;
 
+		/** When enabled, sections sharing a material and draw mask within a section group are submitted as one batch */
+		virtual void SetMergeCompatibleSections(bool bInMergeCompatibleSections);
+		bool IsMergingCompatibleSections() const { return bMergeCompatibleSections; }
+
 		virtual void SetDistanceField(FRealtimeMeshDistanceField&& InDistanceField);
 		bool HasDistanceFieldData() const;
 		const FDistanceFieldVolumeData* GetDistanceFieldData() const { return DistanceField.Get(); }
@@ -78,4 +78,54 @@ namespace RealtimeMesh
 			}, bInRequiresProxyRecreate);
 		}
 	};
+
+	/**
+	 * Scoped transaction that collects every FRealtimeMeshProxyCommandBatch committed on this thread while it is alive, across any
+	 * number of meshes, and submits them as a single render command with a single game thread completion.
+	 * Futures returned by commits inside the scope resolve together when the transaction completes.
+	 * Transactions nest, an inner one forwards to the outermost and its Commit resolves along with it.
+	 * Commits issued on other threads are not captured and are not ordered against the transaction.
+	 */
+	struct REALTIMEMESHCOMPONENT_API FRealtimeMeshUpdateBatch
+	{
+	private:
+		using TaskFunctionType = TUniqueFunction<void(FRealtimeMeshProxy&)>;
+
+		struct FMeshCommands
+		{
+			FRealtimeMeshWeakPtr Mesh;
+			FRealtimeMeshProxyWeakPtr Proxy;
+			TArray<TaskFunctionType> Tasks;
+			bool bRequiresProxyRecreate;
+		};
+
+		TArray<FMeshCommands> Meshes;
+		TMap<const FRealtimeMesh*, int32> MeshIndices;
+		TArray<TPromise<ERealtimeMeshProxyUpdateStatus>> DependentPromises;
+		FRealtimeMeshUpdateBatch* Outer;
+		bool bCommitted;
+
+	public:
+		FRealtimeMeshUpdateBatch();
+		~FRealtimeMeshUpdateBatch();
+
+		FRealtimeMeshUpdateBatch(const FRealtimeMeshUpdateBatch&) = delete;
+		FRealtimeMeshUpdateBatch(FRealtimeMeshUpdateBatch&&) = delete;
+		FRealtimeMeshUpdateBatch& operator=(const FRealtimeMeshUpdateBatch&) = delete;
+		FRealtimeMeshUpdateBatch& operator=(FRealtimeMeshUpdateBatch&&) = delete;
+
+		/** Gets the outermost transaction open on the calling thread, if any */
+		static FRealtimeMeshUpdateBatch* GetActive();
+
+		int32 NumMeshes() const { return Meshes.Num(); }
+
+		/** Submits everything collected so far. Called by the destructor if not called explicitly. */
+		TFuture<ERealtimeMeshProxyUpdateStatus> Commit();
+
+	private:
+		TFuture<ERealtimeMeshProxyUpdateStatus> AddCommands(const FRealtimeMeshPtr& InMesh, TArray<TaskFunctionType>&& InTasks, bool bInRequiresProxyRecreate);
+		TFuture<ERealtimeMeshProxyUpdateStatus> AddDependentFuture();
+
+		friend struct FRealtimeMeshProxyCommandBatch;
+	};
 }
@@ -10,6 +10,14 @@
 
 namespace RealtimeMesh
 {
+	/** Sections of a group that share a material and draw mask, with back to back index ranges joined */
+	struct FRealtimeMeshSectionDrawRun
+	{
+		int32 MaterialSlot;
+		FRealtimeMeshDrawMask DrawMask;
+		TArray<FRealtimeMeshStreamRange, TInlineAllocator<4>> Ranges;
+	};
+
 	class REALTIMEMESHCOMPONENT_API FRealtimeMeshSectionGroupProxy : public TSharedFromThis<FRealtimeMeshSectionGroupProxy>
 	{
 	private:
@@ -19,11 +27,13 @@ namespace RealtimeMesh
 		TArray<FRealtimeMeshSectionProxyRef> Sections;
 		TMap<FRealtimeMeshSectionKey, uint32> SectionMap;
 		FRealtimeMeshStreamProxyMap Streams;
+		TArray<FRealtimeMeshSectionDrawRun> DrawRuns;
 #if RHI_RAYTRACING
 		FRayTracingGeometry RayTracingGeometry;
 #endif
 
 		FRealtimeMeshDrawMask DrawMask;
+		int64 TrackedGPUBytes;
 		uint32 bIsStateDirty : 1;
 
 	public:
@@ -33,6 +43,7 @@ namespace RealtimeMesh
 		const FRealtimeMeshSectionGroupKey& GetKey() const { return Key; }
 		TSharedPtr<FRealtimeMeshVertexFactory> GetVertexFactory() const { return VertexFactory; }
 		FRealtimeMeshDrawMask GetDrawMask() const { return DrawMask; }
+		TConstArrayView<FRealtimeMeshSectionDrawRun> GetDrawRuns() const { return DrawRuns; }
 
 		FRealtimeMeshSectionProxyPtr GetSection(const FRealtimeMeshSectionKey& SectionKey) const;
 		TSharedPtr<FRealtimeMeshGPUBuffer> GetStream(const FRealtimeMeshStreamKey& StreamKey) const;
@@ -58,18 +69,22 @@ namespace RealtimeMesh
 		virtual void RemoveSection(const FRealtimeMeshSectionKey& SectionKey);
 
 		virtual void CreateOrUpdateStream(const FRealtimeMeshSectionGroupStreamUpdateDataRef& InStream);
+		virtual void UpdateStreamRange(const FRealtimeMeshSectionGroupStreamRangeUpdateDataRef& InStreamRange);
 		virtual void RemoveStream(const FRealtimeMeshStreamKey& StreamKey);
 
 		virtual void CreateMeshBatches(const FRealtimeMeshBatchCreationParams& Params, const TMap<int32, TTuple<FMaterialRenderProxy*, bool>>& Materials,
-		                               const FMaterialRenderProxy* WireframeMaterial, ERealtimeMeshSectionDrawType DrawType, bool bForceAllDynamic) const;
+		                               const FMaterialRenderProxy* WireframeMaterial, ERealtimeMeshSectionDrawType DrawType, bool bForceAllDynamic,
+		                               bool bMergeCompatibleSections = false) const;
 
 		virtual bool UpdateCachedState(bool bShouldForceUpdate);
 		virtual void Reset();
 
 	protected:
 		virtual void UpdateRayTracingInfo();
+		virtual void UpdateDrawRuns();
 
 		void MarkStateDirty();
 		void RebuildSectionMap();
+		void UpdateMemoryStats();
 	};
 }
@@ -42,6 +42,21 @@ namespace RealtimeMesh
 #endif
 		) const;
 
+		/** Builds and submits a single batch drawing every range as its own element. Ranges must share the material and draw mask. */
+		static bool CreateMeshBatchForRanges(
+			const FRealtimeMeshBatchCreationParams& Params,
+			const FRealtimeMeshVertexFactoryRef& VertexFactory,
+			const FMaterialRenderProxy* Material,
+			bool bIsWireframe,
+			bool bSupportsDithering,
+			int32 LODIndex,
+			FRealtimeMeshDrawMask InDrawMask,
+			TConstArrayView<FRealtimeMeshStreamRange> Ranges
+#if RHI_RAYTRACING
+			, const FRayTracingGeometry* RayTracingGeometry
+#endif
+		);
+
 		virtual bool UpdateCachedState(bool bShouldForceUpdate, FRealtimeMeshSectionGroupProxy& ParentGroup);
 		virtual void Reset();
 
@@ -336,14 +336,16 @@ FSurfelVisibility ComputeSurfelVisibility(
 }
 
 /**
- * Voxelize mesh by casting multiple rays per cell
+ * Voxelize one row of a direction's volume by casting multiple rays per cell.
+ * Rows are independent, so they can be generated in parallel and concatenated in row order afterwards.
  */
 template<typename MeshType>
-void GenerateSurfelsForDirection(
+void GenerateSurfelsForRow(
 	const FGenerateCardMeshContext<MeshType>& Context,
 	const FAxisAlignedDirectionBasis& ClusterBasis,	
 	const TArray<FVector3f>& RayDirectionsOverHemisphere,
 	const FClusteringParams& ClusteringParams,
+	int32 CoordY,
 	FSurfelScenePerDirection& SurfelScenePerDirection)
 {
 	const float NormalWeightTreshold = MeshCardRepresentation::GetNormalTreshold();
@@ -356,203 +358,200 @@ void GenerateSurfelsForDirection(
 	TArray<uint32> NumSurfelSamplesPerCell;
 	TArray<uint32> SurfelSamplesOffsetPerCell;
 
-	for (int32 CoordY = 0; CoordY < ClusterBasis.VolumeSize.Y; ++CoordY)
+	for (int32 CoordX = 0; CoordX < ClusterBasis.VolumeSize.X; ++CoordX)
 	{
-		for (int32 CoordX = 0; CoordX < ClusterBasis.VolumeSize.X; ++CoordX)
+		SurfelSamples.Reset();
+		NumSurfelSamplesPerCell.SetNum(ClusterBasis.VolumeSize.Z);
+		SurfelSamplesOffsetPerCell.SetNum(ClusterBasis.VolumeSize.Z);
+		for (int32 CoordZ = 0; CoordZ < ClusterBasis.VolumeSize.Z; ++CoordZ)
 		{
-			SurfelSamples.Reset();
-			NumSurfelSamplesPerCell.SetNum(ClusterBasis.VolumeSize.Z);
-			SurfelSamplesOffsetPerCell.SetNum(ClusterBasis.VolumeSize.Z);
-			for (int32 CoordZ = 0; CoordZ < ClusterBasis.VolumeSize.Z; ++CoordZ)
-			{
-				NumSurfelSamplesPerCell[CoordZ] = 0;
-				SurfelSamplesOffsetPerCell[CoordZ] = 0;
-			}
+			NumSurfelSamplesPerCell[CoordZ] = 0;
+			SurfelSamplesOffsetPerCell[CoordZ] = 0;
+		}
 
-			// Trace multiple rays per cell and mark cells which need to spawn a surfel
-			for (uint32 SampleIndex = 0; SampleIndex < NumSurfelSamples; ++SampleIndex)
-			{
-				FVector3f Jitter;
-				Jitter.X = (SampleIndex + 0.5f) / NumSurfelSamples;
-				Jitter.Y = (double)ReverseBits(SampleIndex) / (double)0x100000000LL;
+		// Trace multiple rays per cell and mark cells which need to spawn a surfel
+		for (uint32 SampleIndex = 0; SampleIndex < NumSurfelSamples; ++SampleIndex)
+		{
+			FVector3f Jitter;
+			Jitter.X = (SampleIndex + 0.5f) / NumSurfelSamples;
+			Jitter.Y = (double)ReverseBits(SampleIndex) / (double)0x100000000LL;
 
-				FVector3f RayOrigin = ClusterBasis.LocalToWorldRotation.TransformPosition(FVector3f(CoordX + Jitter.X, CoordY + Jitter.Y, 0.0f)) * ClusteringParams.VoxelSize + ClusterBasis.LocalToWorldOffset;
+			FVector3f RayOrigin = ClusterBasis.LocalToWorldRotation.TransformPosition(FVector3f(CoordX + Jitter.X, CoordY + Jitter.Y, 0.0f)) * ClusteringParams.VoxelSize + ClusterBasis.LocalToWorldOffset;
 
-				// Need to pullback to make sure that ray will start outside of geometry, as voxels may be smaller than mesh 
-				// due to voxel size rounding or they may start exactly at edge of geometry
-				const float NearPlaneOffset = 2.0f * ClusteringParams.VoxelSize;
-				RayOrigin -= RayDirection * NearPlaneOffset;
+			// Need to pullback to make sure that ray will start outside of geometry, as voxels may be smaller than mesh 
+			// due to voxel size rounding or they may start exactly at edge of geometry
+			const float NearPlaneOffset = 2.0f * ClusteringParams.VoxelSize;
+			RayOrigin -= RayDirection * NearPlaneOffset;
 
-				// Cell index where any geometry was last found
-				int32 LastHitCoordZ = -2;
-				int32 SkipTriangleId = INDEX_NONE;
-				float RayTNear = 0.0f;
+			// Cell index where any geometry was last found
+			int32 LastHitCoordZ = -2;
+			int32 SkipTriangleId = INDEX_NONE;
+			float RayTNear = 0.0f;
 
-				while (LastHitCoordZ + 1 < ClusterBasis.VolumeSize.Z)
+			while (LastHitCoordZ + 1 < ClusterBasis.VolumeSize.Z)
+			{
+				IMeshSpatial::FQueryOptions QueryOptions;
+				QueryOptions.MaxDistance = TNumericLimits<double>::Max();
+				QueryOptions.TriangleFilterF = [SkipTriangleId](int32 TriangleId) { return TriangleId != SkipTriangleId; };
+				const FVector3d AdjustedRayOrigin = (FVector3d)RayOrigin + (FVector3d)UE::Geometry::Normalized(RayDirection) * RayTNear;					
+				const FRay3d Ray(AdjustedRayOrigin, (FVector3d)RayDirection);
+				const int32 HitTriangleId = Context.MeshBVH.FindNearestHitTriangle(Ray, QueryOptions);
+
+				if (HitTriangleId != INDEX_NONE)
 				{
-					IMeshSpatial::FQueryOptions QueryOptions;
-					QueryOptions.MaxDistance = TNumericLimits<double>::Max();
-					QueryOptions.TriangleFilterF = [SkipTriangleId](int32 TriangleId) { return TriangleId != SkipTriangleId; };
-					const FVector3d AdjustedRayOrigin = (FVector3d)RayOrigin + (FVector3d)UE::Geometry::Normalized(RayDirection) * RayTNear;					
-					const FRay3d Ray(AdjustedRayOrigin, (FVector3d)RayDirection);
-					const int32 HitTriangleId = Context.MeshBVH.FindNearestHitTriangle(Ray, QueryOptions);
-
-					if (HitTriangleId != INDEX_NONE)
-					{
-						const FIntrRay3Triangle3d Intersection = TMeshQueries<MeshType>::TriangleIntersection(Context.Mesh, HitTriangleId, Ray);	
-						
-						const double RayTHitCombined = Intersection.RayParameter + RayTNear;
-						const int32 HitCoordZ = FMath::Clamp((RayTHitCombined - NearPlaneOffset) / ClusteringParams.VoxelSize, 0, ClusterBasis.VolumeSize.Z - 1);
+					const FIntrRay3Triangle3d Intersection = TMeshQueries<MeshType>::TriangleIntersection(Context.Mesh, HitTriangleId, Ray);	
+					
+					const double RayTHitCombined = Intersection.RayParameter + RayTNear;
+					const int32 HitCoordZ = FMath::Clamp((RayTHitCombined - NearPlaneOffset) / ClusteringParams.VoxelSize, 0, ClusterBasis.VolumeSize.Z - 1);
 
-						FVector SurfaceNormal = Context.Mesh.GetTriNormal(HitTriangleId);
-						float NdotD = FVector::DotProduct((FVector)-RayDirection, SurfaceNormal);						
+					FVector SurfaceNormal = Context.Mesh.GetTriNormal(HitTriangleId);
+					float NdotD = FVector::DotProduct((FVector)-RayDirection, SurfaceNormal);						
 
-						// Handle two sided hits
-						if (NdotD < 0.0f &&  false /*EmbreeContext.IsHitTwoSided()*/)
-						{
-							NdotD = -NdotD;
-							SurfaceNormal = -SurfaceNormal;
-						}
+					// Handle two sided hits
+					if (NdotD < 0.0f &&  false /*EmbreeContext.IsHitTwoSided()*/)
+					{
+						NdotD = -NdotD;
+						SurfaceNormal = -SurfaceNormal;
+					}
 
-						const bool bPassProjectionTest = NdotD >= NormalWeightTreshold;
-						if (bPassProjectionTest && HitCoordZ >= 0 && HitCoordZ > LastHitCoordZ + 1 && HitCoordZ < ClusterBasis.VolumeSize.Z)
-						{
-							FSurfelSample& SurfelSample = SurfelSamples.AddDefaulted_GetRef();
-							SurfelSample.Position = RayOrigin + RayDirection * RayTHitCombined;
-							SurfelSample.Normal = (FVector3f)SurfaceNormal;
-							SurfelSample.CellZ = HitCoordZ;
-							SurfelSample.MinRayZ = 0;
+					const bool bPassProjectionTest = NdotD >= NormalWeightTreshold;
+					if (bPassProjectionTest && HitCoordZ >= 0 && HitCoordZ > LastHitCoordZ + 1 && HitCoordZ < ClusterBasis.VolumeSize.Z)
+					{
+						FSurfelSample& SurfelSample = SurfelSamples.AddDefaulted_GetRef();
+						SurfelSample.Position = RayOrigin + RayDirection * RayTHitCombined;
+						SurfelSample.Normal = (FVector3f)SurfaceNormal;
+						SurfelSample.CellZ = HitCoordZ;
+						SurfelSample.MinRayZ = 0;
 
-							if (LastHitCoordZ >= 0)
-							{
-								SurfelSample.MinRayZ = FMath::Max(SurfelSample.MinRayZ, LastHitCoordZ + 1);
-							}
+						if (LastHitCoordZ >= 0)
+						{
+							SurfelSample.MinRayZ = FMath::Max(SurfelSample.MinRayZ, LastHitCoordZ + 1);
 						}
-
-						// Move ray to the next intersection
-						LastHitCoordZ = HitCoordZ;
-						RayTNear = std::nextafter(FMath::Max(NearPlaneOffset + (LastHitCoordZ + 1) * ClusteringParams.VoxelSize, RayTHitCombined), std::numeric_limits<float>::infinity());
-						SkipTriangleId = HitTriangleId;
-					}
-					else
-					{
-						break;
 					}
+
+					// Move ray to the next intersection
+					LastHitCoordZ = HitCoordZ;
+					RayTNear = std::nextafter(FMath::Max(NearPlaneOffset + (LastHitCoordZ + 1) * ClusteringParams.VoxelSize, RayTHitCombined), std::numeric_limits<float>::infinity());
+					SkipTriangleId = HitTriangleId;
+				}
+				else
+				{
+					break;
 				}
 			}
+		}
 
-			// Sort surfel candidates and compact arrays
+		// Sort surfel candidates and compact arrays
+		{
+			struct FSortByZ
 			{
-				struct FSortByZ
+				FORCEINLINE bool operator()(const FSurfelSample& A, const FSurfelSample& B) const
 				{
-					FORCEINLINE bool operator()(const FSurfelSample& A, const FSurfelSample& B) const
+					if (A.CellZ != B.CellZ)
 					{
-						if (A.CellZ != B.CellZ)
-						{
-							return A.CellZ < B.CellZ;
-						}
-
-						return A.MinRayZ > B.MinRayZ;
+						return A.CellZ < B.CellZ;
 					}
-				};
-
-				SurfelSamples.Sort(FSortByZ());
 
-				for (int32 SampleIndex = 0; SampleIndex < SurfelSamples.Num(); ++SampleIndex)
-				{
-					const FSurfelSample& SurfelSample = SurfelSamples[SampleIndex];
-					++NumSurfelSamplesPerCell[SurfelSample.CellZ];
+					return A.MinRayZ > B.MinRayZ;
 				}
+			};
 
-				for (int32 CoordZ = 1; CoordZ < ClusterBasis.VolumeSize.Z; ++CoordZ)
-				{
-					SurfelSamplesOffsetPerCell[CoordZ] = SurfelSamplesOffsetPerCell[CoordZ - 1] + NumSurfelSamplesPerCell[CoordZ - 1];
-				}
+			SurfelSamples.Sort(FSortByZ());
+
+			for (int32 SampleIndex = 0; SampleIndex < SurfelSamples.Num(); ++SampleIndex)
+			{
+				const FSurfelSample& SurfelSample = SurfelSamples[SampleIndex];
+				++NumSurfelSamplesPerCell[SurfelSample.CellZ];
 			}
 
-			// Convert surfel candidates into actual surfels
-			for (int32 CoordZ = 0; CoordZ < ClusterBasis.VolumeSize.Z; ++CoordZ)
+			for (int32 CoordZ = 1; CoordZ < ClusterBasis.VolumeSize.Z; ++CoordZ)
 			{
-				const int32 CellNumSurfelSamples = NumSurfelSamplesPerCell[CoordZ];
-				const int32 CellSurfelSamplesOffset = SurfelSamplesOffsetPerCell[CoordZ];
+				SurfelSamplesOffsetPerCell[CoordZ] = SurfelSamplesOffsetPerCell[CoordZ - 1] + NumSurfelSamplesPerCell[CoordZ - 1];
+			}
+		}
+
+		// Convert surfel candidates into actual surfels
+		for (int32 CoordZ = 0; CoordZ < ClusterBasis.VolumeSize.Z; ++CoordZ)
+		{
+			const int32 CellNumSurfelSamples = NumSurfelSamplesPerCell[CoordZ];
+			const int32 CellSurfelSamplesOffset = SurfelSamplesOffsetPerCell[CoordZ];
 
-				int32 SurfelSampleSpanBegin = 0;
-				int32 SurfelSampleSpanSize = 0;
+			int32 SurfelSampleSpanBegin = 0;
+			int32 SurfelSampleSpanSize = 0;
 
-				bool bAnySurfelAdded = false;
-				while (SurfelSampleSpanBegin + 1 < CellNumSurfelSamples)
+			bool bAnySurfelAdded = false;
+			while (SurfelSampleSpanBegin + 1 < CellNumSurfelSamples)
+			{
+				// Find continuous spans of equal MinRayZ
+				// Every such span will spawn one surfel
+				SurfelSampleSpanSize = 0;
+				for (int32 SampleIndex = SurfelSampleSpanBegin; SampleIndex < CellNumSurfelSamples; ++SampleIndex)
 				{
-					// Find continuous spans of equal MinRayZ
-					// Every such span will spawn one surfel
-					SurfelSampleSpanSize = 0;
-					for (int32 SampleIndex = SurfelSampleSpanBegin; SampleIndex < CellNumSurfelSamples; ++SampleIndex)
+					if (SurfelSamples[SampleIndex].MinRayZ == SurfelSamples[SurfelSampleSpanBegin].MinRayZ)
 					{
-						if (SurfelSamples[SampleIndex].MinRayZ == SurfelSamples[SurfelSampleSpanBegin].MinRayZ)
-						{
-							++SurfelSampleSpanSize;
-						}
-						else
-						{
-							break;
-						}
+						++SurfelSampleSpanSize;
 					}
-
-					if (SurfelSampleSpanSize >= MinSurfelSamples)
+					else
 					{
-						FSurfelVisibility SurfelVisibility = ComputeSurfelVisibility(
-							Context,
-							SurfelSamples,
-							CellSurfelSamplesOffset + SurfelSampleSpanBegin,
-							SurfelSampleSpanSize,
-							RayDirectionsOverHemisphere,
-							SurfelScenePerDirection.DebugData);
+						break;
+					}
+				}
+
+				if (SurfelSampleSpanSize >= MinSurfelSamples)
+				{
+					FSurfelVisibility SurfelVisibility = ComputeSurfelVisibility(
+						Context,
+						SurfelSamples,
+						CellSurfelSamplesOffset + SurfelSampleSpanBegin,
+						SurfelSampleSpanSize,
+						RayDirectionsOverHemisphere,
+						SurfelScenePerDirection.DebugData);
 
-						const float Coverage = SurfelSampleSpanSize / float(NumSurfelSamples);
+					const float Coverage = SurfelSampleSpanSize / float(NumSurfelSamples);
 
-						if (SurfelVisibility.bValid)
-						{
-							const int32 MedianMinRayZ = SurfelSamples[CellSurfelSamplesOffset + SurfelSampleSpanBegin].MinRayZ;
-
-							FSurfel& Surfel = SurfelScenePerDirection.Surfels.AddDefaulted_GetRef();
-							Surfel.Coord = FIntVector(CoordX, CoordY, CoordZ);
-							Surfel.MinRayZ = MedianMinRayZ;
-							Surfel.Coverage = Coverage;
-							Surfel.WeightedCoverage = Coverage * (SurfelVisibility.Visibility + 1.0f);
-							check(Surfel.Coord.Z > Surfel.MinRayZ || Surfel.MinRayZ == 0);
-						}
+					if (SurfelVisibility.bValid)
+					{
+						const int32 MedianMinRayZ = SurfelSamples[CellSurfelSamplesOffset + SurfelSampleSpanBegin].MinRayZ;
+
+						FSurfel& Surfel = SurfelScenePerDirection.Surfels.AddDefaulted_GetRef();
+						Surfel.Coord = FIntVector(CoordX, CoordY, CoordZ);
+						Surfel.MinRayZ = MedianMinRayZ;
+						Surfel.Coverage = Coverage;
+						Surfel.WeightedCoverage = Coverage * (SurfelVisibility.Visibility + 1.0f);
+						check(Surfel.Coord.Z > Surfel.MinRayZ || Surfel.MinRayZ == 0);
+					}
 
-						if (ClusteringParams.bDebug)
-						{
-							FLumenCardBuildDebugData::FSurfel& DebugSurfel = SurfelScenePerDirection.DebugData.Surfels.AddDefaulted_GetRef();
-							DebugSurfel.Position = ClusterBasis.TransformSurfel(FIntVector(CoordX, CoordY, CoordZ));
-							DebugSurfel.Normal = -RayDirection;
+					if (ClusteringParams.bDebug)
+					{
+						FLumenCardBuildDebugData::FSurfel& DebugSurfel = SurfelScenePerDirection.DebugData.Surfels.AddDefaulted_GetRef();
+						DebugSurfel.Position = ClusterBasis.TransformSurfel(FIntVector(CoordX, CoordY, CoordZ));
+						DebugSurfel.Normal = -RayDirection;
 #if RMC_ENGINE_ABOVE_5_1
-							DebugSurfel.Coverage = Coverage;
-							DebugSurfel.Visibility = SurfelVisibility.Visibility;
+						DebugSurfel.Coverage = Coverage;
+						DebugSurfel.Visibility = SurfelVisibility.Visibility;
 #endif
-							DebugSurfel.SourceSurfelIndex = SurfelScenePerDirection.Surfels.Num() - 1;
-							DebugSurfel.Type = SurfelVisibility.bValid ? FLumenCardBuildDebugData::ESurfelType::Valid : FLumenCardBuildDebugData::ESurfelType::Invalid;
-							bAnySurfelAdded = true;
-						}
+						DebugSurfel.SourceSurfelIndex = SurfelScenePerDirection.Surfels.Num() - 1;
+						DebugSurfel.Type = SurfelVisibility.bValid ? FLumenCardBuildDebugData::ESurfelType::Valid : FLumenCardBuildDebugData::ESurfelType::Invalid;
+						bAnySurfelAdded = true;
 					}
-
-					SurfelSampleSpanBegin += SurfelSampleSpanSize;
 				}
 
+				SurfelSampleSpanBegin += SurfelSampleSpanSize;
+			}
+
 #define DEBUG_ADD_ALL_SURFELS 0
 #if DEBUG_ADD_ALL_SURFELS
-				if (ClusteringParams.bDebug && !bAnySurfelAdded)
-				{
-					FLumenCardBuildDebugData::FSurfel& DebugSurfel = SurfelScenePerDirection.DebugData.Surfels.AddDefaulted_GetRef();
-					DebugSurfel.Position = ClusterBasis.TransformSurfel(FIntVector(CoordX, CoordY, CoordZ));
-					DebugSurfel.Normal = -RayDirection;
-					DebugSurfel.Coverage = 1.0f;
-					DebugSurfel.Visibility = 1.0f;
-					DebugSurfel.SourceSurfelIndex = SurfelScenePerDirection.Surfels.Num() - 1;
-					DebugSurfel.Type = FLumenCardBuildDebugData::ESurfelType::Invalid;
-				}
-#endif
+			if (ClusteringParams.bDebug && !bAnySurfelAdded)
+			{
+				FLumenCardBuildDebugData::FSurfel& DebugSurfel = SurfelScenePerDirection.DebugData.Surfels.AddDefaulted_GetRef();
+				DebugSurfel.Position = ClusterBasis.TransformSurfel(FIntVector(CoordX, CoordY, CoordZ));
+				DebugSurfel.Normal = -RayDirection;
+				DebugSurfel.Coverage = 1.0f;
+				DebugSurfel.Visibility = 1.0f;
+				DebugSurfel.SourceSurfelIndex = SurfelScenePerDirection.Surfels.Num() - 1;
+				DebugSurfel.Type = FLumenCardBuildDebugData::ESurfelType::Invalid;
 			}
+#endif
 		}
 	}
 }
@@ -649,12 +648,17 @@ void InitClusteringParams(FClusteringParams& ClusteringParams, const FBox& MeshC
 	ClusteringParams.bSingleThreadedBuild = bSingleThreadedBuild;
 }
 
+/**
+ * Surfel generation starts at InOutMaxVoxels and halves the resolution until the surfel budget is met,
+ * InOutMaxVoxels returns the resolution that was kept so a later generation can start from it directly.
+ */
 template<typename MeshType>
 void InitSurfelScene(
 	const FGenerateCardMeshContext<MeshType>& Context,
 	const FBox& MeshCardsBounds,
 	int32 MaxLumenMeshCards,
 	bool bSingleThreadedBuild,
+	float& InOutMaxVoxels,
 	FSurfelScene& SurfelScene,
 	FClusteringParams& ClusteringParams)
 {
@@ -680,33 +684,80 @@ void InitSurfelScene(
 
 	// Limit max number of surfels to prevent generation time from exploding, as dense two sided meshes can generate many more surfels than simple walls
 	int32 TargetNumSufels = 10000;
-	float MaxVoxels = 64;
+	float MaxVoxels = InOutMaxVoxels;
+
+	struct FSurfelRow
+	{
+		int32 AxisAlignedDirectionIndex;
+		int32 CoordY;
+	};
+	TArray<FSurfelRow> Rows;
+	TArray<FSurfelScenePerDirection> RowScenes;
 
-	do
+	while (true)
 	{
 		InitClusteringParams(ClusteringParams, MeshCardsBounds, MaxVoxels, MaxLumenMeshCards, bSingleThreadedBuild);
 
+		// Six directions alone can't keep a large machine busy, so every row of every direction is its own task
+		Rows.Reset();
+		for (int32 AxisAlignedDirectionIndex = 0; AxisAlignedDirectionIndex < MeshCardGen::NumAxisAlignedDirections; ++AxisAlignedDirectionIndex)
+		{
+			if (DebugSurfelDirection < 0 || DebugSurfelDirection == AxisAlignedDirectionIndex)
+			{
+				for (int32 CoordY = 0; CoordY < ClusteringParams.ClusterBasis[AxisAlignedDirectionIndex].VolumeSize.Y; ++CoordY)
+				{
+					Rows.Add({ AxisAlignedDirectionIndex, CoordY });
+				}
+			}
+		}
+		RowScenes.Reset();
+		RowScenes.SetNum(Rows.Num());
+
 #if RMC_ENGINE_ABOVE_5_1
-		ParallelFor(TEXT("InitSurfelScene.PF"), MeshCardGen::NumAxisAlignedDirections, 1,
+		ParallelFor(TEXT("InitSurfelScene.PF"), Rows.Num(), 1,
 #else
-      	ParallelFor(MeshCardGen::NumAxisAlignedDirections,
+		ParallelFor(Rows.Num(),
 #endif
-			[&](int32 AxisAlignedDirectionIndex)
+			[&](int32 RowIndex)
 			{
-				if (DebugSurfelDirection < 0 || DebugSurfelDirection == AxisAlignedDirectionIndex)
-				{
-					FSurfelScenePerDirection& SurfelScenePerDirection = SurfelScene.Directions[AxisAlignedDirectionIndex];
-					SurfelScenePerDirection.Init();
+				const FSurfelRow& Row = Rows[RowIndex];
+				FSurfelScenePerDirection& RowScene = RowScenes[RowIndex];
+				RowScene.Init();
+
+				GenerateSurfelsForRow(
+					Context,
+					ClusteringParams.ClusterBasis[Row.AxisAlignedDirectionIndex],
+					RayDirectionsOverHemisphere,
+					ClusteringParams,
+					Row.CoordY,
+					RowScene
+				);
+			}, ClusteringParams.bSingleThreadedBuild ? EParallelForFlags::ForceSingleThread : EParallelForFlags::Unbalanced);
+
+		// Concatenate rows in order so surfel indices match a serial build
+		for (FSurfelScenePerDirection& SurfelScenePerDirection : SurfelScene.Directions)
+		{
+			SurfelScenePerDirection.Init();
+		}
 
-					GenerateSurfelsForDirection(
-						Context,
-						ClusteringParams.ClusterBasis[AxisAlignedDirectionIndex],
-						RayDirectionsOverHemisphere,
-						ClusteringParams,
-						SurfelScenePerDirection
-					);
+		for (int32 RowIndex = 0; RowIndex < Rows.Num(); ++RowIndex)
+		{
+			FSurfelScenePerDirection& SurfelScenePerDirection = SurfelScene.Directions[Rows[RowIndex].AxisAlignedDirectionIndex];
+			FSurfelScenePerDirection& RowScene = RowScenes[RowIndex];
+			const int32 SurfelOffset = SurfelScenePerDirection.Surfels.Num();
+
+			SurfelScenePerDirection.Surfels.Append(RowScene.Surfels);
+
+			if (ClusteringParams.bDebug)
+			{
+				for (FLumenCardBuildDebugData::FSurfel& DebugSurfel : RowScene.DebugData.Surfels)
+				{
+					DebugSurfel.SourceSurfelIndex += SurfelOffset;
 				}
-			}, ClusteringParams.bSingleThreadedBuild ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+				SurfelScenePerDirection.DebugData.Surfels.Append(RowScene.DebugData.Surfels);
+				SurfelScenePerDirection.DebugData.SurfelRays.Append(RowScene.DebugData.SurfelRays);
+			}
+		}
 
 		SurfelScene.NumSurfels = 0;
 		for (const FSurfelScenePerDirection& SurfelScenePerDirection : SurfelScene.Directions)
@@ -714,8 +765,14 @@ void InitSurfelScene(
 			SurfelScene.NumSurfels += SurfelScenePerDirection.Surfels.Num();
 		}
 
+		if (SurfelScene.NumSurfels <= TargetNumSufels || MaxVoxels / 2 <= 1)
+		{
+			break;
+		}
 		MaxVoxels = MaxVoxels / 2;
-	} while (SurfelScene.NumSurfels > TargetNumSufels && MaxVoxels > 1);
+	}
+
+	InOutMaxVoxels = MaxVoxels;
 
 	if (ClusteringParams.bDebug)
 	{
@@ -737,6 +794,47 @@ void InitSurfelScene(
 	}
 }
 
+namespace RealtimeMesh
+{
+	struct FRealtimeMeshCardGenerationState
+	{
+		FCriticalSection Lock;
+		bool bValid = false;
+
+		// Surfel resolution the previous generation settled on, and the grid it produced
+		float MaxVoxels = 64;
+		FClusteringParams ClusteringParams;
+
+		// Near planes of the clusters committed per direction, in commit order
+		TArray<int32> NearPlanes[MeshCardGen::NumAxisAlignedDirections];
+	};
+}
+
+/**
+ * Whether two clustering setups share the voxel grid closely enough for clusters of one to be meaningful in the other
+ */
+bool IsSameVoxelGrid(const FClusteringParams& A, const FClusteringParams& B)
+{
+	if (!FMath::IsNearlyEqual(A.VoxelSize, B.VoxelSize, A.VoxelSize * 0.01f))
+	{
+		return false;
+	}
+
+	for (int32 AxisAlignedDirectionIndex = 0; AxisAlignedDirectionIndex < MeshCardGen::NumAxisAlignedDirections; ++AxisAlignedDirectionIndex)
+	{
+		const FAxisAlignedDirectionBasis& BasisA = A.ClusterBasis[AxisAlignedDirectionIndex];
+		const FAxisAlignedDirectionBasis& BasisB = B.ClusterBasis[AxisAlignedDirectionIndex];
+
+		if (BasisA.VolumeSize != BasisB.VolumeSize
+			|| !BasisA.LocalToWorldOffset.Equals(BasisB.LocalToWorldOffset, 0.25f * A.VoxelSize))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
 struct FMeshCardsPerDirection
 {
 	TArray<FSurfelCluster> Clusters;
@@ -780,7 +878,7 @@ void UpdateMeshCardsCoverage(const FSurfelScene& SurfelScene, const FClusteringP
 void BuildCluster(
 	int32 NearPlane,
 	const FSurfelScenePerDirection& SurfelScene,
-	TBitArray<>& SurfelAssignedToAnyCluster,
+	const TBitArray<>& SurfelAssignedToAnyCluster,
 	FSurfelCluster& Cluster)
 {
 	Cluster.Init(NearPlane);
@@ -794,6 +892,41 @@ void BuildCluster(
 	}
 }
 
+/**
+ * Find the near plane whose cluster has the best weighted coverage of the surfels not assigned yet.
+ * Near planes are evaluated in parallel and the best one is picked in near plane order, so the result matches a serial sweep.
+ */
+void FindBestCluster(
+	const FSurfelScenePerDirection& SurfelScene,
+	const TBitArray<>& SurfelAssignedToAnyCluster,
+	const FClusteringParams& ClusteringParams,
+	int32 NumNearPlanes,
+	FSurfelCluster& BestCluster)
+{
+	BestCluster.Init(-1);
+
+	TArray<FSurfelCluster> Candidates;
+	Candidates.SetNum(FMath::Max(NumNearPlanes - 1, 0));
+
+#if RMC_ENGINE_ABOVE_5_1
+	ParallelFor(TEXT("FindBestCluster.PF"), Candidates.Num(), 1,
+#else
+	ParallelFor(Candidates.Num(),
+#endif
+		[&](int32 CandidateIndex)
+		{
+			BuildCluster(/*NearPlane*/ CandidateIndex + 1, SurfelScene, SurfelAssignedToAnyCluster, Candidates[CandidateIndex]);
+		}, ClusteringParams.bSingleThreadedBuild ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+	for (FSurfelCluster& Candidate : Candidates)
+	{
+		if (Candidate.IsValid(ClusteringParams) && Candidate.WeightedCoverage > BestCluster.WeightedCoverage)
+		{
+			BestCluster = MoveTemp(Candidate);
+		}
+	}
+}
+
 /**
  * Add cluster to the cluster list
  */
@@ -857,9 +990,13 @@ void LimitClusters(const FClusteringParams& ClusteringParams, const FSurfelScene
 
 /**
  * Cover mesh using a set of clusters(cards)
+ * SeedNearPlanes optionally holds, per direction, the near planes committed by a previous build of a similar mesh. They are tried
+ * first, so the full near plane search only has to run once more per direction to confirm nothing is left to cover.
+ * OutNearPlanes receives the near planes committed by this build, before the cluster limit is applied.
  */
 template<typename MeshType>
-void BuildSurfelClusters(const FBox& MeshBounds, const FGenerateCardMeshContext<MeshType>& Context, const FSurfelScene& SurfelScene, const FClusteringParams& ClusteringParams, FMeshCards& MeshCards)
+void BuildSurfelClusters(const FBox& MeshBounds, const FGenerateCardMeshContext<MeshType>& Context, const FSurfelScene& SurfelScene, const FClusteringParams& ClusteringParams,
+	const TArray<int32>* SeedNearPlanes, TArray<int32>* OutNearPlanes, FMeshCards& MeshCards)
 {
 	TBitArray<> SurfelAssignedToAnyClusterArray[MeshCardGen::NumAxisAlignedDirections];
 	for (int32 AxisAlignedDirectionIndex = 0; AxisAlignedDirectionIndex < MeshCardGen::NumAxisAlignedDirections; ++AxisAlignedDirectionIndex)
@@ -891,21 +1028,26 @@ void BuildSurfelClusters(const FBox& MeshBounds, const FGenerateCardMeshContext<
 			// Assume that two sided is foliage and revert to a simpler box projection
 			if (!Context.bMostlyTwoSided)
 			{
-				FSurfelCluster BestCluster;
-
-				while (bCanAddCluster)
+				if (bCanAddCluster && SeedNearPlanes != nullptr)
 				{
-					BestCluster.Init(-1);
-
-					for (int32 NearPlane = 1; NearPlane < ClusterBasis.VolumeSize.Z; ++NearPlane)
+					for (const int32 NearPlane : SeedNearPlanes[AxisAlignedDirectionIndex])
 					{
-						BuildCluster(NearPlane, SurfelScenePerDirection, SurfelAssignedToAnyCluster, TempCluster);
-
-						if (TempCluster.IsValid(ClusteringParams) && TempCluster.WeightedCoverage > BestCluster.WeightedCoverage)
+						if (NearPlane > 0 && NearPlane < ClusterBasis.VolumeSize.Z)
 						{
-							BestCluster = TempCluster;
+							BuildCluster(NearPlane, SurfelScenePerDirection, SurfelAssignedToAnyCluster, TempCluster);
+							if (TempCluster.IsValid(ClusteringParams))
+							{
+								CommitCluster(Clusters, SurfelAssignedToAnyCluster, TempCluster);
+							}
 						}
 					}
+				}
+
+				FSurfelCluster BestCluster;
+
+				while (bCanAddCluster)
+				{
+					FindBestCluster(SurfelScenePerDirection, SurfelAssignedToAnyCluster, ClusteringParams, ClusterBasis.VolumeSize.Z, BestCluster);
 
 					bCanAddCluster = BestCluster.IsValid(ClusteringParams);
 					if (bCanAddCluster)
@@ -915,6 +1057,18 @@ void BuildSurfelClusters(const FBox& MeshBounds, const FGenerateCardMeshContext<
 				}
 			}
 
+			if (OutNearPlanes != nullptr)
+			{
+				OutNearPlanes[AxisAlignedDirectionIndex].Reset();
+				for (const FSurfelCluster& Cluster : Clusters)
+				{
+					if (Cluster.NearPlane > 0)
+					{
+						OutNearPlanes[AxisAlignedDirectionIndex].Add(Cluster.NearPlane);
+					}
+				}
+			}
+
 		}, ClusteringParams.bSingleThreadedBuild ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
 
 	LimitClusters(ClusteringParams, SurfelScene, MeshCards);
@@ -929,99 +1083,118 @@ void SerializeLOD(
 	const FBox& MeshCardsBounds,
 	FMeshCardsBuildData& MeshCardsBuildData)
 {
+	// Cards of each direction are fitted in parallel and appended in direction order afterwards
+	int32 SourceSurfelOffsets[MeshCardGen::NumAxisAlignedDirections];
 	int32 SourceSurfelOffset = 0;
-
 	for (int32 AxisAlignedDirectionIndex = 0; AxisAlignedDirectionIndex < MeshCardGen::NumAxisAlignedDirections; ++AxisAlignedDirectionIndex)
 	{
-		const FAxisAlignedDirectionBasis& ClusterBasis = ClusteringParams.ClusterBasis[AxisAlignedDirectionIndex];
-		const FSurfelScenePerDirection& SurfelScenePerDirection = SurfelScene.Directions[AxisAlignedDirectionIndex];
-		const TArray<FSurfel>& Surfels = SurfelScenePerDirection.Surfels;
-		const TArray<FSurfelCluster>& Clusters = MeshCards.Directions[AxisAlignedDirectionIndex].Clusters;
-
-		TBitArray<> DebugSurfelInCluster;
-		TBitArray<> DebugSurfelInAnyCluster(false, Surfels.Num());
+		SourceSurfelOffsets[AxisAlignedDirectionIndex] = SourceSurfelOffset;
+		SourceSurfelOffset += SurfelScene.Directions[AxisAlignedDirectionIndex].Surfels.Num();
+	}
 
-		const FBox3f LocalMeshCardsBounds = FBox3f(MeshCardsBounds.ShiftBy((FVector)-ClusterBasis.LocalToWorldOffset).TransformBy(FMatrix(ClusterBasis.LocalToWorldRotation.GetTransposed())));
+	TArray<FLumenCardBuildData> CardBuildDataPerDirection[MeshCardGen::NumAxisAlignedDirections];
+	TArray<FLumenCardBuildDebugData::FSurfelCluster> DebugClustersPerDirection[MeshCardGen::NumAxisAlignedDirections];
 
-		for (const FSurfelCluster& Cluster : Clusters)
+#if RMC_ENGINE_ABOVE_5_1
+	ParallelFor(TEXT("SerializeLOD.PF"), MeshCardGen::NumAxisAlignedDirections, 1,
+#else
+	ParallelFor(MeshCardGen::NumAxisAlignedDirections,
+#endif
+		[&](int32 AxisAlignedDirectionIndex)
 		{
-			// Set card to cover voxels, with a 0.5 voxel margin for the near/far plane
-			FVector3f ClusterBoundsMin = (FVector3f(Cluster.Bounds.Min) - FVector3f(0.0f, 0.0f, 0.5f)) * ClusteringParams.VoxelSize;
-			FVector3f ClusterBoundsMax = (FVector3f(Cluster.Bounds.Max) + FVector3f(1.0f, 1.0f, 1.5f)) * ClusteringParams.VoxelSize;
-
-			// Clamp to mesh bounds
-			// Leave small margin for Z as LOD/displacement may move it outside of bounds
-			static float MarginZ = 10.0f;
-			ClusterBoundsMin.X = FMath::Max(ClusterBoundsMin.X, LocalMeshCardsBounds.Min.X);
-			ClusterBoundsMin.Y = FMath::Max(ClusterBoundsMin.Y, LocalMeshCardsBounds.Min.Y);
-			ClusterBoundsMin.Z = FMath::Max(ClusterBoundsMin.Z, LocalMeshCardsBounds.Min.Z - MarginZ);
-			ClusterBoundsMax.X = FMath::Min(ClusterBoundsMax.X, LocalMeshCardsBounds.Max.X);
-			ClusterBoundsMax.Y = FMath::Min(ClusterBoundsMax.Y, LocalMeshCardsBounds.Max.Y);
-			ClusterBoundsMax.Z = FMath::Min(ClusterBoundsMax.Z, LocalMeshCardsBounds.Max.Z + MarginZ);
-
-			const FVector3f ClusterBoundsOrigin = (ClusterBoundsMax + ClusterBoundsMin) * 0.5f;
-			const FVector3f ClusterBoundsExtent = (ClusterBoundsMax - ClusterBoundsMin) * 0.5f;
-			const FVector3f MeshClusterBoundsOrigin = ClusterBasis.LocalToWorldRotation.TransformPosition(ClusterBoundsOrigin) + ClusterBasis.LocalToWorldOffset;
-
-			FLumenCardBuildData BuiltData;
-			BuiltData.OBB.Origin = MeshClusterBoundsOrigin;
-			BuiltData.OBB.Extent = ClusterBoundsExtent;
-			BuiltData.OBB.AxisX = ClusterBasis.LocalToWorldRotation.GetScaledAxis(EAxis::X);
-			BuiltData.OBB.AxisY = ClusterBasis.LocalToWorldRotation.GetScaledAxis(EAxis::Y);
-			BuiltData.OBB.AxisZ = -ClusterBasis.LocalToWorldRotation.GetScaledAxis(EAxis::Z);
-			BuiltData.AxisAlignedDirectionIndex = AxisAlignedDirectionIndex;
-			MeshCardsBuildData.CardBuildData.Add(BuiltData);
+			const FAxisAlignedDirectionBasis& ClusterBasis = ClusteringParams.ClusterBasis[AxisAlignedDirectionIndex];
+			const FSurfelScenePerDirection& SurfelScenePerDirection = SurfelScene.Directions[AxisAlignedDirectionIndex];
+			const TArray<FSurfel>& Surfels = SurfelScenePerDirection.Surfels;
+			const TArray<FSurfelCluster>& Clusters = MeshCards.Directions[AxisAlignedDirectionIndex].Clusters;
 
-			if (ClusteringParams.bDebug)
-			{
-				DebugSurfelInCluster.Reset();
-				DebugSurfelInCluster.Add(false, Surfels.Num());
+			TBitArray<> DebugSurfelInCluster;
+			TBitArray<> DebugSurfelInAnyCluster(false, Surfels.Num());
 
-				FLumenCardBuildDebugData::FSurfelCluster& DebugCluster = MeshCardsBuildData.DebugData.Clusters.AddDefaulted_GetRef();
-				DebugCluster.Surfels.Reserve(DebugCluster.Surfels.Num() + Surfels.Num());
+			const FBox3f LocalMeshCardsBounds = FBox3f(MeshCardsBounds.ShiftBy((FVector)-ClusterBasis.LocalToWorldOffset).TransformBy(FMatrix(ClusterBasis.LocalToWorldRotation.GetTransposed())));
 
-				for (FSurfelIndex SurfelIndex : Cluster.SurfelIndices)
+			for (const FSurfelCluster& Cluster : Clusters)
+			{
+				// Set card to cover voxels, with a 0.5 voxel margin for the near/far plane
+				FVector3f ClusterBoundsMin = (FVector3f(Cluster.Bounds.Min) - FVector3f(0.0f, 0.0f, 0.5f)) * ClusteringParams.VoxelSize;
+				FVector3f ClusterBoundsMax = (FVector3f(Cluster.Bounds.Max) + FVector3f(1.0f, 1.0f, 1.5f)) * ClusteringParams.VoxelSize;
+
+				// Clamp to mesh bounds
+				// Leave small margin for Z as LOD/displacement may move it outside of bounds
+				static float MarginZ = 10.0f;
+				ClusterBoundsMin.X = FMath::Max(ClusterBoundsMin.X, LocalMeshCardsBounds.Min.X);
+				ClusterBoundsMin.Y = FMath::Max(ClusterBoundsMin.Y, LocalMeshCardsBounds.Min.Y);
+				ClusterBoundsMin.Z = FMath::Max(ClusterBoundsMin.Z, LocalMeshCardsBounds.Min.Z - MarginZ);
+				ClusterBoundsMax.X = FMath::Min(ClusterBoundsMax.X, LocalMeshCardsBounds.Max.X);
+				ClusterBoundsMax.Y = FMath::Min(ClusterBoundsMax.Y, LocalMeshCardsBounds.Max.Y);
+				ClusterBoundsMax.Z = FMath::Min(ClusterBoundsMax.Z, LocalMeshCardsBounds.Max.Z + MarginZ);
+
+				const FVector3f ClusterBoundsOrigin = (ClusterBoundsMax + ClusterBoundsMin) * 0.5f;
+				const FVector3f ClusterBoundsExtent = (ClusterBoundsMax - ClusterBoundsMin) * 0.5f;
+				const FVector3f MeshClusterBoundsOrigin = ClusterBasis.LocalToWorldRotation.TransformPosition(ClusterBoundsOrigin) + ClusterBasis.LocalToWorldOffset;
+
+				FLumenCardBuildData BuiltData;
+				BuiltData.OBB.Origin = MeshClusterBoundsOrigin;
+				BuiltData.OBB.Extent = ClusterBoundsExtent;
+				BuiltData.OBB.AxisX = ClusterBasis.LocalToWorldRotation.GetScaledAxis(EAxis::X);
+				BuiltData.OBB.AxisY = ClusterBasis.LocalToWorldRotation.GetScaledAxis(EAxis::Y);
+				BuiltData.OBB.AxisZ = -ClusterBasis.LocalToWorldRotation.GetScaledAxis(EAxis::Z);
+				BuiltData.AxisAlignedDirectionIndex = AxisAlignedDirectionIndex;
+				CardBuildDataPerDirection[AxisAlignedDirectionIndex].Add(BuiltData);
+
+				if (ClusteringParams.bDebug)
 				{
-					FLumenCardBuildDebugData::FSurfel DebugSurfel;
-					DebugSurfel.Position = ClusterBasis.TransformSurfel(Surfels[SurfelIndex].Coord);
-					DebugSurfel.Normal = AxisAlignedDirectionIndexToNormal(AxisAlignedDirectionIndex);
-					DebugSurfel.SourceSurfelIndex = SourceSurfelOffset + SurfelIndex;
-					DebugSurfel.Type = FLumenCardBuildDebugData::ESurfelType::Cluster;
-					DebugCluster.Surfels.Add(DebugSurfel);
-
-					const int32 SurfelMinRayZ = Surfels[SurfelIndex].MinRayZ;
-					if (SurfelMinRayZ > 0)
-					{
-						FIntVector MinRayZCoord = Surfels[SurfelIndex].Coord;
-						MinRayZCoord.Z = SurfelMinRayZ;
-
-						FLumenCardBuildDebugData::FRay DebugRay;
-						DebugRay.RayStart = DebugSurfel.Position;
-						DebugRay.RayEnd = ClusterBasis.TransformSurfel(MinRayZCoord);
-						DebugRay.bHit = false;
-						DebugCluster.Rays.Add(DebugRay);
-					}
+					DebugSurfelInCluster.Reset();
+					DebugSurfelInCluster.Add(false, Surfels.Num());
 
-					DebugSurfelInAnyCluster[SurfelIndex] = true;
-					DebugSurfelInCluster[SurfelIndex] = true;
-				}
+					FLumenCardBuildDebugData::FSurfelCluster& DebugCluster = DebugClustersPerDirection[AxisAlignedDirectionIndex].AddDefaulted_GetRef();
+					DebugCluster.Surfels.Reserve(DebugCluster.Surfels.Num() + Surfels.Num());
 
-				for (FSurfelIndex SurfelIndex = 0; SurfelIndex < Surfels.Num(); ++SurfelIndex)
-				{
-					if (!DebugSurfelInCluster[SurfelIndex])
+					for (FSurfelIndex SurfelIndex : Cluster.SurfelIndices)
 					{
 						FLumenCardBuildDebugData::FSurfel DebugSurfel;
 						DebugSurfel.Position = ClusterBasis.TransformSurfel(Surfels[SurfelIndex].Coord);
 						DebugSurfel.Normal = AxisAlignedDirectionIndexToNormal(AxisAlignedDirectionIndex);
-						DebugSurfel.SourceSurfelIndex = SourceSurfelOffset + SurfelIndex;
-						DebugSurfel.Type = DebugSurfelInAnyCluster[SurfelIndex] ? FLumenCardBuildDebugData::ESurfelType::Used : FLumenCardBuildDebugData::ESurfelType::Idle;
+						DebugSurfel.SourceSurfelIndex = SourceSurfelOffsets[AxisAlignedDirectionIndex] + SurfelIndex;
+						DebugSurfel.Type = FLumenCardBuildDebugData::ESurfelType::Cluster;
 						DebugCluster.Surfels.Add(DebugSurfel);
+
+						const int32 SurfelMinRayZ = Surfels[SurfelIndex].MinRayZ;
+						if (SurfelMinRayZ > 0)
+						{
+							FIntVector MinRayZCoord = Surfels[SurfelIndex].Coord;
+							MinRayZCoord.Z = SurfelMinRayZ;
+
+							FLumenCardBuildDebugData::FRay DebugRay;
+							DebugRay.RayStart = DebugSurfel.Position;
+							DebugRay.RayEnd = ClusterBasis.TransformSurfel(MinRayZCoord);
+							DebugRay.bHit = false;
+							DebugCluster.Rays.Add(DebugRay);
+						}
+
+						DebugSurfelInAnyCluster[SurfelIndex] = true;
+						DebugSurfelInCluster[SurfelIndex] = true;
+					}
+
+					for (FSurfelIndex SurfelIndex = 0; SurfelIndex < Surfels.Num(); ++SurfelIndex)
+					{
+						if (!DebugSurfelInCluster[SurfelIndex])
+						{
+							FLumenCardBuildDebugData::FSurfel DebugSurfel;
+							DebugSurfel.Position = ClusterBasis.TransformSurfel(Surfels[SurfelIndex].Coord);
+							DebugSurfel.Normal = AxisAlignedDirectionIndexToNormal(AxisAlignedDirectionIndex);
+							DebugSurfel.SourceSurfelIndex = SourceSurfelOffsets[AxisAlignedDirectionIndex] + SurfelIndex;
+							DebugSurfel.Type = DebugSurfelInAnyCluster[SurfelIndex] ? FLumenCardBuildDebugData::ESurfelType::Used : FLumenCardBuildDebugData::ESurfelType::Idle;
+							DebugCluster.Surfels.Add(DebugSurfel);
+						}
 					}
 				}
 			}
-		}
+		}, ClusteringParams.bSingleThreadedBuild ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
 
-		SourceSurfelOffset += Surfels.Num();
+	for (int32 AxisAlignedDirectionIndex = 0; AxisAlignedDirectionIndex < MeshCardGen::NumAxisAlignedDirections; ++AxisAlignedDirectionIndex)
+	{
+		MeshCardsBuildData.CardBuildData.Append(MoveTemp(CardBuildDataPerDirection[AxisAlignedDirectionIndex]));
+		MeshCardsBuildData.DebugData.Clusters.Append(MoveTemp(DebugClustersPerDirection[AxisAlignedDirectionIndex]));
 	}
 
 	if (ClusteringParams.bDebug)
@@ -1058,13 +1231,53 @@ bool GenerateCardRepresentation(FRealtimeMeshCardRepresentation& OutCardRepresen
 	const FVector MeshCardsBoundsExtent = FVector::Max(MeshBounds.GetExtent() + 1.0f, FVector(1.0f));
 	const FBox MeshCardsBounds(MeshCardsBoundsCenter - MeshCardsBoundsExtent, MeshCardsBoundsCenter + MeshCardsBoundsExtent);
 
+	// Reuse the previous generation's resolution and clusters if the mesh still maps to the same voxel grid
+	float MaxVoxels = 64;
+	TArray<int32> SeedNearPlanes[MeshCardGen::NumAxisAlignedDirections];
+	bool bHasSeeds = false;
+	if (Options.IncrementalState.IsValid())
+	{
+		FScopeLock Lock(&Options.IncrementalState->Lock);
+		if (Options.IncrementalState->bValid)
+		{
+			FClusteringParams CandidateParams;
+			InitClusteringParams(CandidateParams, MeshCardsBounds, Options.IncrementalState->MaxVoxels, Options.MaxLumenMeshCards, !Options.bMultiThreadedGeneration);
+			if (IsSameVoxelGrid(CandidateParams, Options.IncrementalState->ClusteringParams))
+			{
+				MaxVoxels = Options.IncrementalState->MaxVoxels;
+				for (int32 AxisAlignedDirectionIndex = 0; AxisAlignedDirectionIndex < MeshCardGen::NumAxisAlignedDirections; ++AxisAlignedDirectionIndex)
+				{
+					SeedNearPlanes[AxisAlignedDirectionIndex] = Options.IncrementalState->NearPlanes[AxisAlignedDirectionIndex];
+				}
+				bHasSeeds = true;
+			}
+		}
+	}
+
 	// Prepare a list of surfels for cluster fitting
 	FSurfelScene SurfelScene;
 	FClusteringParams ClusteringParams;
-	InitSurfelScene(Context, MeshCardsBounds, Options.MaxLumenMeshCards, !Options.bMultiThreadedGeneration, SurfelScene, ClusteringParams);
+	const float InitialMaxVoxels = MaxVoxels;
+	InitSurfelScene(Context, MeshCardsBounds, Options.MaxLumenMeshCards, !Options.bMultiThreadedGeneration, MaxVoxels, SurfelScene, ClusteringParams);
+
+	// The surfel budget may still have forced a coarser grid, in which case the old near planes no longer line up
+	bHasSeeds &= MaxVoxels == InitialMaxVoxels;
 
 	FMeshCards MeshCards;
-	BuildSurfelClusters(MeshBounds, Context, SurfelScene, ClusteringParams, MeshCards);
+	TArray<int32> NearPlanes[MeshCardGen::NumAxisAlignedDirections];
+	BuildSurfelClusters(MeshBounds, Context, SurfelScene, ClusteringParams, bHasSeeds ? SeedNearPlanes : nullptr, NearPlanes, MeshCards);
+
+	if (Options.IncrementalState.IsValid())
+	{
+		FScopeLock Lock(&Options.IncrementalState->Lock);
+		Options.IncrementalState->bValid = true;
+		Options.IncrementalState->MaxVoxels = MaxVoxels;
+		Options.IncrementalState->ClusteringParams = ClusteringParams;
+		for (int32 AxisAlignedDirectionIndex = 0; AxisAlignedDirectionIndex < MeshCardGen::NumAxisAlignedDirections; ++AxisAlignedDirectionIndex)
+		{
+			Options.IncrementalState->NearPlanes[AxisAlignedDirectionIndex] = MoveTemp(NearPlanes[AxisAlignedDirectionIndex]);
+		}
+	}
 
 	CardRepresentation.MeshCardsBuildData.Bounds = MeshCardsBounds;
 #if RMC_ENGINE_ABOVE_5_2
@@ -1087,7 +1300,10 @@ bool GenerateCardRepresentation(FRealtimeMeshCardRepresentation& OutCardRepresen
 }
 
 
-
+TSharedRef<FRealtimeMeshCardGenerationState, ESPMode::ThreadSafe> URealtimeMeshCardRepresentationGenerator::MakeIncrementalState()
+{
+	return MakeShared<FRealtimeMeshCardGenerationState, ESPMode::ThreadSafe>();
+}
 
 ERealtimeMeshOutcomePins URealtimeMeshCardRepresentationGenerator::GenerateCardRepresentationForStreamSet(const FRealtimeMeshStreamSet& StreamSet, const FRealtimeMeshAABBTree3& StreamSetBVH,
 	const FRealtimeMeshDistanceField& DistanceField, FRealtimeMeshCardRepresentation& CardRepresentation, FRealtimeMeshCardRepresentationGeneratorOptions Options)
@@ -7,6 +7,8 @@
 #include "Mesh/RealtimeMeshBlueprintMeshBuilder.h"
 #include "Mesh/RealtimeMeshBuilder.h"
 #include "MeshOptimizer/meshoptimizer.h"
+#include "RealtimeMeshThreadingSubsystem.h"
+#include "Async/Async.h"
 
 using namespace RealtimeMesh;
 
@@ -38,7 +40,8 @@ static void RemapAllVertexStreams(FRealtimeMeshStreamSet& Streams, const TArray<
 {
 	for (int32 Index = 0; Index < RemapTable.Num(); Index++)
 	{
-		check(RemapTable[Index] < (uint32)NewVertexCount);
+		// ~0u is meshoptimizer's marker for a vertex no triangle uses, it just gets dropped
+		check(RemapTable[Index] < (uint32)NewVertexCount || RemapTable[Index] == ~0u);
 	}
 
 	
@@ -76,17 +79,8 @@ static void RemapTriangleStream(FRealtimeMeshStreamSet& Streams, const TArray<ui
 	Streams.AddStream(MoveTemp(NewTriangleStream));
 }
 
-void URealtimeMeshDataOptimizer::OptimizeMeshIndexing(RealtimeMesh::FRealtimeMeshStreamSet& Streams)
+static void GatherVertexRemapStreams(FRealtimeMeshStreamSet& Streams, TArray<meshopt_Stream>& OptStreams, int32& VertexCount)
 {
-	// Check that we have vertex data to index
-	if (!ensure(Streams.Contains(FRealtimeMeshStreams::Position) && Streams.Contains(FRealtimeMeshStreams::Triangles)))
-	{
-		return;
-	}	
-	
-	TArray<meshopt_Stream> OptStreams;
-	int32 VertexCount = INDEX_NONE;
-
 	auto AddStream = [&](const FRealtimeMeshStreamKey& StreamKey)
 	{	
 		if (auto* NewStream = Streams.Find(StreamKey))
@@ -108,6 +102,48 @@ void URealtimeMeshDataOptimizer::OptimizeMeshIndexing(RealtimeMesh::FRealtimeMes
 	AddStream(FRealtimeMeshStreams::Tangents);
 	AddStream(FRealtimeMeshStreams::TexCoords);
 	AddStream(FRealtimeMeshStreams::Color);
+}
+
+/* Calls Func for each run of triangles sharing a polygroup, or once for the whole mesh if there are no polygroups */
+static void ForEachPolyGroupSection(FRealtimeMeshStreamSet& Streams, int32 NumTriangles, TFunctionRef<void(int32 TriangleOffset, int32 TriangleCount)> Func)
+{
+	if (!Streams.Contains(FRealtimeMeshStreams::PolyGroups))
+	{
+		Func(0, NumTriangles);
+		return;
+	}
+
+	TRealtimeMeshStreamBuilder<uint32, void> PolyGroups(Streams.FindChecked(FRealtimeMeshStreams::PolyGroups));
+	const int32 MaxNumTriangles = FMath::Min(NumTriangles, PolyGroups.Num());
+
+	int32 TriangleOffset = 0;
+	for (int32 Index = 1; Index <= MaxNumTriangles; Index++)
+	{
+		if (Index == MaxNumTriangles || PolyGroups[Index] != PolyGroups[TriangleOffset])
+		{
+			Func(TriangleOffset, Index - TriangleOffset);
+			TriangleOffset = Index;
+		}
+	}
+
+	// Any triangles past the end of the polygroups are treated as one last section
+	if (MaxNumTriangles < NumTriangles)
+	{
+		Func(MaxNumTriangles, NumTriangles - MaxNumTriangles);
+	}
+}
+
+void URealtimeMeshDataOptimizer::OptimizeMeshIndexing(RealtimeMesh::FRealtimeMeshStreamSet& Streams)
+{
+	// Check that we have vertex data to index
+	if (!ensure(Streams.Contains(FRealtimeMeshStreams::Position) && Streams.Contains(FRealtimeMeshStreams::Triangles)))
+	{
+		return;
+	}	
+	
+	TArray<meshopt_Stream> OptStreams;
+	int32 VertexCount = INDEX_NONE;
+	GatherVertexRemapStreams(Streams, OptStreams, VertexCount);
 
 	if (OptStreams.Num() == 0)
 	{
@@ -154,7 +190,7 @@ void URealtimeMeshDataOptimizer::OptimizeMeshIndexing(RealtimeMesh::FRealtimeMes
 
 	for (int32 Index = 0; Index < RemapTable.Num(); Index++)
 	{
-		check(RemapTable[Index] < (uint32)NewVertexCount);
+		check(RemapTable[Index] < (uint32)NewVertexCount || RemapTable[Index] == ~0u);
 	}
 
 	// Sort the index stream
@@ -242,45 +278,7 @@ void URealtimeMeshDataOptimizer::OptimizeOverdraw(RealtimeMesh::FRealtimeMeshStr
 		}
 	};
 
-	if (Streams.Contains(FRealtimeMeshStreams::PolyGroups))
-	{
-		TRealtimeMeshStreamBuilder<uint32, void> PolyGroups(Streams.FindChecked(FRealtimeMeshStreams::PolyGroups));
-		
-		int32 TriangleOffset = 0;
-		int32 TriangleCount = 0;
-
-		const int32 MaxNumTriangles = FMath::Min((Triangles.Num() * Triangles.GetNumElements()) / 3, PolyGroups.Num());
-
-		uint32 CurrentPolyGroup = 0;
-		for (int32 Index = 0; Index < MaxNumTriangles; Index++)
-		{
-			const uint32 TriangleGroup = PolyGroups[Index];
-			const bool bChangingPolyGroup = TriangleGroup != CurrentPolyGroup;
-
-			if (!bChangingPolyGroup)
-			{
-				TriangleCount++;
-				continue;
-			}
-
-			if (TriangleCount > 0)
-			{
-				OptimizeSection(TriangleOffset, TriangleCount);
-			}
-
-			// Reset trackers for the next group
-			CurrentPolyGroup = TriangleGroup;
-			TriangleOffset = Index;
-			TriangleCount = 1;	
-		}		
-	}
-	else
-	{
-		const int32 TriangleOffset = 0;
-		const int32 TriangleCount = (Triangles.Num() * Triangles.GetNumElements()) / 3;
-
-		OptimizeSection(TriangleOffset, TriangleCount);
-	}	
+	ForEachPolyGroupSection(Streams, (Triangles.Num() * Triangles.GetNumElements()) / 3, OptimizeSection);
 }
 
 void URealtimeMeshDataOptimizer::OptimizeVertexFetch(RealtimeMesh::FRealtimeMeshStreamSet& Streams)
@@ -326,6 +324,266 @@ void URealtimeMeshDataOptimizer::OptimizeVertexFetch(RealtimeMesh::FRealtimeMesh
 	RemapAllVertexStreams(Streams, RemapTable, NewVertexCount);
 }
 
+template <typename IndexType>
+static void OptimizeMeshImpl(FRealtimeMeshStreamSet& Streams, const FRealtimeMeshOptimizationSettings& Settings)
+{
+	const FRealtimeMeshStream& Positions = Streams.FindChecked(FRealtimeMeshStreams::Position);
+	FRealtimeMeshStream& Triangles = Streams.FindChecked(FRealtimeMeshStreams::Triangles);
+
+	const int32 IndexCount = Triangles.Num() * Triangles.GetNumElements();
+	const int32 VertexCount = Positions.Num();
+	if (IndexCount < 3 || VertexCount == 0)
+	{
+		return;
+	}
+
+	// All the steps work on this copy, the triangle stream is written back once at the end
+	TArray<IndexType> Indices;
+	Indices.SetNumUninitialized(IndexCount);
+	FMemory::Memcpy(Indices.GetData(), Triangles.GetData(), IndexCount * sizeof(IndexType));
+
+	// Maps original vertices to their final slot, composed across the steps so the vertex streams are only remapped once
+	TArray<uint32> RemapTable;
+	int32 NewVertexCount = VertexCount;
+
+	if (Settings.bOptimizeIndexing)
+	{
+		TArray<meshopt_Stream> OptStreams;
+		int32 StreamVertexCount = INDEX_NONE;
+		GatherVertexRemapStreams(Streams, OptStreams, StreamVertexCount);
+
+		if (OptStreams.Num() > 0)
+		{
+			RemapTable.SetNumUninitialized(VertexCount);
+			NewVertexCount = meshopt_generateVertexRemapMulti<IndexType>(RemapTable.GetData(), Indices.GetData(), IndexCount, VertexCount,
+				OptStreams.GetData(), OptStreams.Num());
+			meshopt_remapIndexBuffer<IndexType>(Indices.GetData(), Indices.GetData(), IndexCount, RemapTable.GetData());
+		}
+	}
+
+	// Overdraw needs positions that match the scratch indices, only worth building when indexing moved them
+	TArray<FVector3f> RemappedPositions;
+	const float* OverdrawPositions = reinterpret_cast<const float*>(Positions.GetData<FVector3f>());
+	int32 OverdrawPositionStride = Positions.GetStride();
+	if (Settings.bOptimizeOverdraw && RemapTable.Num() > 0)
+	{
+		RemappedPositions.SetNumUninitialized(NewVertexCount);
+		for (int32 Index = 0; Index < VertexCount; Index++)
+		{
+			if (RemapTable[Index] != ~0u)
+			{
+				RemappedPositions[RemapTable[Index]] = *reinterpret_cast<const FVector3f*>(Positions.GetData() + Index * Positions.GetStride());
+			}
+		}
+		OverdrawPositions = reinterpret_cast<const float*>(RemappedPositions.GetData());
+		OverdrawPositionStride = sizeof(FVector3f);
+	}
+
+	if (Settings.bOptimizeVertexCache || Settings.bOptimizeOverdraw)
+	{
+		ForEachPolyGroupSection(Streams, IndexCount / 3, [&](int32 TriangleOffset, int32 TriangleCount)
+		{
+			IndexType* SectionIndices = Indices.GetData() + TriangleOffset * 3;
+			const int32 SectionIndexCount = TriangleCount * 3;
+			
+			if (Settings.bOptimizeVertexCache)
+			{
+				if (Settings.VertexCacheQuality == ERealtimeMeshOptimizationQuality::RenderingEfficiency)
+				{
+					meshopt_optimizeVertexCache<IndexType>(SectionIndices, SectionIndices, SectionIndexCount, NewVertexCount);
+				}
+				else
+				{
+					meshopt_optimizeVertexCacheFifo<IndexType>(SectionIndices, SectionIndices, SectionIndexCount, NewVertexCount, /* Cache Size */ 16);
+				}
+			}
+
+			if (Settings.bOptimizeOverdraw)
+			{
+				meshopt_optimizeOverdraw<IndexType>(SectionIndices, SectionIndices, SectionIndexCount, OverdrawPositions,
+					NewVertexCount, OverdrawPositionStride, Settings.OverdrawThreshold);
+			}
+		});
+	}
+
+	if (Settings.bOptimizeVertexFetch)
+	{
+		TArray<uint32> FetchRemapTable;
+		FetchRemapTable.SetNumUninitialized(NewVertexCount);
+		NewVertexCount = meshopt_optimizeVertexFetchRemap<IndexType>(FetchRemapTable.GetData(), Indices.GetData(), IndexCount, FetchRemapTable.Num());
+		meshopt_remapIndexBuffer<IndexType>(Indices.GetData(), Indices.GetData(), IndexCount, FetchRemapTable.GetData());
+
+		if (RemapTable.Num() > 0)
+		{
+			for (uint32& Remap : RemapTable)
+			{
+				Remap = Remap != ~0u ? FetchRemapTable[Remap] : ~0u;
+			}
+		}
+		else
+		{
+			RemapTable = MoveTemp(FetchRemapTable);
+		}
+	}
+
+	FMemory::Memcpy(Triangles.GetData(), Indices.GetData(), IndexCount * sizeof(IndexType));
+
+	if (RemapTable.Num() > 0)
+	{
+		RemapAllVertexStreams(Streams, RemapTable, NewVertexCount);
+	}
+}
+
+void URealtimeMeshDataOptimizer::OptimizeMesh(RealtimeMesh::FRealtimeMeshStreamSet& Streams, const RealtimeMesh::FRealtimeMeshOptimizationSettings& Settings)
+{
+	// Check that we have vertex data to index
+	if (!ensure(Streams.Contains(FRealtimeMeshStreams::Position) && Streams.Contains(FRealtimeMeshStreams::Triangles)))
+	{
+		return;
+	}
+
+	if (Streams.FindChecked(FRealtimeMeshStreams::Triangles).GetElementStride() == sizeof(uint16))
+	{
+		OptimizeMeshImpl<uint16>(Streams, Settings);
+	}
+	else
+	{
+		OptimizeMeshImpl<uint32>(Streams, Settings);
+	}
+}
+
+TFuture<RealtimeMesh::FRealtimeMeshStreamSet> URealtimeMeshDataOptimizer::OptimizeMeshAsync(RealtimeMesh::FRealtimeMeshStreamSet&& Streams,
+	const RealtimeMesh::FRealtimeMeshOptimizationSettings& Settings)
+{
+	URealtimeMeshThreadingSubsystem* ThreadingSubsystem = URealtimeMeshThreadingSubsystem::Get();
+	FQueuedThreadPool& ThreadPool = ThreadingSubsystem? ThreadingSubsystem->GetThreadPool() : *GThreadPool;
+
+	return AsyncPool(ThreadPool, [Streams = MoveTemp(Streams), Settings]() mutable
+	{
+		OptimizeMesh(Streams, Settings);
+		return MoveTemp(Streams);
+	});
+}
+
+TArray<TFuture<RealtimeMesh::FRealtimeMeshStreamSet>> URealtimeMeshDataOptimizer::OptimizeMeshesAsync(TArray<RealtimeMesh::FRealtimeMeshStreamSet>&& StreamSets,
+	const RealtimeMesh::FRealtimeMeshOptimizationSettings& Settings)
+{
+	TArray<TFuture<FRealtimeMeshStreamSet>> Futures;
+	Futures.Reserve(StreamSets.Num());
+	for (FRealtimeMeshStreamSet& Streams : StreamSets)
+	{
+		Futures.Add(OptimizeMeshAsync(MoveTemp(Streams), Settings));
+	}
+	StreamSets.Empty();
+	return Futures;
+}
+
+void URealtimeMeshDataOptimizer::EncodeStreamSet(const RealtimeMesh::FRealtimeMeshStreamSet& Streams, RealtimeMesh::FRealtimeMeshEncodedStreamSet& OutEncoded)
+{
+	using FEncodedStream = FRealtimeMeshEncodedStreamSet::FEncodedStream;
+	using ECodec = FRealtimeMeshEncodedStreamSet::ECodec;
+
+	OutEncoded.Empty();
+	OutEncoded.Streams.Reserve(Streams.Num());
+
+	Streams.ForEach([&](const FRealtimeMeshStream& Stream)
+	{
+		FEncodedStream& Encoded = OutEncoded.Streams.Emplace_GetRef();
+		Encoded.StreamKey = Stream.GetStreamKey();
+		Encoded.Layout = Stream.GetLayout();
+		Encoded.Num = Stream.Num();
+
+		if (Stream.Num() == 0)
+		{
+			return;
+		}
+
+		const int32 Stride = Stream.GetStride();
+		const int32 ElementStride = Stream.GetElementStride();
+		const int32 IndexCount = Stream.Num() * Stream.GetNumElements();
+		
+		// The index codec only understands triangle lists, everything else on the index side falls back to raw
+		const bool bIsTriangleList = Stream.GetStreamType() == ERealtimeMeshStreamType::Index &&
+			Stream.GetNumElements() == 3 && (ElementStride == sizeof(uint16) || ElementStride == sizeof(uint32));
+
+		if (bIsTriangleList)
+		{
+			// Indices are read raw so signed and unsigned index types both work
+			uint32 MaxIndex = 0;
+			for (int32 Index = 0; Index < IndexCount; Index++)
+			{
+				const uint32 Value = ElementStride == sizeof(uint32)
+					? reinterpret_cast<const uint32*>(Stream.GetData())[Index]
+					: reinterpret_cast<const uint16*>(Stream.GetData())[Index];
+				MaxIndex = FMath::Max(MaxIndex, Value);
+			}
+
+			Encoded.Codec = ECodec::Index;
+			Encoded.Data.SetNumUninitialized((int32)meshopt_encodeIndexBufferBound(IndexCount, MaxIndex + 1));
+			const size_t EncodedSize = ElementStride == sizeof(uint32)
+				? meshopt_encodeIndexBuffer(Encoded.Data.GetData(), Encoded.Data.Num(), reinterpret_cast<const uint32*>(Stream.GetData()), IndexCount)
+				: meshopt_encodeIndexBuffer(Encoded.Data.GetData(), Encoded.Data.Num(), reinterpret_cast<const uint16*>(Stream.GetData()), IndexCount);
+			Encoded.Data.SetNum((int32)EncodedSize, true);
+		}
+		else if (Stream.GetStreamType() == ERealtimeMeshStreamType::Vertex && Stride % 4 == 0 && Stride <= 256)
+		{
+			Encoded.Codec = ECodec::Vertex;
+			Encoded.Data.SetNumUninitialized((int32)meshopt_encodeVertexBufferBound(Stream.Num(), Stride));
+			const size_t EncodedSize = meshopt_encodeVertexBuffer(Encoded.Data.GetData(), Encoded.Data.Num(), Stream.GetData(), Stream.Num(), Stride);
+			Encoded.Data.SetNum((int32)EncodedSize, true);
+		}
+		else
+		{
+			Encoded.Codec = ECodec::Raw;
+			Encoded.Data.SetNumUninitialized(Stream.Num() * Stride);
+			FMemory::Memcpy(Encoded.Data.GetData(), Stream.GetData(), Encoded.Data.Num());
+		}
+	});
+}
+
+bool URealtimeMeshDataOptimizer::DecodeStreamSet(const RealtimeMesh::FRealtimeMeshEncodedStreamSet& Encoded, RealtimeMesh::FRealtimeMeshStreamSet& OutStreams)
+{
+	using FEncodedStream = FRealtimeMeshEncodedStreamSet::FEncodedStream;
+	using ECodec = FRealtimeMeshEncodedStreamSet::ECodec;
+
+	OutStreams.Empty();
+
+	bool bSucceeded = true;
+	for (const FEncodedStream& EncodedStream : Encoded.Streams)
+	{
+		FRealtimeMeshStream Stream(EncodedStream.StreamKey, EncodedStream.Layout);
+		Stream.SetNumUninitialized(EncodedStream.Num);
+
+		if (EncodedStream.Num > 0)
+		{
+			switch (EncodedStream.Codec)
+			{
+			case ECodec::Index:
+				bSucceeded &= meshopt_decodeIndexBuffer(Stream.GetData(), EncodedStream.Num * Stream.GetNumElements(), Stream.GetElementStride(),
+					EncodedStream.Data.GetData(), EncodedStream.Data.Num()) == 0;
+				break;
+			case ECodec::Vertex:
+				bSucceeded &= meshopt_decodeVertexBuffer(Stream.GetData(), EncodedStream.Num, Stream.GetStride(),
+					EncodedStream.Data.GetData(), EncodedStream.Data.Num()) == 0;
+				break;
+			default:
+				check(EncodedStream.Data.Num() == EncodedStream.Num * Stream.GetStride());
+				FMemory::Memcpy(Stream.GetData(), EncodedStream.Data.GetData(), EncodedStream.Data.Num());
+				break;
+			}
+		}
+
+		OutStreams.AddStream(MoveTemp(Stream));
+	}
+
+	if (!bSucceeded)
+	{
+		UE_LOG(RealtimeMeshLog, Warning, TEXT("DecodeStreamSet: Failed to decode one or more streams"));
+		OutStreams.Empty();
+	}
+	return bSucceeded;
+}
+
 void URealtimeMeshDataOptimizer::OptimizeMeshIndexing(URealtimeMeshStreamSet* Streams)
 {
 	if (!Streams)
@@ -19,6 +19,41 @@
 using namespace UE::Geometry;
 using namespace RealtimeMesh;
 
+bool RealtimeMesh::FRealtimeMeshHeightfield::IsValid() const
+{
+	return Size.X >= 2 && Size.Y >= 2 && Heights.Num() == Size.X * Size.Y && Spacing.X > 0.0f && Spacing.Y > 0.0f;
+}
+
+float RealtimeMesh::FRealtimeMeshHeightfield::SampleHeight(const FVector2f& Position) const
+{
+	const FVector2f GridPosition = (Position - Origin) / Spacing;
+	const float X = FMath::Clamp(GridPosition.X, 0.0f, (float)(Size.X - 1));
+	const float Y = FMath::Clamp(GridPosition.Y, 0.0f, (float)(Size.Y - 1));
+	const int32 X0 = FMath::Min(FMath::FloorToInt(X), Size.X - 2);
+	const int32 Y0 = FMath::Min(FMath::FloorToInt(Y), Size.Y - 2);
+	const float AlphaX = X - X0;
+	const float AlphaY = Y - Y0;
+
+	return FMath::Lerp(
+		FMath::Lerp(GetHeight(X0, Y0), GetHeight(X0 + 1, Y0), AlphaX),
+		FMath::Lerp(GetHeight(X0, Y0 + 1), GetHeight(X0 + 1, Y0 + 1), AlphaX),
+		AlphaY);
+}
+
+FBox RealtimeMesh::FRealtimeMeshHeightfield::GetBounds() const
+{
+	float MinHeight = MAX_flt;
+	float MaxHeight = -MAX_flt;
+	for (const float Height : Heights)
+	{
+		MinHeight = FMath::Min(MinHeight, Height);
+		MaxHeight = FMath::Max(MaxHeight, Height);
+	}
+
+	const FVector2f Max = Origin + FVector2f(Size - FIntPoint(1, 1)) * Spacing;
+	return FBox(FVector(Origin.X, Origin.Y, MinHeight), FVector(Max.X, Max.Y, MaxHeight));
+}
+
 namespace RealtimeMesh::DistanceFieldGen
 {
 	static int32 ComputeLinearVoxelIndex(UE::Math::TIntVector3<int32> VoxelCoordinate, UE::Math::TIntVector3<int32> VolumeDimensions)
@@ -36,8 +71,8 @@ namespace RealtimeMesh::DistanceFieldGen
 		UE::Math::TIntVector3<int32> IndirectionSize;
 
 	
-		uint8 OutBrickMaxDistance;
-		uint8 OutBrickMinDistance;
+		uint8 OutBrickMaxDistance = MIN_uint8;
+		uint8 OutBrickMinDistance = MAX_uint8;
 		TArray<uint8> OutDistanceFieldVolume;
 	};
 
@@ -137,35 +172,23 @@ namespace RealtimeMesh::DistanceFieldGen
 		}
 	}
 
-	template<typename MeshType>
-	bool GenerateDistanceField(FRealtimeMeshDistanceField& OutDistanceField, const MeshType& Mesh, const TMeshAABBTree3<MeshType>& MeshBVH,
-		const FRealtimeMeshDistanceFieldGeneratorOptions& Options)
-	{
-		// TODO: Should we check validity of the mesh/spatial structures
+	/**
+	 * Fills every brick of one mip. All bricks share the volume bounds, indirection size and encoding,
+	 * only BrickCoordinate differs between them.
+	 */
+	using FGenerateBricksFunc = TFunctionRef<void(TArray<FDistanceFieldGenerationTask>& Bricks)>;
 
+	/** Lays out the sparse volume for the given bounds and packs the bricks produced by GenerateBricks into the mips. */
+	static bool BuildDistanceField(FRealtimeMeshDistanceField& OutDistanceField, const FBox& MeshBounds,
+		const FRealtimeMeshDistanceFieldGeneratorOptions& Options, FGenerateBricksFunc GenerateBricks)
+	{
 		if (Options.DistanceFieldResolutionScale <= 0.0f)
 		{
 			UE_LOG(RealtimeMeshLog, Warning, TEXT("URealtimeMeshDistanceFieldGeneration: Generation Failed: ResolutionScale must be greater than 0"));
 			OutDistanceField = FRealtimeMeshDistanceField();
 			return false;
 		}
-	
-		TArray<FVector3f> SampleDirections;
-		{
-			const int32 NumVoxelDistanceSamples = Options.bUsePointQuery ? 49 : 576;
-			FRandomStream RandomStream(0);
-			FRealtimeMeshRepresentationCommon::GenerateStratifiedUniformHemisphereSamples(NumVoxelDistanceSamples, RandomStream, SampleDirections);
-			TArray<FVector3f> OtherHemisphereSamples;
-			FRealtimeMeshRepresentationCommon::GenerateStratifiedUniformHemisphereSamples(NumVoxelDistanceSamples, RandomStream, OtherHemisphereSamples);
 
-			for (int32 i = 0; i < OtherHemisphereSamples.Num(); i++)
-			{
-				FVector3f Sample = OtherHemisphereSamples[i];
-				Sample.Z *= -1.0f;
-				SampleDirections.Add(Sample);
-			}
-		}
-	
 		static const auto CVar = IConsoleManager::Get().FindTConsoleVariableDataInt(TEXT("r.DistanceFields.MaxPerMeshResolution"));
 		const int32 PerMeshMax = CVar->GetValueOnAnyThread();
 
@@ -177,7 +200,7 @@ namespace RealtimeMesh::DistanceFieldGen
 		const float VoxelDensity = CVarDensity->GetValueOnAnyThread();
 
 		const float NumVoxelsPerLocalSpaceUnit = VoxelDensity * Options.DistanceFieldResolutionScale;
-		FBox LocalSpaceMeshBounds(MeshBVH.GetBoundingBox());
+		FBox LocalSpaceMeshBounds(MeshBounds);
 	
 		// Make sure the mesh bounding box has positive extents to handle planes
 		{
@@ -254,16 +277,7 @@ namespace RealtimeMesh::DistanceFieldGen
 				}
 			}
 
-
-#if RMC_ENGINE_ABOVE_5_1
-			ParallelFor(TEXT("RealtimeMeshDistanceFieldGeneration.PF"), AsyncTasks.Num(), 1,
-#else
-			ParallelFor(AsyncTasks.Num(),
-#endif
-				[&AsyncTasks, &Mesh, &MeshBVH, &Options, &SampleDirections](int32 TaskIndex)
-				{
-					DoGen(AsyncTasks[TaskIndex], Mesh, MeshBVH, Options, SampleDirections);				
-				}, (Options.bMultiThreadedGeneration? EParallelForFlags::BackgroundPriority | EParallelForFlags::Unbalanced : EParallelForFlags::ForceSingleThread));	
+			GenerateBricks(AsyncTasks);
 
 			FSparseDistanceFieldMip& OutMip = OutVolumeData.Mips[MipIndex];
 			TArray<uint32> IndirectionTable;
@@ -393,11 +407,266 @@ namespace RealtimeMesh::DistanceFieldGen
 				FMath::RoundToInt(100.0f * OutData.Mips[0].NumDistanceFieldBricks / (float)(Mip0IndirectionDimensions.X * Mip0IndirectionDimensions.Y * Mip0IndirectionDimensions.Z)),
 				EmbreeScene.NumIndices / 3,
 				*MeshName);
-		}#1#
+		}*/
 
-		OutDistanceField = FRealtimeMeshDistanceField(MoveTemp(OutVolumeData));*/
+		OutDistanceField = FRealtimeMeshDistanceField(MoveTemp(OutVolumeData));
 		return true;
 	}
+
+	template<typename MeshType>
+	bool GenerateDistanceField(FRealtimeMeshDistanceField& OutDistanceField, const MeshType& Mesh, const TMeshAABBTree3<MeshType>& MeshBVH,
+		const FRealtimeMeshDistanceFieldGeneratorOptions& Options)
+	{
+		// TODO: Should we check validity of the mesh/spatial structures
+
+		TArray<FVector3f> SampleDirections;
+		{
+			const int32 NumVoxelDistanceSamples = Options.bUsePointQuery ? 49 : 576;
+			FRandomStream RandomStream(0);
+			FRealtimeMeshRepresentationCommon::GenerateStratifiedUniformHemisphereSamples(NumVoxelDistanceSamples, RandomStream, SampleDirections);
+			TArray<FVector3f> OtherHemisphereSamples;
+			FRealtimeMeshRepresentationCommon::GenerateStratifiedUniformHemisphereSamples(NumVoxelDistanceSamples, RandomStream, OtherHemisphereSamples);
+
+			for (int32 i = 0; i < OtherHemisphereSamples.Num(); i++)
+			{
+				FVector3f Sample = OtherHemisphereSamples[i];
+				Sample.Z *= -1.0f;
+				SampleDirections.Add(Sample);
+			}
+		}
+
+		return BuildDistanceField(OutDistanceField, FBox(MeshBVH.GetBoundingBox()), Options,
+			[&Mesh, &MeshBVH, &Options, &SampleDirections](TArray<FDistanceFieldGenerationTask>& AsyncTasks)
+			{
+#if RMC_ENGINE_ABOVE_5_1
+				ParallelFor(TEXT("RealtimeMeshDistanceFieldGeneration.PF"), AsyncTasks.Num(), 1,
+#else
+				ParallelFor(AsyncTasks.Num(),
+#endif
+					[&AsyncTasks, &Mesh, &MeshBVH, &Options, &SampleDirections](int32 TaskIndex)
+					{
+						DoGen(AsyncTasks[TaskIndex], Mesh, MeshBVH, Options, SampleDirections);
+					}, (Options.bMultiThreadedGeneration? EParallelForFlags::BackgroundPriority | EParallelForFlags::Unbalanced : EParallelForFlags::ForceSingleThread));
+			});
+	}
+
+	/**
+	 * Exact 1D squared distance transform of a sampled function [Felzenszwalb & Huttenlocher 2012, "Distance Transforms of Sampled Functions"].
+	 * Out[P] = min over Q of ((P - Q) * Spacing)^2 + In[Q]. Vertices and Boundaries are scratch of size Num and Num + 1.
+	 */
+	static void SquaredDistanceTransform1D(const float* In, float* Out, int32 Num, float Spacing, int32* Vertices, float* Boundaries)
+	{
+		const float SpacingSq = Spacing * Spacing;
+		const auto Intersect = [In, SpacingSq](int32 Q, int32 R)
+		{
+			return ((In[Q] + SpacingSq * Q * Q) - (In[R] + SpacingSq * R * R)) / (2.0f * SpacingSq * (Q - R));
+		};
+
+		int32 NumParabolas = 0;
+		Vertices[0] = 0;
+		Boundaries[0] = -MAX_flt;
+		Boundaries[1] = MAX_flt;
+
+		for (int32 Q = 1; Q < Num; Q++)
+		{
+			float Intersection = Intersect(Q, Vertices[NumParabolas]);
+			while (Intersection <= Boundaries[NumParabolas])
+			{
+				NumParabolas--;
+				Intersection = Intersect(Q, Vertices[NumParabolas]);
+			}
+			NumParabolas++;
+			Vertices[NumParabolas] = Q;
+			Boundaries[NumParabolas] = Intersection;
+			Boundaries[NumParabolas + 1] = MAX_flt;
+		}
+
+		int32 Parabola = 0;
+		for (int32 P = 0; P < Num; P++)
+		{
+			while (Boundaries[Parabola + 1] < P)
+			{
+				Parabola++;
+			}
+			const float Delta = (P - Vertices[Parabola]) * Spacing;
+			Out[P] = Delta * Delta + In[Vertices[Parabola]];
+		}
+	}
+
+	/**
+	 * Fills the bricks of one mip from a heightfield. The voxel lattice shared by all bricks is solved one Z slice at a time:
+	 * the squared vertical distance to each column's surface span is transformed along X then Y, which gives the squared
+	 * distance to the closest surface sample without touching any triangles.
+	 */
+	static void GenerateHeightfieldBricks(TArray<FDistanceFieldGenerationTask>& Bricks, const FRealtimeMeshHeightfield& Heightfield,
+		const FRealtimeMeshDistanceFieldGeneratorOptions& Options)
+	{
+		if (Bricks.Num() == 0)
+		{
+			return;
+		}
+
+		const FDistanceFieldGenerationTask& Layout = Bricks[0];
+		const UE::Math::TIntVector3<int32> LatticeSize = Layout.IndirectionSize * DistanceField::UniqueDataBrickSize + UE::Math::TIntVector3<int32>(1);
+		const FVector VoxelSize = Layout.VolumeBounds.GetSize() / FVector(Layout.IndirectionSize * DistanceField::UniqueDataBrickSize);
+		const float MaxDistance = Layout.LocalSpaceTraceDistance * 2.0f;
+		const float MaxDistanceSq = MaxDistance * MaxDistance;
+		const int32 SliceSize = LatticeSize.X * LatticeSize.Y;
+
+		// Resample the heights onto the lattice columns and find the vertical span each column's surface covers
+		// once it is joined to its neighbours, so steep slopes don't leave holes between samples.
+		TArray<float> ColumnHeights;
+		ColumnHeights.SetNumUninitialized(SliceSize);
+		for (int32 Y = 0; Y < LatticeSize.Y; Y++)
+		{
+			for (int32 X = 0; X < LatticeSize.X; X++)
+			{
+				const FVector2f Position(Layout.VolumeBounds.Min.X + X * VoxelSize.X, Layout.VolumeBounds.Min.Y + Y * VoxelSize.Y);
+				ColumnHeights[Y * LatticeSize.X + X] = Heightfield.SampleHeight(Position);
+			}
+		}
+
+		TArray<float> ColumnMin;
+		TArray<float> ColumnMax;
+		ColumnMin.SetNumUninitialized(SliceSize);
+		ColumnMax.SetNumUninitialized(SliceSize);
+		float SurfaceMin = MAX_flt;
+		float SurfaceMax = -MAX_flt;
+		for (int32 Y = 0; Y < LatticeSize.Y; Y++)
+		{
+			for (int32 X = 0; X < LatticeSize.X; X++)
+			{
+				const int32 Column = Y * LatticeSize.X + X;
+				const float Height = ColumnHeights[Column];
+				float Min = Height;
+				float Max = Height;
+
+				const auto AddNeighbour = [&](int32 NeighbourX, int32 NeighbourY)
+				{
+					if (NeighbourX >= 0 && NeighbourX < LatticeSize.X && NeighbourY >= 0 && NeighbourY < LatticeSize.Y)
+					{
+						const float MidHeight = (Height + ColumnHeights[NeighbourY * LatticeSize.X + NeighbourX]) * 0.5f;
+						Min = FMath::Min(Min, MidHeight);
+						Max = FMath::Max(Max, MidHeight);
+					}
+				};
+				AddNeighbour(X - 1, Y);
+				AddNeighbour(X + 1, Y);
+				AddNeighbour(X, Y - 1);
+				AddNeighbour(X, Y + 1);
+
+				ColumnMin[Column] = Min;
+				ColumnMax[Column] = Max;
+				SurfaceMin = FMath::Min(SurfaceMin, Min);
+				SurfaceMax = FMath::Max(SurfaceMax, Max);
+			}
+		}
+
+		const auto QuantizeDistance = [&Layout](float LocalSpaceDistance)
+		{
+			// Transform to the tracing shader's Volume space
+			const float VolumeSpaceDistance = LocalSpaceDistance * Layout.LocalToVolumeScale;
+			// Transform to the Distance Field texture's space
+			const float RescaledDistance = (VolumeSpaceDistance - Layout.DistanceFieldToVolumeScaleBias.Y) / Layout.DistanceFieldToVolumeScaleBias.X;
+			check(DistanceField::DistanceFieldFormat == PF_G8);
+			return (uint8)FMath::Clamp<int32>(FMath::FloorToInt(RescaledDistance * 255.0f + .5f), 0, 255);
+		};
+
+		TArray<uint8> Lattice;
+		Lattice.SetNumUninitialized(SliceSize * LatticeSize.Z);
+
+		const EParallelForFlags ParallelForFlags = Options.bMultiThreadedGeneration
+			? EParallelForFlags::BackgroundPriority
+			: EParallelForFlags::ForceSingleThread;
+
+#if RMC_ENGINE_ABOVE_5_1
+		ParallelFor(TEXT("RealtimeMeshHeightfieldDistanceField.Slices.PF"), LatticeSize.Z, 1,
+#else
+		ParallelFor(LatticeSize.Z,
+#endif
+			[&](int32 Z)
+			{
+				uint8* Slice = &Lattice[Z * SliceSize];
+				const float SliceHeight = Layout.VolumeBounds.Min.Z + Z * VoxelSize.Z;
+
+				// Slices entirely outside the band around the surface saturate, no need to transform them
+				if (SliceHeight + MaxDistance < SurfaceMin || SliceHeight - MaxDistance > SurfaceMax)
+				{
+					FMemory::Memset(Slice, QuantizeDistance(SliceHeight < SurfaceMin ? -MaxDistance : MaxDistance), SliceSize);
+					return;
+				}
+
+				const int32 MaxLineLength = FMath::Max(LatticeSize.X, LatticeSize.Y);
+				TArray<float> DistanceSq;
+				TArray<float> LineIn;
+				TArray<float> LineOut;
+				TArray<int32> Vertices;
+				TArray<float> Boundaries;
+				DistanceSq.SetNumUninitialized(SliceSize);
+				LineIn.SetNumUninitialized(MaxLineLength);
+				LineOut.SetNumUninitialized(MaxLineLength);
+				Vertices.SetNumUninitialized(MaxLineLength);
+				Boundaries.SetNumUninitialized(MaxLineLength + 1);
+
+				for (int32 Column = 0; Column < SliceSize; Column++)
+				{
+					const float VerticalDistance = FMath::Max3(ColumnMin[Column] - SliceHeight, SliceHeight - ColumnMax[Column], 0.0f);
+					DistanceSq[Column] = FMath::Min(VerticalDistance * VerticalDistance, MaxDistanceSq);
+				}
+
+				// Rows are contiguous so they transform in place
+				for (int32 Y = 0; Y < LatticeSize.Y; Y++)
+				{
+					float* Row = &DistanceSq[Y * LatticeSize.X];
+					FMemory::Memcpy(LineIn.GetData(), Row, LatticeSize.X * sizeof(float));
+					SquaredDistanceTransform1D(LineIn.GetData(), Row, LatticeSize.X, VoxelSize.X, Vertices.GetData(), Boundaries.GetData());
+				}
+
+				for (int32 X = 0; X < LatticeSize.X; X++)
+				{
+					for (int32 Y = 0; Y < LatticeSize.Y; Y++)
+					{
+						LineIn[Y] = DistanceSq[Y * LatticeSize.X + X];
+					}
+					SquaredDistanceTransform1D(LineIn.GetData(), LineOut.GetData(), LatticeSize.Y, VoxelSize.Y, Vertices.GetData(), Boundaries.GetData());
+					for (int32 Y = 0; Y < LatticeSize.Y; Y++)
+					{
+						const int32 Column = Y * LatticeSize.X + X;
+						const float Distance = FMath::Sqrt(LineOut[Y]);
+						// Everything below the surface is solid
+						Slice[Column] = QuantizeDistance(SliceHeight < ColumnHeights[Column] ? -Distance : Distance);
+					}
+				}
+			}, ParallelForFlags);
+
+#if RMC_ENGINE_ABOVE_5_1
+		ParallelFor(TEXT("RealtimeMeshHeightfieldDistanceField.Bricks.PF"), Bricks.Num(), 16,
+#else
+		ParallelFor(Bricks.Num(),
+#endif
+			[&](int32 BrickIndex)
+			{
+				FDistanceFieldGenerationTask& Brick = Bricks[BrickIndex];
+				const UE::Math::TIntVector3<int32> BrickMin = Brick.BrickCoordinate * DistanceField::UniqueDataBrickSize;
+
+				Brick.OutDistanceFieldVolume.SetNumUninitialized(DistanceField::BrickSize * DistanceField::BrickSize * DistanceField::BrickSize);
+				for (int32 ZIndex = 0; ZIndex < DistanceField::BrickSize; ZIndex++)
+				{
+					for (int32 YIndex = 0; YIndex < DistanceField::BrickSize; YIndex++)
+					{
+						const uint8* Src = &Lattice[ComputeLinearVoxelIndex(BrickMin + UE::Math::TIntVector3<int32>(0, YIndex, ZIndex), LatticeSize)];
+						uint8* Dest = &Brick.OutDistanceFieldVolume[(ZIndex * DistanceField::BrickSize + YIndex) * DistanceField::BrickSize];
+						FMemory::Memcpy(Dest, Src, DistanceField::BrickSize);
+
+						for (int32 XIndex = 0; XIndex < DistanceField::BrickSize; XIndex++)
+						{
+							Brick.OutBrickMaxDistance = FMath::Max(Brick.OutBrickMaxDistance, Dest[XIndex]);
+							Brick.OutBrickMinDistance = FMath::Min(Brick.OutBrickMinDistance, Dest[XIndex]);
+						}
+					}
+				}
+			}, ParallelForFlags);
+	}
 }
 
 
@@ -512,6 +781,29 @@ ERealtimeMeshOutcomePins URealtimeMeshDistanceFieldGeneration::GenerateDistanceF
 	return Outcome;
 }
 
+ERealtimeMeshOutcomePins URealtimeMeshDistanceFieldGeneration::GenerateDistanceFieldForHeightfield(const FRealtimeMeshHeightfield& Heightfield,
+	FRealtimeMeshDistanceField& DistanceField, FRealtimeMeshDistanceFieldGeneratorOptions Options)
+{
+	DistanceField = FRealtimeMeshDistanceField();
+
+	if (!Heightfield.IsValid())
+	{
+		UE_LOG(RealtimeMeshLog, Warning, TEXT("URealtimeMeshDistanceFieldGeneration: Generation Failed: Heightfield must be at least 2x2 with matching heights and positive spacing"));
+		return ERealtimeMeshOutcomePins::Failure;
+	}
+
+	// The volume under the surface is solid, there are no backfaces to account for
+	Options.bGenerateAsIfTwoSided = false;
+
+	return RealtimeMesh::DistanceFieldGen::BuildDistanceField(DistanceField, Heightfield.GetBounds(), Options,
+		[&Heightfield, &Options](TArray<RealtimeMesh::DistanceFieldGen::FDistanceFieldGenerationTask>& Bricks)
+		{
+			RealtimeMesh::DistanceFieldGen::GenerateHeightfieldBricks(Bricks, Heightfield, Options);
+		})
+		? ERealtimeMeshOutcomePins::Success
+		: ERealtimeMeshOutcomePins::Failure;
+}
+
 
 TFuture<TTuple<ERealtimeMeshOutcomePins, FRealtimeMeshDistanceField>> URealtimeMeshDistanceFieldGeneration::GenerateDistanceFieldForStreamSetAsync(
 	const RealtimeMesh::FRealtimeMeshStreamSet& StreamSet, FRealtimeMeshDistanceFieldGeneratorOptions Options)
@@ -597,6 +889,17 @@ TFuture<TTuple<ERealtimeMeshOutcomePins, FRealtimeMeshDistanceField>> URealtimeM
 	});
 }
 
+TFuture<TTuple<ERealtimeMeshOutcomePins, FRealtimeMeshDistanceField>> URealtimeMeshDistanceFieldGeneration::GenerateDistanceFieldForHeightfieldAsync(
+	FRealtimeMeshHeightfield&& Heightfield, FRealtimeMeshDistanceFieldGeneratorOptions Options)
+{
+	return DoOnAsyncThread([Heightfield = MoveTemp(Heightfield), Options]()
+	{
+		FRealtimeMeshDistanceField DistanceField;
+		const ERealtimeMeshOutcomePins Outcome = GenerateDistanceFieldForHeightfield(Heightfield, DistanceField, Options);
+		return TTuple<ERealtimeMeshOutcomePins, FRealtimeMeshDistanceField>(Outcome, DistanceField);
+	});
+}
+
 void URealtimeMeshDistanceFieldGeneration::GenerateDistanceFieldForStreamSetAsync(UObject* WorldContextObject, FLatentActionInfo LatentInfo, URealtimeMeshStreamSet* StreamSet,
 	FRealtimeMeshDistanceFieldGeneratorOptions Options, ERealtimeMeshOutcomePins& Result, FRealtimeMeshDistanceField& DistanceField)
 {
@@ -3,9 +3,16 @@
 
 #include "RealtimeMeshObjLoader.h"
 
+#include "RealtimeMeshCore.h"
+#include "RealtimeMeshFuture.h"
+#include "Async/MappedFileHandle.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformFileManager.h"
 #include "Mesh/RealtimeMeshAlgo.h"
 #include "Mesh/RealtimeMeshBlueprintMeshBuilder.h"
 #include "Mesh/RealtimeMeshBuilder.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
 
 #include "earcut.hpp"
 #define TINYOBJLOADER_IMPLEMENTATION
@@ -103,11 +110,899 @@ struct FRealtimeMeshOBJLoadUniqueVertexKey
 };
 
 
-FRealtimeMeshOBJLoadResult URealtimeMeshObjLoader::LoadStreamSetFromOBJFile(FRealtimeMeshStreamSet& OutStreams, TArray<FRealtimeMeshOBJMaterial>& OutMaterials, const FString& FileName, const FRealtimeMeshOBJLoadOptions& Options)
+/** Keywords of the OBJ statements the streaming parser cares about; everything else is skipped */
+enum class ERealtimeMeshOBJLineType : uint8
 {
-	OutStreams = FRealtimeMeshStreamSet();
-	OutMaterials.Empty();
+	Other,
+	Position,
+	Normal,
+	TexCoord,
+	Face,
+	UseMaterial,
+	MaterialLibrary,
+};
+
+/** A newline aligned block of the OBJ file, tokenized on its own task */
+struct FRealtimeMeshOBJParseBlock
+{
+	int64 Begin = 0;
+	int64 End = 0;
+
+	int32 NumPositions = 0;
+	int32 NumNormals = 0;
+	int32 NumTexCoords = 0;
+	int32 NumTriangles = 0;
+	bool bHasColors = false;
+
+	// Where this block's elements start in the whole file
+	int32 FirstPosition = 0;
+	int32 FirstNormal = 0;
+	int32 FirstTexCoord = 0;
+	int32 FirstTriangle = 0;
+
+	// usemtl statements in this block, keyed by the block local triangle they start at
+	TArray<TPair<int32, FString>> MaterialSwitches;
+	TArray<uint16> MaterialSwitchIndices;
+	uint16 StartMaterial = 0;
+
+	TArray<FString> MaterialLibraries;
+	FString Error;
+};
+
+static FORCEINLINE bool IsOBJSpace(ANSICHAR C)
+{
+	return C == ' ' || C == '\t' || C == '\r';
+}
+
+static FORCEINLINE const ANSICHAR* SkipOBJSpaces(const ANSICHAR* Pos, const ANSICHAR* End)
+{
+	while (Pos < End && IsOBJSpace(*Pos))
+	{
+		++Pos;
+	}
+	return Pos;
+}
+
+static int32 CountOBJTokens(const ANSICHAR* Pos, const ANSICHAR* End)
+{
+	int32 Count = 0;
+	bool bInToken = false;
+	for (; Pos < End; ++Pos)
+	{
+		const bool bIsSpace = IsOBJSpace(*Pos);
+		Count += !bIsSpace && !bInToken;
+		bInToken = !bIsSpace;
+	}
+	return Count;
+}
+
+static FString GetOBJLineRemainder(const ANSICHAR* Pos, const ANSICHAR* End)
+{
+	Pos = SkipOBJSpaces(Pos, End);
+	while (End > Pos && IsOBJSpace(*(End - 1)))
+	{
+		--End;
+	}
+	return FString(UE_PTRDIFF_TO_INT32(End - Pos), Pos);
+}
+
+/** Identifies a line by its keyword and advances past it */
+static ERealtimeMeshOBJLineType ClassifyOBJLine(const ANSICHAR*& Pos, const ANSICHAR* End)
+{
+	Pos = SkipOBJSpaces(Pos, End);
+
+	const auto MatchKeyword = [&Pos, End](const ANSICHAR* Keyword, int32 KeywordLength)
+	{
+		if (End - Pos > KeywordLength && FMemory::Memcmp(Pos, Keyword, KeywordLength) == 0 && IsOBJSpace(Pos[KeywordLength]))
+		{
+			Pos += KeywordLength;
+			return true;
+		}
+		return false;
+	};
+
+	if (Pos < End)
+	{
+		switch (*Pos)
+		{
+		case 'v':
+			if (MatchKeyword("v", 1)) return ERealtimeMeshOBJLineType::Position;
+			if (MatchKeyword("vn", 2)) return ERealtimeMeshOBJLineType::Normal;
+			if (MatchKeyword("vt", 2)) return ERealtimeMeshOBJLineType::TexCoord;
+			break;
+		case 'f':
+			if (MatchKeyword("f", 1)) return ERealtimeMeshOBJLineType::Face;
+			break;
+		case 'u':
+			if (MatchKeyword("usemtl", 6)) return ERealtimeMeshOBJLineType::UseMaterial;
+			break;
+		case 'm':
+			if (MatchKeyword("mtllib", 6)) return ERealtimeMeshOBJLineType::MaterialLibrary;
+			break;
+		default:
+			break;
+		}
+	}
+	return ERealtimeMeshOBJLineType::Other;
+}
+
+/** Calls Func(LineBegin, LineEnd) for each line in the range, stopping early if it returns false */
+template <typename FuncType>
+static bool ForEachOBJLine(const ANSICHAR* Begin, const ANSICHAR* End, FuncType&& Func)
+{
+	while (Begin < End)
+	{
+		const ANSICHAR* LineEnd = static_cast<const ANSICHAR*>(memchr(Begin, '\n', End - Begin));
+		LineEnd = LineEnd ? LineEnd : End;
+		if (!Func(Begin, LineEnd))
+		{
+			return false;
+		}
+		Begin = LineEnd + 1;
+	}
+	return true;
+}
+
+/** Parses a decimal float in place. The mapped file isn't null terminated, so strtof/Atof can't be used near the end of it. */
+static bool ParseOBJFloat(const ANSICHAR*& Pos, const ANSICHAR* End, float& OutValue)
+{
+	static constexpr double PowersOfTen[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+	const ANSICHAR* Cursor = Pos;
+	bool bNegative = false;
+	if (Cursor < End && (*Cursor == '-' || *Cursor == '+'))
+	{
+		bNegative = *Cursor == '-';
+		++Cursor;
+	}
+
+	double Mantissa = 0.0;
+	int32 Exponent = 0;
+	bool bHasDigits = false;
+	for (; Cursor < End && *Cursor >= '0' && *Cursor <= '9'; ++Cursor)
+	{
+		Mantissa = Mantissa * 10.0 + (*Cursor - '0');
+		bHasDigits = true;
+	}
+	if (Cursor < End && *Cursor == '.')
+	{
+		for (++Cursor; Cursor < End && *Cursor >= '0' && *Cursor <= '9'; ++Cursor)
+		{
+			Mantissa = Mantissa * 10.0 + (*Cursor - '0');
+			Exponent--;
+			bHasDigits = true;
+		}
+	}
+	if (!bHasDigits)
+	{
+		return false;
+	}
+
+	if (Cursor < End && (*Cursor == 'e' || *Cursor == 'E'))
+	{
+		const ANSICHAR* ExponentCursor = Cursor + 1;
+		bool bNegativeExponent = false;
+		if (ExponentCursor < End && (*ExponentCursor == '-' || *ExponentCursor == '+'))
+		{
+			bNegativeExponent = *ExponentCursor == '-';
+			++ExponentCursor;
+		}
+		int32 ExplicitExponent = 0;
+		bool bHasExponentDigits = false;
+		for (; ExponentCursor < End && *ExponentCursor >= '0' && *ExponentCursor <= '9'; ++ExponentCursor)
+		{
+			ExplicitExponent = FMath::Min(ExplicitExponent * 10 + (*ExponentCursor - '0'), 1000);
+			bHasExponentDigits = true;
+		}
+		if (bHasExponentDigits)
+		{
+			Exponent += bNegativeExponent ? -ExplicitExponent : ExplicitExponent;
+			Cursor = ExponentCursor;
+		}
+	}
+
+	const int32 AbsExponent = FMath::Abs(Exponent);
+	const double Scale = AbsExponent < int32(UE_ARRAY_COUNT(PowersOfTen)) ? PowersOfTen[AbsExponent] : FMath::Pow(10.0, double(AbsExponent));
+	const double Value = Exponent < 0 ? Mantissa / Scale : Mantissa * Scale;
+	OutValue = float(bNegative ? -Value : Value);
+	Pos = Cursor;
+	return true;
+}
+
+static bool ParseOBJFloats(const ANSICHAR*& Pos, const ANSICHAR* End, float* OutValues, int32 NumValues)
+{
+	for (int32 Index = 0; Index < NumValues; Index++)
+	{
+		Pos = SkipOBJSpaces(Pos, End);
+		if (!ParseOBJFloat(Pos, End, OutValues[Index]))
+		{
+			return false;
+		}
+	}
+	return true;
+}
 
+static bool ParseOBJInt(const ANSICHAR*& Pos, const ANSICHAR* End, int32& OutValue)
+{
+	const ANSICHAR* Cursor = Pos;
+	bool bNegative = false;
+	if (Cursor < End && (*Cursor == '-' || *Cursor == '+'))
+	{
+		bNegative = *Cursor == '-';
+		++Cursor;
+	}
+
+	int64 Value = 0;
+	const ANSICHAR* DigitsBegin = Cursor;
+	for (; Cursor < End && *Cursor >= '0' && *Cursor <= '9'; ++Cursor)
+	{
+		Value = FMath::Min<int64>(Value * 10 + (*Cursor - '0'), MAX_int32);
+	}
+	if (Cursor == DigitsBegin)
+	{
+		return false;
+	}
+	OutValue = int32(bNegative ? -Value : Value);
+	Pos = Cursor;
+	return true;
+}
+
+/** Parses one "v", "v/vt", "v//vn" or "v/vt/vn" face corner into raw OBJ indices, with 0 for a missing attribute */
+static bool ParseOBJFaceCorner(const ANSICHAR*& Pos, const ANSICHAR* End, int32& OutPosition, int32& OutTexCoord, int32& OutNormal)
+{
+	OutTexCoord = 0;
+	OutNormal = 0;
+	if (!ParseOBJInt(Pos, End, OutPosition))
+	{
+		return false;
+	}
+	if (Pos < End && *Pos == '/')
+	{
+		++Pos;
+		if (Pos < End && *Pos != '/' && !ParseOBJInt(Pos, End, OutTexCoord))
+		{
+			return false;
+		}
+		if (Pos < End && *Pos == '/')
+		{
+			++Pos;
+			if (!ParseOBJInt(Pos, End, OutNormal))
+			{
+				return false;
+			}
+		}
+	}
+	return Pos == End || IsOBJSpace(*Pos);
+}
+
+/** Converts a one based or negative (relative to the elements declared so far) OBJ index into a zero based one */
+static FORCEINLINE int32 ResolveOBJIndex(int32 RawIndex, int32 NumDeclaredSoFar, int32 NumTotal)
+{
+	const int32 Index = RawIndex > 0 ? RawIndex - 1 : (RawIndex < 0 ? NumDeclaredSoFar + RawIndex : INDEX_NONE);
+	return Index >= 0 && Index < NumTotal ? Index : INDEX_NONE;
+}
+
+/**
+ * Splits a face into triangles of polygon local corners. Quads and larger go through earcut so concave faces stay
+ * correct, falling back to a fan if earcut can't produce a full triangulation of a degenerate face.
+ */
+static void TriangulateOBJPolygon(TConstArrayView<FIntVector> Polygon, TConstArrayView<FVector3f> Positions, TArray<TIndex3<int32>, TInlineAllocator<16>>& OutTriangles)
+{
+	OutTriangles.Reset();
+	const int32 NumCorners = Polygon.Num();
+
+	if (NumCorners > 3)
+	{
+		// Newell normal picks the projection plane, and its component on the dropped axis is twice the projected signed area
+		FVector3f Normal = FVector3f::ZeroVector;
+		for (int32 Index = 0; Index < NumCorners; Index++)
+		{
+			const FVector3f& A = Positions[Polygon[Index].X];
+			const FVector3f& B = Positions[Polygon[(Index + 1) % NumCorners].X];
+			Normal.X += (A.Y - B.Y) * (A.Z + B.Z);
+			Normal.Y += (A.Z - B.Z) * (A.X + B.X);
+			Normal.Z += (A.X - B.X) * (A.Y + B.Y);
+		}
+		const FVector3f AbsNormal = Normal.GetAbs();
+		const int32 DropAxis = AbsNormal.X > AbsNormal.Y ? (AbsNormal.X > AbsNormal.Z ? 0 : 2) : (AbsNormal.Y > AbsNormal.Z ? 1 : 2);
+		const int32 AxisU = (DropAxis + 1) % 3;
+		const int32 AxisV = (DropAxis + 2) % 3;
+
+		std::vector<std::vector<std::array<float, 2>>> Rings(1);
+		Rings[0].reserve(NumCorners);
+		for (const FIntVector& Corner : Polygon)
+		{
+			const FVector3f& Position = Positions[Corner.X];
+			Rings[0].push_back({ Position[AxisU], Position[AxisV] });
+		}
+
+		const std::vector<uint32> Indices = mapbox::earcut<uint32>(Rings);
+		if (Indices.size() == size_t(NumCorners - 2) * 3)
+		{
+			// Earcut doesn't promise to keep the input orientation, so flip anything that disagrees with the face
+			const float FaceOrientation = Normal[DropAxis];
+			for (size_t Index = 0; Index < Indices.size(); Index += 3)
+			{
+				int32 V0 = Indices[Index + 0];
+				int32 V1 = Indices[Index + 1];
+				int32 V2 = Indices[Index + 2];
+				const FVector2f A(Rings[0][V0][0], Rings[0][V0][1]);
+				const FVector2f B(Rings[0][V1][0], Rings[0][V1][1]);
+				const FVector2f C(Rings[0][V2][0], Rings[0][V2][1]);
+				if (FVector2f::CrossProduct(B - A, C - A) * FaceOrientation < 0.0f)
+				{
+					Swap(V1, V2);
+				}
+				OutTriangles.Emplace(V0, V1, V2);
+			}
+			return;
+		}
+	}
+
+	for (int32 Index = 1; Index + 1 < NumCorners; Index++)
+	{
+		OutTriangles.Emplace(0, Index, Index + 1);
+	}
+}
+
+static void SplitOBJBlocks(const ANSICHAR* Data, int64 DataSize, int64 BlockSize, TArray<FRealtimeMeshOBJParseBlock>& OutBlocks)
+{
+	int64 Begin = 0;
+	while (Begin < DataSize)
+	{
+		int64 End = FMath::Min(Begin + BlockSize, DataSize);
+		if (End < DataSize)
+		{
+			const ANSICHAR* NewLine = static_cast<const ANSICHAR*>(memchr(Data + End, '\n', DataSize - End));
+			End = NewLine ? (NewLine - Data) + 1 : DataSize;
+		}
+
+		FRealtimeMeshOBJParseBlock& Block = OutBlocks.AddDefaulted_GetRef();
+		Block.Begin = Begin;
+		Block.End = End;
+		Begin = End;
+	}
+}
+
+template <typename BodyType>
+static void OBJParallelFor(const TCHAR* DebugName, int32 Num, int32 MinBatchSize, BodyType&& Body)
+{
+#if RMC_ENGINE_ABOVE_5_1
+	ParallelFor(DebugName, Num, MinBatchSize, Forward<BodyType>(Body), EParallelForFlags::Unbalanced);
+#else
+	ParallelFor(Num, Forward<BodyType>(Body), EParallelForFlags::Unbalanced);
+#endif
+}
+
+/**
+ * Memory mapped, block parallel OBJ parser. A counting pass sizes every block, then vertices and faces are parsed
+ * in parallel straight into their final place in the stream set, so the file is never held in memory as a whole
+ * and there's no intermediate copy of the mesh.
+ */
+static FRealtimeMeshOBJLoadResult LoadStreamSetWithStreamingParser(FRealtimeMeshStreamSet& OutStreams, TArray<FRealtimeMeshOBJMaterial>& OutMaterials,
+	const FString& FileName, const FRealtimeMeshOBJLoadOptions& Options, FRealtimeMeshOBJLoadProgress* Progress)
+{
+	FRealtimeMeshOBJLoadResult Result;
+	const auto Fail = [&Result](const FString& Message)
+	{
+		Result.bSuccess = false;
+		Result.Message = TEXT("RealtimeMeshObjLoader: ") + Message;
+		return Result;
+	};
+	const auto IsCancelled = [Progress]() { return Progress != nullptr && Progress->IsCancelled(); };
+
+	// Map the file so the OS pages it in as blocks are parsed, falling back to a plain read where mapping isn't supported
+	TUniquePtr<IMappedFileHandle> MappedFile(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*FileName));
+	TUniquePtr<IMappedFileRegion> MappedRegion(MappedFile.IsValid() ? MappedFile->MapRegion() : nullptr);
+	TArray64<uint8> FileData;
+	const ANSICHAR* Data = nullptr;
+	int64 DataSize = 0;
+	if (MappedRegion.IsValid())
+	{
+		Data = reinterpret_cast<const ANSICHAR*>(MappedRegion->GetMappedPtr());
+		DataSize = MappedRegion->GetMappedSize();
+	}
+	else if (FFileHelper::LoadFileToArray(FileData, *FileName))
+	{
+		Data = reinterpret_cast<const ANSICHAR*>(FileData.GetData());
+		DataSize = FileData.Num();
+	}
+	else
+	{
+		return Fail(FString::Printf(TEXT("Unable to open %s."), *FileName));
+	}
+
+	// Counting pass, three parse passes weighted by bytes, and one more file's worth for finalizing
+	if (Progress)
+	{
+		Progress->BeginWork(DataSize * 4);
+	}
+
+	TArray<FRealtimeMeshOBJParseBlock> Blocks;
+	SplitOBJBlocks(Data, DataSize, FMath::Max(Options.ParseBlockSizeKB, 64) * int64(1024), Blocks);
+
+	const auto GetFirstError = [&Blocks]() -> const FString*
+	{
+		for (const FRealtimeMeshOBJParseBlock& Block : Blocks)
+		{
+			if (!Block.Error.IsEmpty())
+			{
+				return &Block.Error;
+			}
+		}
+		return nullptr;
+	};
+
+	OBJParallelFor(TEXT("RealtimeMeshObjLoader.Count.PF"), Blocks.Num(), 1, [&](int32 BlockIndex)
+	{
+		FRealtimeMeshOBJParseBlock& Block = Blocks[BlockIndex];
+		if (IsCancelled())
+		{
+			return;
+		}
+
+		ForEachOBJLine(Data + Block.Begin, Data + Block.End, [&](const ANSICHAR* Pos, const ANSICHAR* LineEnd)
+		{
+			switch (ClassifyOBJLine(Pos, LineEnd))
+			{
+			case ERealtimeMeshOBJLineType::Position:
+				Block.NumPositions++;
+				Block.bHasColors |= CountOBJTokens(Pos, LineEnd) >= 6;
+				break;
+			case ERealtimeMeshOBJLineType::Normal:
+				Block.NumNormals++;
+				break;
+			case ERealtimeMeshOBJLineType::TexCoord:
+				Block.NumTexCoords++;
+				break;
+			case ERealtimeMeshOBJLineType::Face:
+				Block.NumTriangles += FMath::Max(CountOBJTokens(Pos, LineEnd) - 2, 0);
+				break;
+			case ERealtimeMeshOBJLineType::UseMaterial:
+				Block.MaterialSwitches.Emplace(Block.NumTriangles, GetOBJLineRemainder(Pos, LineEnd));
+				break;
+			case ERealtimeMeshOBJLineType::MaterialLibrary:
+				Block.MaterialLibraries.Add(GetOBJLineRemainder(Pos, LineEnd));
+				break;
+			default:
+				break;
+			}
+			return true;
+		});
+
+		if (Progress)
+		{
+			Progress->AddWork(Block.End - Block.Begin);
+		}
+	});
+
+	if (IsCancelled())
+	{
+		return Fail(TEXT("Load cancelled."));
+	}
+
+	// Lay every block's elements out in file order
+	int64 TotalPositions = 0;
+	int64 TotalNormals = 0;
+	int64 TotalTexCoords = 0;
+	int64 TotalTriangles = 0;
+	bool bHasColors = false;
+	for (FRealtimeMeshOBJParseBlock& Block : Blocks)
+	{
+		Block.FirstPosition = int32(TotalPositions);
+		Block.FirstNormal = int32(TotalNormals);
+		Block.FirstTexCoord = int32(TotalTexCoords);
+		Block.FirstTriangle = int32(TotalTriangles);
+		TotalPositions += Block.NumPositions;
+		TotalNormals += Block.NumNormals;
+		TotalTexCoords += Block.NumTexCoords;
+		TotalTriangles += Block.NumTriangles;
+		bHasColors |= Block.bHasColors;
+
+		if (FMath::Max(FMath::Max(TotalPositions, TotalNormals), FMath::Max(TotalTexCoords, TotalTriangles)) > MAX_int32)
+		{
+			return Fail(TEXT("File has more elements than a stream can hold."));
+		}
+	}
+	const int32 NumPositions = int32(TotalPositions);
+	const int32 NumNormals = int32(TotalNormals);
+	const int32 NumTexCoords = int32(TotalTexCoords);
+	const int32 NumTriangles = int32(TotalTriangles);
+
+	// Material libraries are small, so they still go through tinyobj's MTL reader
+	std::vector<tinyobj::material_t> RawMaterials;
+	std::map<std::string, int> RawMaterialMap;
+	{
+		const FString SearchPath = Options.MaterialSearchPath.Len() > 0 ? Options.MaterialSearchPath : FPaths::GetPath(FileName);
+		tinyobj::MaterialFileReader MaterialReader(std::string(TCHAR_TO_ANSI(*SearchPath)));
+		TSet<FString> LoadedLibraries;
+		for (const FRealtimeMeshOBJParseBlock& Block : Blocks)
+		{
+			for (const FString& LibraryLine : Block.MaterialLibraries)
+			{
+				TArray<FString> LibraryNames;
+				LibraryLine.ParseIntoArrayWS(LibraryNames);
+				for (const FString& LibraryName : LibraryNames)
+				{
+					bool bAlreadyLoaded = false;
+					LoadedLibraries.Add(LibraryName, &bAlreadyLoaded);
+					if (!bAlreadyLoaded)
+					{
+						std::string Warning;
+						std::string Error;
+						MaterialReader(std::string(TCHAR_TO_ANSI(*LibraryName)), &RawMaterials, &RawMaterialMap, &Warning, &Error);
+						Result.Message += ANSI_TO_TCHAR(Warning.c_str());
+						Result.Message += ANSI_TO_TCHAR(Error.c_str());
+					}
+				}
+			}
+		}
+	}
+
+	for (const auto& Mat : RawMaterials)
+	{
+		OutMaterials.Add(ConvertMaterialInfo(Mat));
+	}
+
+	// Resolve usemtl names to polygroups, carrying the active material across block boundaries
+	{
+		TMap<FString, int32> MaterialIndices;
+		for (const auto& Entry : RawMaterialMap)
+		{
+			MaterialIndices.Add(ANSI_TO_TCHAR(Entry.first.c_str()), Entry.second);
+		}
+
+		TSet<FString> MissingMaterials;
+		uint16 CurrentMaterial = 0;
+		for (FRealtimeMeshOBJParseBlock& Block : Blocks)
+		{
+			Block.StartMaterial = CurrentMaterial;
+			for (const TPair<int32, FString>& Switch : Block.MaterialSwitches)
+			{
+				const int32* MaterialIndex = MaterialIndices.Find(Switch.Value);
+				if (MaterialIndex == nullptr && !MissingMaterials.Contains(Switch.Value))
+				{
+					MissingMaterials.Add(Switch.Value);
+					Result.Message += FString::Printf(TEXT("Material %s not found.\n"), *Switch.Value);
+				}
+				CurrentMaterial = uint16(MaterialIndex ? FMath::Clamp(*MaterialIndex, 0, int32(MAX_uint16)) : 0);
+				Block.MaterialSwitchIndices.Add(CurrentMaterial);
+			}
+		}
+	}
+
+	FRealtimeMeshStream& PositionStream = OutStreams.AddStream<FVector3f>(FRealtimeMeshStreams::Position);
+	PositionStream.SetNumUninitialized(NumPositions);
+	const TArrayView<FVector3f> Positions = PositionStream.GetArrayView<FVector3f>();
+
+	TArray<FColor> Colors;
+	TArray<FVector3f> Normals;
+	TArray<FVector2f> TexCoords;
+	Colors.SetNumUninitialized(bHasColors ? NumPositions : 0);
+	Normals.SetNumUninitialized(NumNormals);
+	TexCoords.SetNumUninitialized(NumTexCoords);
+
+	OBJParallelFor(TEXT("RealtimeMeshObjLoader.Vertices.PF"), Blocks.Num(), 1, [&](int32 BlockIndex)
+	{
+		FRealtimeMeshOBJParseBlock& Block = Blocks[BlockIndex];
+		if (IsCancelled())
+		{
+			return;
+		}
+
+		int32 PositionIndex = Block.FirstPosition;
+		int32 NormalIndex = Block.FirstNormal;
+		int32 TexCoordIndex = Block.FirstTexCoord;
+		ForEachOBJLine(Data + Block.Begin, Data + Block.End, [&](const ANSICHAR* Pos, const ANSICHAR* LineEnd)
+		{
+			float Values[3];
+			switch (ClassifyOBJLine(Pos, LineEnd))
+			{
+			case ERealtimeMeshOBJLineType::Position:
+				if (!ParseOBJFloats(Pos, LineEnd, Values, 3))
+				{
+					Block.Error = FString::Printf(TEXT("Malformed vertex at byte %lld."), int64(Pos - Data));
+					return false;
+				}
+				Positions[PositionIndex] = FVector3f(Values[0], Values[1], Values[2]);
+				if (bHasColors)
+				{
+					// Matches tinyobj, vertices without a color of their own are white
+					Colors[PositionIndex] = ParseOBJFloats(Pos, LineEnd, Values, 3)
+						? FLinearColor(Values[0], Values[1], Values[2]).ToFColor(false)
+						: FColor::White;
+				}
+				PositionIndex++;
+				break;
+			case ERealtimeMeshOBJLineType::Normal:
+				if (!ParseOBJFloats(Pos, LineEnd, Values, 3))
+				{
+					Block.Error = FString::Printf(TEXT("Malformed normal at byte %lld."), int64(Pos - Data));
+					return false;
+				}
+				Normals[NormalIndex++] = FVector3f(Values[0], Values[1], Values[2]);
+				break;
+			case ERealtimeMeshOBJLineType::TexCoord:
+				if (!ParseOBJFloats(Pos, LineEnd, Values, 1))
+				{
+					Block.Error = FString::Printf(TEXT("Malformed texture coordinate at byte %lld."), int64(Pos - Data));
+					return false;
+				}
+				Values[1] = 0.0f;
+				ParseOBJFloats(Pos, LineEnd, &Values[1], 1);
+				TexCoords[TexCoordIndex++] = FVector2f(Values[0], Values[1]);
+				break;
+			default:
+				break;
+			}
+			return true;
+		});
+
+		if (Progress)
+		{
+			Progress->AddWork(Block.End - Block.Begin);
+		}
+	});
+
+	if (IsCancelled())
+	{
+		return Fail(TEXT("Load cancelled."));
+	}
+	if (const FString* Error = GetFirstError())
+	{
+		return Fail(*Error);
+	}
+
+	FRealtimeMeshStream& TriangleStream = OutStreams.AddStream<TIndex3<uint32>>(FRealtimeMeshStreams::Triangles);
+	FRealtimeMeshStream& PolyGroupStream = OutStreams.AddStream<uint16>(FRealtimeMeshStreams::PolyGroups);
+	TriangleStream.SetNumUninitialized(NumTriangles);
+	PolyGroupStream.SetNumUninitialized(NumTriangles);
+	const TArrayView<TIndex3<uint32>> Triangles = TriangleStream.GetArrayView<TIndex3<uint32>>();
+	const TArrayView<uint16> PolyGroups = PolyGroupStream.GetArrayView<uint16>();
+
+	// (Position, TexCoord, Normal) for every triangle corner, only filled when attributes aren't indexed like positions
+	TArray64<FIntVector> Corners;
+	std::atomic<bool> bAttributesMatchPositions { true };
+
+	const auto ParseFaces = [&](bool bWriteCorners)
+	{
+		OBJParallelFor(TEXT("RealtimeMeshObjLoader.Faces.PF"), Blocks.Num(), 1, [&](int32 BlockIndex)
+		{
+			FRealtimeMeshOBJParseBlock& Block = Blocks[BlockIndex];
+			if (IsCancelled())
+			{
+				return;
+			}
+
+			// Negative indices are relative to what's been declared so far, so keep counting vertices as we go
+			int32 PositionCount = Block.FirstPosition;
+			int32 NormalCount = Block.FirstNormal;
+			int32 TexCoordCount = Block.FirstTexCoord;
+			int32 TriangleIndex = Block.FirstTriangle;
+			int32 MaterialSwitchIndex = 0;
+			uint16 Material = Block.StartMaterial;
+			TArray<FIntVector, TInlineAllocator<16>> Polygon;
+			TArray<TIndex3<int32>, TInlineAllocator<16>> PolygonTriangles;
+
+			ForEachOBJLine(Data + Block.Begin, Data + Block.End, [&](const ANSICHAR* Pos, const ANSICHAR* LineEnd)
+			{
+				switch (ClassifyOBJLine(Pos, LineEnd))
+				{
+				case ERealtimeMeshOBJLineType::Position:
+					PositionCount++;
+					break;
+				case ERealtimeMeshOBJLineType::Normal:
+					NormalCount++;
+					break;
+				case ERealtimeMeshOBJLineType::TexCoord:
+					TexCoordCount++;
+					break;
+				case ERealtimeMeshOBJLineType::UseMaterial:
+					Material = Block.MaterialSwitchIndices[MaterialSwitchIndex++];
+					break;
+				case ERealtimeMeshOBJLineType::Face:
+					{
+						Polygon.Reset();
+						for (Pos = SkipOBJSpaces(Pos, LineEnd); Pos < LineEnd; Pos = SkipOBJSpaces(Pos, LineEnd))
+						{
+							int32 RawPosition, RawTexCoord, RawNormal;
+							const ANSICHAR* CornerBegin = Pos;
+							if (!ParseOBJFaceCorner(Pos, LineEnd, RawPosition, RawTexCoord, RawNormal))
+							{
+								Block.Error = FString::Printf(TEXT("Malformed face at byte %lld."), int64(CornerBegin - Data));
+								return false;
+							}
+
+							const FIntVector Corner(
+								ResolveOBJIndex(RawPosition, PositionCount, Positions.Num()),
+								ResolveOBJIndex(RawTexCoord, TexCoordCount, TexCoords.Num()),
+								ResolveOBJIndex(RawNormal, NormalCount, Normals.Num()));
+							if (Corner.X == INDEX_NONE)
+							{
+								Block.Error = FString::Printf(TEXT("Face at byte %lld references a vertex that doesn't exist."), int64(CornerBegin - Data));
+								return false;
+							}
+							if (!bWriteCorners && ((Corner.Y != INDEX_NONE && Corner.Y != Corner.X) || (Corner.Z != INDEX_NONE && Corner.Z != Corner.X)))
+							{
+								// Another pass will record full corners, no point finishing this one
+								bAttributesMatchPositions = false;
+								return false;
+							}
+							Polygon.Add(Corner);
+						}
+
+						if (Polygon.Num() < 3)
+						{
+							break;
+						}
+
+						TriangulateOBJPolygon(Polygon, Positions, PolygonTriangles);
+						for (const TIndex3<int32>& Triangle : PolygonTriangles)
+						{
+							const FIntVector& Corner0 = Polygon[Options.bReverseWinding ? Triangle.V0 : Triangle.V2];
+							const FIntVector& Corner1 = Polygon[Triangle.V1];
+							const FIntVector& Corner2 = Polygon[Options.bReverseWinding ? Triangle.V2 : Triangle.V0];
+
+							Triangles[TriangleIndex] = TIndex3<uint32>(Corner0.X, Corner1.X, Corner2.X);
+							PolyGroups[TriangleIndex] = Material;
+							if (bWriteCorners)
+							{
+								Corners[int64(TriangleIndex) * 3 + 0] = Corner0;
+								Corners[int64(TriangleIndex) * 3 + 1] = Corner1;
+								Corners[int64(TriangleIndex) * 3 + 2] = Corner2;
+							}
+							TriangleIndex++;
+						}
+					}
+					break;
+				default:
+					break;
+				}
+				return bWriteCorners || bAttributesMatchPositions;
+			});
+
+			if (Progress && (bWriteCorners || bAttributesMatchPositions))
+			{
+				Progress->AddWork(Block.End - Block.Begin);
+			}
+		});
+	};
+
+	ParseFaces(false);
+	if (!bAttributesMatchPositions && !IsCancelled() && GetFirstError() == nullptr)
+	{
+		Corners.SetNumUninitialized(int64(NumTriangles) * 3);
+		ParseFaces(true);
+	}
+
+	if (IsCancelled())
+	{
+		return Fail(TEXT("Load cancelled."));
+	}
+	if (const FString* Error = GetFirstError())
+	{
+		return Fail(*Error);
+	}
+
+	if (bAttributesMatchPositions)
+	{
+		// Every attribute shares the position index, so positions are already the final vertices
+		if (bHasColors)
+		{
+			OutStreams.AddStream<FColor>(FRealtimeMeshStreams::Color).Append(Colors);
+		}
+
+		if (Normals.Num() > 0)
+		{
+			FRealtimeMeshStream& TangentStream = OutStreams.AddStream<FRealtimeMeshTangentsNormalPrecision>(FRealtimeMeshStreams::Tangents);
+			TangentStream.SetNumUninitialized(Positions.Num());
+			const TArrayView<FRealtimeMeshTangentsNormalPrecision> Tangents = TangentStream.GetArrayView<FRealtimeMeshTangentsNormalPrecision>();
+			OBJParallelFor(TEXT("RealtimeMeshObjLoader.Tangents.PF"), Positions.Num(), 4096, [&](int32 Index)
+			{
+				Tangents[Index] = FRealtimeMeshTangentsNormalPrecision(Normals.IsValidIndex(Index) ? Normals[Index] : FVector3f::UnitZ(), FVector3f::UnitX());
+			});
+		}
+
+		if (TexCoords.Num() > 0)
+		{
+			FRealtimeMeshStream& TexCoordStream = OutStreams.AddStream<FVector2DHalf>(FRealtimeMeshStreams::TexCoords);
+			TexCoordStream.SetNumUninitialized(Positions.Num());
+			const TArrayView<FVector2DHalf> OutTexCoords = TexCoordStream.GetArrayView<FVector2DHalf>();
+			OBJParallelFor(TEXT("RealtimeMeshObjLoader.TexCoords.PF"), Positions.Num(), 4096, [&](int32 Index)
+			{
+				const FVector2f TexCoord = TexCoords.IsValidIndex(Index) ? TexCoords[Index] : FVector2f::ZeroVector;
+				OutTexCoords[Index] = FVector2DHalf(TexCoord.X, TexCoord.Y);
+			});
+		}
+	}
+	else
+	{
+		// Attributes are indexed independently, so weld unique (position, normal, texcoord) combinations into vertices
+		TMap<FRealtimeMeshOBJLoadUniqueVertexKey, uint32> VertexMap;
+		TArray<FRealtimeMeshOBJLoadUniqueVertexKey> Vertices;
+		VertexMap.Reserve(Positions.Num());
+		Vertices.Reserve(Positions.Num());
+		for (int64 CornerIndex = 0; CornerIndex < Corners.Num(); CornerIndex++)
+		{
+			const FIntVector& Corner = Corners[CornerIndex];
+			const FRealtimeMeshOBJLoadUniqueVertexKey Key = { Corner.X, Corner.Z, Corner.Y };
+			uint32 VertexIndex;
+			if (const uint32* FoundVertex = VertexMap.Find(Key))
+			{
+				VertexIndex = *FoundVertex;
+			}
+			else
+			{
+				VertexIndex = Vertices.Add(Key);
+				VertexMap.Add(Key, VertexIndex);
+			}
+			Triangles[CornerIndex / 3].Indices[CornerIndex % 3] = VertexIndex;
+		}
+		Corners.Empty();
+		VertexMap.Empty();
+
+		const TArray<FVector3f> SourcePositions(Positions.GetData(), Positions.Num());
+		PositionStream.SetNumUninitialized(Vertices.Num());
+		const TArrayView<FVector3f> OutPositions = PositionStream.GetArrayView<FVector3f>();
+
+		TArrayView<FColor> OutColors;
+		if (bHasColors)
+		{
+			FRealtimeMeshStream& ColorStream = OutStreams.AddStream<FColor>(FRealtimeMeshStreams::Color);
+			ColorStream.SetNumUninitialized(Vertices.Num());
+			OutColors = ColorStream.GetArrayView<FColor>();
+		}
+
+		TArrayView<FRealtimeMeshTangentsNormalPrecision> OutTangents;
+		if (Normals.Num() > 0)
+		{
+			FRealtimeMeshStream& TangentStream = OutStreams.AddStream<FRealtimeMeshTangentsNormalPrecision>(FRealtimeMeshStreams::Tangents);
+			TangentStream.SetNumUninitialized(Vertices.Num());
+			OutTangents = TangentStream.GetArrayView<FRealtimeMeshTangentsNormalPrecision>();
+		}
+
+		TArrayView<FVector2DHalf> OutTexCoords;
+		if (TexCoords.Num() > 0)
+		{
+			FRealtimeMeshStream& TexCoordStream = OutStreams.AddStream<FVector2DHalf>(FRealtimeMeshStreams::TexCoords);
+			TexCoordStream.SetNumUninitialized(Vertices.Num());
+			OutTexCoords = TexCoordStream.GetArrayView<FVector2DHalf>();
+		}
+
+		OBJParallelFor(TEXT("RealtimeMeshObjLoader.Weld.PF"), Vertices.Num(), 4096, [&](int32 Index)
+		{
+			const FRealtimeMeshOBJLoadUniqueVertexKey& Vertex = Vertices[Index];
+			OutPositions[Index] = SourcePositions[Vertex.PositionIndex];
+			if (OutColors.Num() > 0)
+			{
+				OutColors[Index] = Colors[Vertex.PositionIndex];
+			}
+			if (OutTangents.Num() > 0)
+			{
+				OutTangents[Index] = FRealtimeMeshTangentsNormalPrecision(Vertex.NormalIndex != INDEX_NONE ? Normals[Vertex.NormalIndex] : FVector3f::UnitZ(), FVector3f::UnitX());
+			}
+			if (OutTexCoords.Num() > 0)
+			{
+				const FVector2f TexCoord = Vertex.TexCoordIndex != INDEX_NONE ? TexCoords[Vertex.TexCoordIndex] : FVector2f::ZeroVector;
+				OutTexCoords[Index] = FVector2DHalf(TexCoord.X, TexCoord.Y);
+			}
+		});
+	}
+
+	ensure(RealtimeMeshAlgo::OrganizeTrianglesByPolygonGroup(OutStreams, FRealtimeMeshStreams::Triangles, FRealtimeMeshStreams::PolyGroups));
+
+	if (Options.bGenerateTangents || Options.bGenerateSmoothTangents)
+	{
+		RealtimeMeshAlgo::GenerateTangents(OutStreams, Options.bGenerateSmoothTangents);
+	}
+
+	Result.bSuccess = true;
+	return Result;
+}
+
+
+static FRealtimeMeshOBJLoadResult LoadStreamSetWithTinyObj(FRealtimeMeshStreamSet& OutStreams, TArray<FRealtimeMeshOBJMaterial>& OutMaterials, const FString& FileName, const FRealtimeMeshOBJLoadOptions& Options)
+{
 	std::string FileNameString = TCHAR_TO_ANSI(*FileName);
 
 	tinyobj::ObjReaderConfig ReaderConfig;
@@ -279,6 +1174,30 @@ FRealtimeMeshOBJLoadResult URealtimeMeshObjLoader::LoadStreamSetFromOBJFile(FRea
 }
 
 
+FRealtimeMeshOBJLoadResult URealtimeMeshObjLoader::LoadStreamSetFromOBJFile(FRealtimeMeshStreamSet& OutStreams, TArray<FRealtimeMeshOBJMaterial>& OutMaterials, const FString& FileName,
+	const FRealtimeMeshOBJLoadOptions& Options, FRealtimeMeshOBJLoadProgress* Progress)
+{
+	OutStreams = FRealtimeMeshStreamSet();
+	OutMaterials.Empty();
+
+	FRealtimeMeshOBJLoadResult Result = Options.bUseStreamingParser
+		? LoadStreamSetWithStreamingParser(OutStreams, OutMaterials, FileName, Options, Progress)
+		: LoadStreamSetWithTinyObj(OutStreams, OutMaterials, FileName, Options);
+
+	if (!Result.bSuccess)
+	{
+		OutStreams = FRealtimeMeshStreamSet();
+		OutMaterials.Empty();
+	}
+
+	if (Progress)
+	{
+		Progress->FinishWork();
+	}
+	return Result;
+}
+
+
 FRealtimeMeshOBJLoadResult URealtimeMeshObjLoader::LoadStreamSetFromOBJFile(URealtimeMeshStreamSet* OutStreams, TArray<FRealtimeMeshOBJMaterial>& OutMaterials, const FString& FileName, const FRealtimeMeshOBJLoadOptions& Options)
 {
 	if (OutStreams == nullptr)
@@ -292,3 +1211,13 @@ FRealtimeMeshOBJLoadResult URealtimeMeshObjLoader::LoadStreamSetFromOBJFile(URea
 	return LoadStreamSetFromOBJFile(OutStreams->GetStreamSet(), OutMaterials, FileName, Options);
 }
 
+TFuture<TSharedRef<FRealtimeMeshOBJLoadOutput, ESPMode::ThreadSafe>> URealtimeMeshObjLoader::LoadStreamSetFromOBJFileAsync(const FString& FileName,
+	const FRealtimeMeshOBJLoadOptions& Options, const TSharedPtr<FRealtimeMeshOBJLoadProgress, ESPMode::ThreadSafe>& Progress)
+{
+	return DoOnAsyncThread([FileName, Options, Progress]()
+	{
+		TSharedRef<FRealtimeMeshOBJLoadOutput, ESPMode::ThreadSafe> Output = MakeShared<FRealtimeMeshOBJLoadOutput, ESPMode::ThreadSafe>();
+		Output->Result = LoadStreamSetFromOBJFile(Output->Streams, Output->Materials, FileName, Options, Progress.Get());
+		return Output;
+	});
+}
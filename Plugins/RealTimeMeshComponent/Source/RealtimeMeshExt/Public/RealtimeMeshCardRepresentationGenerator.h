@@ -16,6 +16,12 @@ class UDynamicMesh;
 class URealtimeMeshSimple;
 struct FRealtimeMeshCardRepresentation;
 
+namespace RealtimeMesh
+{
+	/** Opaque state carried between card generations of the same mesh, see FRealtimeMeshCardRepresentationGeneratorOptions::IncrementalState */
+	struct FRealtimeMeshCardGenerationState;
+}
+
 USTRUCT(BlueprintType)
 struct FRealtimeMeshCardRepresentationGeneratorOptions
 {
@@ -30,6 +36,13 @@ public:
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="RealtimeMesh|Representation")
 	bool bGenerateAsIfTwoSided = false;
+
+	/**
+	 * Optional state shared by successive generations of one mesh. While the mesh bounds still map to the same voxel grid
+	 * the surfel resolution and the card near planes of the previous generation are reused instead of searched for again.
+	 * Create it with URealtimeMeshCardRepresentationGenerator::MakeIncrementalState.
+	 */
+	TSharedPtr<RealtimeMesh::FRealtimeMeshCardGenerationState, ESPMode::ThreadSafe> IncrementalState;
 };
 
 
@@ -42,6 +55,9 @@ class REALTIMEMESHEXT_API URealtimeMeshCardRepresentationGenerator : public UBlu
 	GENERATED_BODY()
 public:
 
+	/** Creates a state for FRealtimeMeshCardRepresentationGeneratorOptions::IncrementalState, keep one per mesh that is regenerated often. */
+	static TSharedRef<RealtimeMesh::FRealtimeMeshCardGenerationState, ESPMode::ThreadSafe> MakeIncrementalState();
+
 	static ERealtimeMeshOutcomePins GenerateCardRepresentationForStreamSet(
 		const RealtimeMesh::FRealtimeMeshStreamSet& StreamSet,
 		const RealtimeMesh::FRealtimeMeshAABBTree3& StreamSetBVH,
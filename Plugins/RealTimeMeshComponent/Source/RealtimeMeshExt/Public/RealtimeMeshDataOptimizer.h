@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Mesh/RealtimeMeshDataStream.h"
+#include "Async/Future.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "RealtimeMeshDataOptimizer.generated.h"
 
@@ -16,6 +17,60 @@ enum class ERealtimeMeshOptimizationQuality : uint8
 	GenerationSpeed
 };
 
+namespace RealtimeMesh
+{
+	/**
+	 *	Which steps the combined optimization pass runs. Steps always run in the order
+	 *	indexing, vertex cache, overdraw, vertex fetch, same as calling them one by one.
+	 */
+	struct FRealtimeMeshOptimizationSettings
+	{
+		bool bOptimizeIndexing = true;
+		bool bOptimizeVertexCache = true;
+		ERealtimeMeshOptimizationQuality VertexCacheQuality = ERealtimeMeshOptimizationQuality::RenderingEfficiency;
+		bool bOptimizeOverdraw = true;
+		float OverdrawThreshold = 1.01f;
+		bool bOptimizeVertexFetch = true;
+	};
+
+	/**
+	 *	A stream set held in meshoptimizer's compressed vertex/index codec form.
+	 *	Meant for mesh data that is kept around but not currently needed, decode it back into a stream set before use.
+	 */
+	struct REALTIMEMESHEXT_API FRealtimeMeshEncodedStreamSet
+	{
+		enum class ECodec : uint8
+		{
+			Raw,
+			Vertex,
+			Index
+		};
+
+		struct FEncodedStream
+		{
+			FRealtimeMeshStreamKey StreamKey;
+			FRealtimeMeshBufferLayout Layout;
+			int32 Num = 0;
+			ECodec Codec = ECodec::Raw;
+			TArray<uint8> Data;
+		};
+
+		TArray<FEncodedStream> Streams;
+
+		bool IsEmpty() const { return Streams.IsEmpty(); }
+		void Empty() { Streams.Empty(); }
+		SIZE_T GetAllocatedSize() const
+		{
+			SIZE_T Size = Streams.GetAllocatedSize();
+			for (const FEncodedStream& Stream : Streams)
+			{
+				Size += Stream.Data.GetAllocatedSize();
+			}
+			return Size;
+		}
+	};
+}
+
 /**
  * 
  */
@@ -46,6 +101,39 @@ public:
 	 */
 	static void OptimizeVertexFetch(RealtimeMesh::FRealtimeMeshStreamSet& Streams);
 
+	/**
+	 *	Runs all the enabled optimizations as one pass. Works on scratch index/position copies between the steps,
+	 *	so the index stream and the vertex streams are each only rewritten once at the end.
+	 *	Vertex cache and overdraw optimization are kept within polygroup ranges so the PolyGroups stream stays valid.
+	 */
+	static void OptimizeMesh(RealtimeMesh::FRealtimeMeshStreamSet& Streams,
+		const RealtimeMesh::FRealtimeMeshOptimizationSettings& Settings = RealtimeMesh::FRealtimeMeshOptimizationSettings());
+
+	/**
+	 *	Runs OptimizeMesh on the realtime mesh thread pool and returns the optimized stream set.
+	 */
+	static TFuture<RealtimeMesh::FRealtimeMeshStreamSet> OptimizeMeshAsync(RealtimeMesh::FRealtimeMeshStreamSet&& Streams,
+		const RealtimeMesh::FRealtimeMeshOptimizationSettings& Settings = RealtimeMesh::FRealtimeMeshOptimizationSettings());
+
+	/**
+	 *	Queues one OptimizeMesh task per stream set on the realtime mesh thread pool.
+	 *	The returned futures are in the same order as the input sets.
+	 */
+	static TArray<TFuture<RealtimeMesh::FRealtimeMeshStreamSet>> OptimizeMeshesAsync(TArray<RealtimeMesh::FRealtimeMeshStreamSet>&& StreamSets,
+		const RealtimeMesh::FRealtimeMeshOptimizationSettings& Settings = RealtimeMesh::FRealtimeMeshOptimizationSettings());
+
+	/**
+	 *	Compresses every stream of the set with meshoptimizer's vertex and index codecs.
+	 *	Streams the codecs can't take (odd strides, non triangle indices) are stored as is.
+	 */
+	static void EncodeStreamSet(const RealtimeMesh::FRealtimeMeshStreamSet& Streams, RealtimeMesh::FRealtimeMeshEncodedStreamSet& OutEncoded);
+
+	/**
+	 *	Rebuilds the stream set from its encoded form, replacing any streams it already had.
+	 *	Returns false if any stream fails to decode.
+	 */
+	static bool DecodeStreamSet(const RealtimeMesh::FRealtimeMeshEncodedStreamSet& Encoded, RealtimeMesh::FRealtimeMeshStreamSet& OutStreams);
+
 
 	/**
 	 *	Generates, or re-generates the Triangles streams to remove redundant vertices.
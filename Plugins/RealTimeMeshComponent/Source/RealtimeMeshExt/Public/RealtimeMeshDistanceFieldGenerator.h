@@ -32,6 +32,31 @@ public:
 	bool bMultiThreadedGeneration = true;
 };
 
+namespace RealtimeMesh
+{
+	/**
+	 * Regular grid of heights along local +Z, everything below the surface is considered solid.
+	 * Heights are stored row major (X fastest), sample (X, Y) sits at Origin + (X, Y) * Spacing.
+	 */
+	struct REALTIMEMESHEXT_API FRealtimeMeshHeightfield
+	{
+		TArray<float> Heights;
+		FIntPoint Size = FIntPoint::ZeroValue;
+		FVector2f Origin = FVector2f::ZeroVector;
+		FVector2f Spacing = FVector2f::UnitVector;
+
+		bool IsValid() const;
+
+		float GetHeight(int32 X, int32 Y) const { return Heights[Y * Size.X + X]; }
+
+		/** Bilinearly samples the height at a local XY position, clamping to the edges of the grid. */
+		float SampleHeight(const FVector2f& Position) const;
+
+		/** Local space bounds covering the grid and the full height range. */
+		FBox GetBounds() const;
+	};
+}
+
 /**
  * 
  */
@@ -82,6 +107,16 @@ public:
 		FRealtimeMeshDistanceField& DistanceField,
 		FRealtimeMeshDistanceFieldGeneratorOptions Options = FRealtimeMeshDistanceFieldGeneratorOptions());
 
+	/**
+	 * Generates the distance field of a heightfield directly from its grid with a separable distance transform,
+	 * which is far cheaper than building and tracing a BVH of the triangulated surface.
+	 * The surface is treated as solid underneath, so bGenerateAsIfTwoSided and bUsePointQuery are ignored.
+	 */
+	static ERealtimeMeshOutcomePins GenerateDistanceFieldForHeightfield(
+		const RealtimeMesh::FRealtimeMeshHeightfield& Heightfield,
+		FRealtimeMeshDistanceField& DistanceField,
+		FRealtimeMeshDistanceFieldGeneratorOptions Options = FRealtimeMeshDistanceFieldGeneratorOptions());
+
 
 
 	
@@ -105,6 +140,10 @@ public:
 		UDynamicMesh* DynamicMesh,
 		FRealtimeMeshDistanceFieldGeneratorOptions Options = FRealtimeMeshDistanceFieldGeneratorOptions());
 
+	static TFuture<TTuple<ERealtimeMeshOutcomePins, FRealtimeMeshDistanceField>> GenerateDistanceFieldForHeightfieldAsync(
+		RealtimeMesh::FRealtimeMeshHeightfield&& Heightfield,
+		FRealtimeMeshDistanceFieldGeneratorOptions Options = FRealtimeMeshDistanceFieldGeneratorOptions());
+
 
 private:
 
@@ -3,8 +3,10 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Async/Future.h"
 #include "DynamicMesh/DynamicMesh3.h"
 #include "Mesh/RealtimeMeshDataStream.h"
+#include <atomic>
 #include "RealtimeMeshObjLoader.generated.h"
 
 class UDynamicMesh;
@@ -150,6 +152,54 @@ public:
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="RealtimeMesh|Loading|OBJ")
 	bool bGenerateSmoothTangents = true;
+
+	/** Memory map the file and tokenize it in parallel blocks. When off, falls back to tinyobjloader, which reads the whole file into memory on one thread. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="RealtimeMesh|Loading|OBJ")
+	bool bUseStreamingParser = true;
+
+	/** Size of the newline aligned blocks the streaming parser hands to each task. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="RealtimeMesh|Loading|OBJ", meta=(ClampMin=64, EditCondition="bUseStreamingParser"))
+	int32 ParseBlockSizeKB = 4096;
+};
+
+/**
+ * Progress and cancellation for an OBJ load in flight. Safe to poll and cancel from any thread.
+ */
+struct REALTIMEMESHEXT_API FRealtimeMeshOBJLoadProgress
+{
+	/** Fraction of the load completed, from 0 to 1 */
+	float GetProgress() const
+	{
+		const int64 Total = WorkTotal.load(std::memory_order_relaxed);
+		return Total > 0 ? FMath::Clamp(float(double(WorkDone.load(std::memory_order_relaxed)) / double(Total)), 0.0f, 1.0f) : 0.0f;
+	}
+
+	/** Asks the loader to stop at the next block boundary. The load then fails with a cancellation message. */
+	void Cancel() { bCancelled = true; }
+	bool IsCancelled() const { return bCancelled; }
+
+	void BeginWork(int64 Total)
+	{
+		WorkDone = 0;
+		WorkTotal = FMath::Max<int64>(Total, 1);
+	}
+	void AddWork(int64 Amount) { WorkDone.fetch_add(Amount, std::memory_order_relaxed); }
+	void FinishWork() { WorkDone = WorkTotal.load(); }
+
+private:
+	std::atomic<int64> WorkDone { 0 };
+	std::atomic<int64> WorkTotal { 0 };
+	std::atomic<bool> bCancelled { false };
+};
+
+/**
+ * Everything produced by an async OBJ load. Held by shared reference so the streams can be moved out without a copy.
+ */
+struct FRealtimeMeshOBJLoadOutput
+{
+	FRealtimeMeshOBJLoadResult Result;
+	FRealtimeMeshStreamSet Streams;
+	TArray<FRealtimeMeshOBJMaterial> Materials;
 };
 
 
@@ -164,11 +214,16 @@ class REALTIMEMESHEXT_API URealtimeMeshObjLoader : public UBlueprintFunctionLibr
 	GENERATED_BODY()
 public:
 
-	static FRealtimeMeshOBJLoadResult LoadStreamSetFromOBJFile(FRealtimeMeshStreamSet& OutStreams, TArray<FRealtimeMeshOBJMaterial>& OutMaterials, const FString& FileName, const FRealtimeMeshOBJLoadOptions& Options = FRealtimeMeshOBJLoadOptions());
+	static FRealtimeMeshOBJLoadResult LoadStreamSetFromOBJFile(FRealtimeMeshStreamSet& OutStreams, TArray<FRealtimeMeshOBJMaterial>& OutMaterials, const FString& FileName,
+		const FRealtimeMeshOBJLoadOptions& Options = FRealtimeMeshOBJLoadOptions(), FRealtimeMeshOBJLoadProgress* Progress = nullptr);
 
 	UFUNCTION(BlueprintCallable, Category="RealtimeMesh|Loading|OBJ")
 	static FRealtimeMeshOBJLoadResult LoadStreamSetFromOBJFile(URealtimeMeshStreamSet* OutStreams, TArray<FRealtimeMeshOBJMaterial>& OutMaterials, const FString& FileName, const FRealtimeMeshOBJLoadOptions& Options = FRealtimeMeshOBJLoadOptions());
 
+	/** Loads an OBJ file on a background thread. Pass a progress object to poll how far along the load is, or to cancel it. */
+	static TFuture<TSharedRef<FRealtimeMeshOBJLoadOutput, ESPMode::ThreadSafe>> LoadStreamSetFromOBJFileAsync(const FString& FileName,
+		const FRealtimeMeshOBJLoadOptions& Options = FRealtimeMeshOBJLoadOptions(), const TSharedPtr<FRealtimeMeshOBJLoadProgress, ESPMode::ThreadSafe>& Progress = nullptr);
+
 	/*static FRealtimeMeshOBJLoadResult LoadDynamicMeshFromOBJFile(UE::Geometry::FDynamicMesh3& OutMesh, TArray<FRealtimeMeshOBJMaterial>& OutMaterials, const FString& FileName, const FRealtimeMeshOBJLoadOptions& Options = FRealtimeMeshOBJLoadOptions());
 
 	UFUNCTION(BlueprintCallable, Category="RealtimeMesh|Loading|OBJ")
@@ -161,6 +161,66 @@ bool RealtimeMeshStreamConversionTests::RunTest(const FString& Parameters)
 	TestTrue(TEXT("Test Bulk Conversion Append/CopyRange"), InitialCombined == BulkConverted);
 
 
+	// Builder bulk append, odd count so the vectorized kernels also hit their scalar tail. Values aren't exactly
+	// representable in float/half so the narrowing has to round, and there are more gather indices than one gather chunk.
+	TArray<FVector3d> DoublePositions;
+	TArray<FVector2f> FloatTexCoords;
+	for (int32 Index = 0; Index < 11; Index++)
+	{
+		DoublePositions.Add(FVector3d(Index / 3.0, -Index * 0.1, 1.0e7 + Index * 0.3));
+		FloatTexCoords.Add(FVector2f(Index / 7.0f, 1.0f - Index * 0.0123f));
+	}
+	TArray<int32> GatherIndices;
+	for (int32 Index = 0; Index < 150; Index++)
+	{
+		GatherIndices.Add((Index * 7 + 3) % DoublePositions.Num());
+	}
+
+	// Non-const arrays and views on purpose, both have to reach the bulk overloads
+	FRealtimeMeshStream BulkPositionStream = FRealtimeMeshStream::Create<FVector3f>(FRealtimeMeshStreams::Position);
+	TRealtimeMeshStreamBuilder<FVector3d, FVector3f> BulkPositionBuilder(BulkPositionStream);
+	BulkPositionBuilder.Append(MakeArrayView(DoublePositions));
+	BulkPositionBuilder.AppendIndexed(MakeArrayView(DoublePositions), MakeArrayView(GatherIndices));
+
+	FRealtimeMeshStream BulkTexCoordStream = FRealtimeMeshStream::Create<FVector2DHalf>(FRealtimeMeshStreams::TexCoords);
+	TRealtimeMeshStreamBuilder<FVector2f, FVector2DHalf> BulkTexCoordBuilder(BulkTexCoordStream);
+	BulkTexCoordBuilder.Append(FloatTexCoords);
+	BulkTexCoordBuilder.AppendIndexed(FloatTexCoords, GatherIndices);
+
+	TestEqual(TEXT("Bulk Append Position Count"), BulkPositionBuilder.Num(), DoublePositions.Num() + GatherIndices.Num());
+	TestEqual(TEXT("Bulk Append TexCoord Count"), BulkTexCoordBuilder.Num(), FloatTexCoords.Num() + GatherIndices.Num());
+
+	// Hand convert the expected contents, once element by element and once through the bulk kernels
+	TArray<FVector3d> ExpandedPositions;
+	TArray<FVector2f> ExpandedTexCoords;
+	for (int32 Index = 0; Index < DoublePositions.Num() + GatherIndices.Num(); Index++)
+	{
+		const int32 SourceIndex = Index < DoublePositions.Num()? Index : GatherIndices[Index - DoublePositions.Num()];
+		ExpandedPositions.Add(DoublePositions[SourceIndex]);
+		ExpandedTexCoords.Add(FloatTexCoords[SourceIndex]);
+	}
+	TArray<FVector3f> KernelPositions;
+	KernelPositions.SetNumUninitialized(ExpandedPositions.Num());
+	TRealtimeMeshBulkConverter<FVector3d, FVector3f>::Convert(ExpandedPositions.GetData(), KernelPositions.GetData(), ExpandedPositions.Num());
+	TArray<FVector2DHalf> KernelTexCoords;
+	KernelTexCoords.SetNumUninitialized(ExpandedTexCoords.Num());
+	TRealtimeMeshBulkConverter<FVector2f, FVector2DHalf>::Convert(ExpandedTexCoords.GetData(), KernelTexCoords.GetData(), ExpandedTexCoords.Num());
+
+	TestTrue(TEXT("Bulk Position matches kernel output"), BulkPositionStream.Num() == KernelPositions.Num() &&
+		FMemory::Memcmp(BulkPositionStream.GetData(), KernelPositions.GetData(), KernelPositions.Num() * sizeof(FVector3f)) == 0);
+	TestTrue(TEXT("Bulk TexCoord matches kernel output"), BulkTexCoordStream.Num() == KernelTexCoords.Num() &&
+		FMemory::Memcmp(BulkTexCoordStream.GetData(), KernelTexCoords.GetData(), KernelTexCoords.Num() * sizeof(FVector2DHalf)) == 0);
+
+	for (int32 Index = 0; Index < ExpandedPositions.Num(); Index++)
+	{
+		const FVector3f ExpectedPosition = FVector3f(ExpandedPositions[Index]);
+		const FVector2DHalf ExpectedTexCoord = FVector2DHalf(ExpandedTexCoords[Index]);
+		TestTrue(FString::Printf(TEXT("Bulk Position: %d"), Index), BulkPositionStream.GetArrayView<FVector3f>()[Index] == ExpectedPosition);
+		const FVector2DHalf& TexCoord = BulkTexCoordStream.GetArrayView<FVector2DHalf>()[Index];
+		TestTrue(FString::Printf(TEXT("Bulk TexCoord: %d"), Index), TexCoord.X.Encoded == ExpectedTexCoord.X.Encoded && TexCoord.Y.Encoded == ExpectedTexCoord.Y.Encoded);
+	}
+
+
 
 
 
@@ -1,9 +1,13 @@
 ﻿// Copyright TriAxis Games, L.L.C. All Rights Reserved.
 
 #include "Mesh/RealtimeMeshAlgo.h"
+#include "RealtimeMeshMemoryStats.h"
+#include "Mesh/RealtimeMeshStreamPool.h"
 #include "Misc/AutomationTest.h"
 
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(RealtimeMeshStreamMemoryTest, "Private.RealtimeMeshStreamMemoryTest", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(RealtimeMeshMemoryCountersTest, "Private.RealtimeMeshMemoryCountersTest", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(RealtimeMeshStreamPoolTest, "Private.RealtimeMeshStreamPoolTest", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
 
 using namespace RealtimeMesh;
 
@@ -47,3 +51,93 @@ bool RealtimeMeshStreamMemoryTest::RunTest(const FString& Parameters)
 	// Make the test pass by returning true, or fail by returning false.
 	return true;
 }
+
+bool RealtimeMeshMemoryCountersTest::RunTest(const FString& Parameters)
+{
+	FRealtimeMeshStreamSet StreamSet;
+	FRealtimeMeshStream& Positions = StreamSet.AddStream(FRealtimeMeshStreams::Position, GetRealtimeMeshBufferLayout<FVector3f>());
+	Positions.SetNumUninitialized(100);
+	FRealtimeMeshStream& Triangles = StreamSet.AddStream(FRealtimeMeshStreams::Triangles, GetRealtimeMeshBufferLayout<TIndex3<uint32>>());
+	Triangles.SetNumUninitialized(50);
+
+	TestTrue(TEXT("Stream set size covers all streams"), StreamSet.GetAllocatedSize() >= 100 * sizeof(FVector3f) + 50 * sizeof(TIndex3<uint32>));
+	TestEqual(TEXT("Stream set size is the sum of its streams"), StreamSet.GetAllocatedSize(), Positions.GetAllocatedSize() + Triangles.GetAllocatedSize());
+
+	// Collision is only reported from the game thread, so its global total can't move under us here
+	const int64 GlobalCollisionBefore = FRealtimeMeshMemoryTracker::GetGlobalUsage().CollisionBytes;
+	const int32 NumMeshesBefore = FRealtimeMeshMemoryTracker::GetNumTrackedMeshes();
+	{
+		FRealtimeMeshMemoryCounters Counters;
+		Counters.SetOwnerName(TEXT("MemoryCountersTest"));
+		TestEqual(TEXT("Counters are registered"), FRealtimeMeshMemoryTracker::GetNumTrackedMeshes(), NumMeshesBefore + 1);
+
+		int64 TrackedCPUBytes = 0;
+		Counters.UpdateBytes(ERealtimeMeshMemoryCategory::CPUStreams, TrackedCPUBytes, StreamSet.GetAllocatedSize());
+		TestEqual(TEXT("CPU bytes reported"), Counters.GetBytes(ERealtimeMeshMemoryCategory::CPUStreams), static_cast<int64>(StreamSet.GetAllocatedSize()));
+
+		Counters.UpdateBytes(ERealtimeMeshMemoryCategory::CPUStreams, TrackedCPUBytes, 64);
+		TestEqual(TEXT("CPU bytes replaced by new measurement"), Counters.GetBytes(ERealtimeMeshMemoryCategory::CPUStreams), 64ll);
+		TestEqual(TEXT("Tracked value follows"), TrackedCPUBytes, 64ll);
+
+		Counters.AddBytes(ERealtimeMeshMemoryCategory::Collision, 1000);
+		TestEqual(TEXT("Collision reaches global total"), FRealtimeMeshMemoryTracker::GetGlobalUsage().CollisionBytes, GlobalCollisionBefore + 1000);
+		TestEqual(TEXT("Usage total"), Counters.GetUsage().GetTotalBytes(), 1064ll);
+
+		const auto TopConsumers = FRealtimeMeshMemoryTracker::GetTopConsumers(TNumericLimits<int32>::Max());
+		TestTrue(TEXT("Counters listed as consumer"), TopConsumers.ContainsByPredicate([](const TPair<FString, FRealtimeMeshMemoryUsage>& Entry)
+		{
+			return Entry.Key == TEXT("MemoryCountersTest") && Entry.Value.GetTotalBytes() == 1064;
+		}));
+	}
+	TestEqual(TEXT("Counters are unregistered"), FRealtimeMeshMemoryTracker::GetNumTrackedMeshes(), NumMeshesBefore);
+	TestEqual(TEXT("Destroyed counters leave the global total"), FRealtimeMeshMemoryTracker::GetGlobalUsage().CollisionBytes, GlobalCollisionBefore);
+
+	return true;
+}
+
+bool RealtimeMeshStreamPoolTest::RunTest(const FString& Parameters)
+{
+	// Own pool so other meshes releasing into the shared one can't interfere
+	FRealtimeMeshStreamPool Pool(16 * 1024 * 1024);
+
+	FRealtimeMeshStreamSet StreamSet;
+	FRealtimeMeshStream& Positions = Pool.AddStream(StreamSet, FRealtimeMeshStreams::Position, GetRealtimeMeshBufferLayout<FVector3f>(), 1000);
+	TestEqual(TEXT("Acquired stream is empty"), Positions.Num(), 0);
+	TestTrue(TEXT("Acquired stream is reserved"), Positions.Max() >= 1000);
+	Positions.SetNumUninitialized(1000);
+	const void* PositionData = Positions.GetData();
+	Pool.AddStream(StreamSet, FRealtimeMeshStreams::Triangles, GetRealtimeMeshBufferLayout<TIndex3<uint32>>(), 500).SetNumUninitialized(500);
+
+	const int64 SetBytes = static_cast<int64>(StreamSet.GetAllocatedSize());
+	Pool.Release(StreamSet);
+	TestTrue(TEXT("Released set is empty"), StreamSet.IsEmpty());
+	TestEqual(TEXT("Both streams pooled"), Pool.GetNumPooledStreams(), 2);
+	TestEqual(TEXT("Pooled bytes match the released streams"), Pool.GetPooledBytes(), SetBytes);
+
+	// Same layout comes back with its allocation, under the new key
+	FRealtimeMeshStream& Reused = Pool.AddStream(StreamSet, FRealtimeMeshStreams::Position, GetRealtimeMeshBufferLayout<FVector3f>(), 800);
+	TestTrue(TEXT("Allocation reused"), Reused.GetData() == PositionData);
+	TestEqual(TEXT("Reused stream is reset"), Reused.Num(), 0);
+	TestTrue(TEXT("Reused stream keeps its key"), Reused.GetStreamKey() == FRealtimeMeshStreams::Position);
+	TestEqual(TEXT("One stream left in the pool"), Pool.GetNumPooledStreams(), 1);
+
+	// A different layout doesn't match the pooled index stream
+	Pool.AddStream(StreamSet, FRealtimeMeshStreams::PolyGroups, GetRealtimeMeshBufferLayout<uint16>(), 500);
+	TestEqual(TEXT("Other layouts allocate"), Pool.GetNumPooledStreams(), 1);
+
+	// Adding over an existing key releases the old stream first, so it comes straight back
+	FRealtimeMeshStream& Replaced = Pool.AddStream(StreamSet, FRealtimeMeshStreams::Position, GetRealtimeMeshBufferLayout<FVector3f>());
+	TestTrue(TEXT("Replaced stream reused"), Replaced.GetData() == PositionData);
+	TestEqual(TEXT("Pool unchanged by replacing"), Pool.GetNumPooledStreams(), 1);
+
+	Pool.Trim(0);
+	TestEqual(TEXT("Trim frees everything"), Pool.GetNumPooledStreams(), 0);
+	TestEqual(TEXT("Trim leaves no bytes"), Pool.GetPooledBytes(), 0ll);
+
+	// Nothing is kept past the budget
+	FRealtimeMeshStreamPool TinyPool(16);
+	TinyPool.Release(StreamSet);
+	TestEqual(TEXT("Over budget streams are freed"), TinyPool.GetNumPooledStreams(), 0);
+
+	return true;
+}
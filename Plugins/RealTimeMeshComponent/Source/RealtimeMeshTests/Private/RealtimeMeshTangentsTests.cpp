@@ -0,0 +1,64 @@
+﻿// Copyright TriAxis Games, L.L.C. All Rights Reserved.
+
+#include "Mesh/RealtimeMeshAlgo.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(RealtimeMeshTangentsTests, "RealtimeMeshComponent.RealtimeMeshTangents", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool RealtimeMeshTangentsTests::RunTest(const FString& Parameters)
+{
+	// Two faces folded along a shared edge, the edge vertices are split (3 and 4 duplicate 0 and 1) like a UV seam
+	const TArray<FVector3f> Vertices =
+	{
+		FVector3f(0, 0, 0),
+		FVector3f(0, 1, 0),
+		FVector3f(-1, 0, -1),
+		FVector3f(0, 0, 0),
+		FVector3f(0, 1, 0),
+		FVector3f(1, 0, -1),
+	};
+	const TArray<uint32> Indices = { 0, 1, 2, 3, 5, 4 };
+
+	TArray<int32> OverlapOffsets;
+	TArray<uint32> Overlaps;
+	RealtimeMeshAlgo::Private::FindOverlappingVertices(Vertices, OverlapOffsets, Overlaps);
+	TestEqual(TEXT("OverlapCount"), Overlaps.Num(), 4);
+	TestEqual(TEXT("Overlap0"), OverlapOffsets[1] - OverlapOffsets[0], 1);
+	TestEqual(TEXT("Overlap0Target"), Overlaps[OverlapOffsets[0]], 3u);
+	TestEqual(TEXT("Overlap2"), OverlapOffsets[3] - OverlapOffsets[2], 0);
+
+	TArray<int32> VertToTriOffsets;
+	TArray<uint32> VertToTris;
+	RealtimeMeshAlgo::Private::BuildVertexTriangleAdjacency(Indices, Vertices.Num(), VertToTriOffsets, VertToTris);
+	TestEqual(TEXT("AdjacencyCount"), VertToTris.Num(), 6);
+	TestEqual(TEXT("Adjacency5"), VertToTris[VertToTriOffsets[5]], 1u);
+
+	const auto Generate = [&](bool bSmooth)
+	{
+		TArray<FVector3f> Normals;
+		Normals.SetNum(Vertices.Num());
+		RealtimeMeshAlgo::GenerateTangents<uint32>(Indices, Vertices, nullptr, [&](int32 Index, FVector3f TangentX, FVector3f TangentZ)
+		{
+			Normals[Index] = TangentZ;
+		}, bSmooth);
+		return Normals;
+	};
+
+	const TArray<FVector3f> FlatNormals = Generate(false);
+	const TArray<FVector3f> SmoothNormals = Generate(true);
+
+	// Without smoothing the seam keeps each face's normal
+	TestTrue(TEXT("FlatSeamA"), FlatNormals[0].Equals(FlatNormals[2]));
+	TestTrue(TEXT("FlatSeamB"), FlatNormals[3].Equals(FlatNormals[5]));
+
+	// With smoothing both sides of the seam see both faces, the unshared corners still only see their own
+	const FVector3f Expected = (FlatNormals[2] + FlatNormals[5]).GetSafeNormal();
+	for (const int32 Index : { 0, 1, 3, 4 })
+	{
+		TestTrue(FString::Printf(TEXT("SmoothSeam: %d"), Index), SmoothNormals[Index].Equals(Expected));
+	}
+	TestTrue(TEXT("SmoothCornerA"), SmoothNormals[2].Equals(FlatNormals[2]));
+	TestTrue(TEXT("SmoothCornerB"), SmoothNormals[5].Equals(FlatNormals[5]));
+
+	return true;
+}
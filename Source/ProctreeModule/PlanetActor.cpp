@@ -6,6 +6,7 @@
 #include <Camera/CameraComponent.h>
 #include <Mesh/RealtimeMeshSimpleData.h>
 #include <Mesh/RealtimeMeshBasicShapeTools.h>
+#include "RenderProxy/RealtimeMeshProxyCommandBatch.h"
 
 // Sets default values
 APlanetActor::APlanetActor()
@@ -25,6 +26,7 @@ void APlanetActor::BeginDestroy()
 	for (int i = 0; i < 6; i++) {
 		RootNodes[i] = nullptr;
 	}
+	NodePool.Reset();
 }
 
 void APlanetActor::OnConstruction(const FTransform& Transform)
@@ -68,21 +70,55 @@ void APlanetActor::InitializePlanet()
 	TSharedPtr<INoiseGenerator> NoiseGen5 = MakeShared<TerrestrialNoiseGenerator>();
 	NoiseGen5->InitializeNode(this->PlanetMeshParameters.seed, NoiseAmplitude, NoiseFrequency, SeaLevel);
 
+	//Passes still running against the old tree can't release the face flags anymore, start the new tree with them clear
+	InitGeneration++;
+	for (int i = 0; i < 6; i++) {
+		FaceLodRunning[i] = false;
+		FaceMeshRunning[i] = false;
+	}
+
 	double size = 1000.0;
 	double halfSize = size * .5;	
 
-	RootNodes[(uint8)EFaceDirection::X_POS] = MakeShared<QuadTreeNode>(this, NoiseGen0, FCubeTransform::FaceTransforms[(uint8)EFaceDirection::X_POS], FQuadIndex((uint8)EFaceDirection::X_POS), FVector( halfSize, 0.0f, 0.0f), size, this->PlanetMeshParameters.planetRadius, this->MinNodeDepth, this->MaxNodeDepth);
-	RootNodes[(uint8)EFaceDirection::X_NEG] = MakeShared<QuadTreeNode>(this, NoiseGen1, FCubeTransform::FaceTransforms[(uint8)EFaceDirection::X_NEG], FQuadIndex((uint8)EFaceDirection::X_NEG), FVector(-halfSize, 0.0f, 0.0f), size, this->PlanetMeshParameters.planetRadius, this->MinNodeDepth, this->MaxNodeDepth);
-	RootNodes[(uint8)EFaceDirection::Y_POS] = MakeShared<QuadTreeNode>(this, NoiseGen2, FCubeTransform::FaceTransforms[(uint8)EFaceDirection::Y_POS], FQuadIndex((uint8)EFaceDirection::Y_POS), FVector(0.0f,  halfSize, 0.0f), size, this->PlanetMeshParameters.planetRadius, this->MinNodeDepth, this->MaxNodeDepth);
-	RootNodes[(uint8)EFaceDirection::Y_NEG] = MakeShared<QuadTreeNode>(this, NoiseGen3, FCubeTransform::FaceTransforms[(uint8)EFaceDirection::Y_NEG], FQuadIndex((uint8)EFaceDirection::Y_NEG), FVector(0.0f, -halfSize, 0.0f), size, this->PlanetMeshParameters.planetRadius, this->MinNodeDepth, this->MaxNodeDepth);
-	RootNodes[(uint8)EFaceDirection::Z_POS] = MakeShared<QuadTreeNode>(this, NoiseGen4, FCubeTransform::FaceTransforms[(uint8)EFaceDirection::Z_POS], FQuadIndex((uint8)EFaceDirection::Z_POS), FVector(0.0f, 0.0f,  halfSize), size, this->PlanetMeshParameters.planetRadius, this->MinNodeDepth, this->MaxNodeDepth);
-	RootNodes[(uint8)EFaceDirection::Z_NEG] = MakeShared<QuadTreeNode>(this, NoiseGen5, FCubeTransform::FaceTransforms[(uint8)EFaceDirection::Z_NEG], FQuadIndex((uint8)EFaceDirection::Z_NEG), FVector(0.0f, 0.0f, -halfSize), size, this->PlanetMeshParameters.planetRadius, this->MinNodeDepth, this->MaxNodeDepth);
-
+	//Roots take two pool blocks, faces 0-3 and 4-5
+	NodePool = MakeShared<FQuadTreeNodePool, ESPMode::ThreadSafe>();
+	uint32 rootBlocks[2] = { NodePool->AllocateBlock(), NodePool->AllocateBlock() };
+	auto constructRoot = [&](EFaceDirection InFace, TSharedPtr<INoiseGenerator> InNoiseGen, FVector InCenter) {
+		uint8 faceId = (uint8)InFace;
+		RootNodes[faceId] = NodePool->Construct(rootBlocks[faceId / 4], faceId % 4, [&](void* Memory) {
+			return new (Memory) QuadTreeNode(this, InNoiseGen, FCubeTransform::FaceTransforms[faceId], FQuadIndex(faceId), InCenter, size, this->PlanetMeshParameters.planetRadius, this->MinNodeDepth, this->MaxNodeDepth);
+		});
+	};
+	constructRoot(EFaceDirection::X_POS, NoiseGen0, FVector( halfSize, 0.0f, 0.0f));
+	constructRoot(EFaceDirection::X_NEG, NoiseGen1, FVector(-halfSize, 0.0f, 0.0f));
+	constructRoot(EFaceDirection::Y_POS, NoiseGen2, FVector(0.0f,  halfSize, 0.0f));
+	constructRoot(EFaceDirection::Y_NEG, NoiseGen3, FVector(0.0f, -halfSize, 0.0f));
+	constructRoot(EFaceDirection::Z_POS, NoiseGen4, FVector(0.0f, 0.0f,  halfSize));
+	constructRoot(EFaceDirection::Z_NEG, NoiseGen5, FVector(0.0f, 0.0f, -halfSize));
+
+	//Allocate straight down to MinNodeDepth instead of splitting a level per LOD pass, the intermediate levels would
+	//never be seen. Only the leaves get chunks, their meshes are generated in parallel off the game thread.
+	TArray<QuadTreeNode*> startLeaves;
+	int startDepth = FMath::Clamp(this->MinNodeDepth, 0, this->MaxNodeDepth);
 	for (int i = 0; i < 6; i++) {
-		RootNodes[i]->InitializeChunk();
-		RootNodes[i]->GenerateMeshData();
+		QuadTreeNode::AllocateToDepth(RootNodes[i], startDepth, startLeaves);
+	}
+	TArray<FNodeHandle> startHandles;
+	startHandles.Reserve(startLeaves.Num());
+	for (QuadTreeNode* leaf : startLeaves) {
+		leaf->InitializeChunk();
+		startHandles.Add(leaf->Handle);
 	}
+	Async(EAsyncExecution::LargeThreadPool, [pool = NodePool, startHandles]() {
+		ParallelFor(startHandles.Num(), [&](int32 i) {
+			if (FPinnedNode leaf = pool->Pin(startHandles[i])) {
+				leaf->GenerateMeshData();
+			}
+		});
+	});
 
+	ResidentMeshBytes = 0;
+	EvictedNodeCount = 0;
 	this->IsInitialized = true;
 	ScheduleDataUpdate(.1);
 	ScheduleMeshUpdate(.1);
@@ -90,27 +126,146 @@ void APlanetActor::InitializePlanet()
 
 void APlanetActor::UpdateLOD()
 {
-	Async(EAsyncExecution::LargeThreadPool, [this]() {
-		ParallelFor(6, [&](int32 i) {
-			RootNodes[i]->UpdateLod();
+	Async(EAsyncExecution::LargeThreadPool, [weakPlanet = TWeakObjectPtr<APlanetActor>(this), pool = NodePool]() {
+		APlanetActor* planet = weakPlanet.Get();
+		if (!planet || planet->IsDestroyed || !pool.IsValid()) return;
+		//Blocks released long enough ago that no pass can still be using them go back to the pool
+		pool->Reclaim(FPlatformTime::Seconds());
+
+		//One leaf set across every face, so the work follows the camera instead of being split six ways up front.
+		//A face still busy with the previous pass is skipped rather than waited on, the next pass picks it up.
+		TArray<QuadTreeNode*> leaves;
+		leaves.Reserve(planet->LastLodLeafCount);
+		bool claimedFaces[6] = {};
+		for (int i = 0; i < 6; i++) {
+			bool expected = false;
+			claimedFaces[i] = planet->FaceLodRunning[i].compare_exchange_strong(expected, true);
+			if (claimedFaces[i]) {
+				QuadTreeNode::CollectLeaves(planet->RootNodes[i], leaves);
+			}
+		}
+		//Read after claiming, a re-initialization from here on resets the flags itself and this pass must leave them alone
+		uint32 generation = planet->InitGeneration.load();
+		planet->LastLodLeafCount = leaves.Num();
+
+		//Camera and transform are read once for the whole pass
+		FLodViewSnapshot view;
+		double actorScale = planet->GetActorScale().X;
+		view.CameraLocal = (planet->GetLastCameraPosition() - planet->GetActorLocation()) / actorScale;
+		view.FovFactor = 2.0 * FMath::Tan(FMath::DegreesToRadians(planet->GetCameraFOV()) * .5);
+		view.SplitThreshold = planet->LodSplitThreshold;
+		view.MergeThreshold = planet->LodSplitThreshold * planet->LodMergeHysteresis;
+		view.Now = FPlatformTime::Seconds();
+
+		//Idle workers steal batches from the shared range, small batches keep the tail short when one region is busy
+		FLodLeafBounds bounds;
+		bounds.SetNum(leaves.Num());
+		ParallelFor(TEXT("PlanetLodGather.PF"), leaves.Num(), LodBatchSize, [&](int32 i) {
+			leaves[i]->ReleaseExpiredChildren(view.Now);
+			leaves[i]->WriteLodBounds(bounds, i);
 		});
-		ParallelFor(6, [&](int32 i) {
-			RootNodes[i]->UpdateNeighbors();
+
+		//Only leaves that need to act come back, at steady state the list is empty
+		TArray<FLodCommand> commands;
+		bounds.Evaluate(view, commands);
+		ParallelFor(TEXT("PlanetLodApply.PF"), commands.Num(), LodBatchSize, [&](int32 i) {
+			leaves[commands[i].LeafIndex]->ApplyLodCommand(commands[i].Command, view.Now);
 		});
+
+		//A re-initialization during the pass already cleared the flags for the new tree
+		if (generation == planet->InitGeneration.load()) {
+			for (int i = 0; i < 6; i++) {
+				if (claimedFaces[i]) planet->FaceLodRunning[i] = false;
+			}
+		}
+		planet->EnforceResidencyBudget();
+		bool expected = false;
+		if (planet->NeighborPassRunning.compare_exchange_strong(expected, true)) {
+			planet->UpdateNeighbors();
+			planet->NeighborPassRunning = false;
+		}
+	});
+}
+
+void APlanetActor::EnforceResidencyBudget()
+{
+	int64 budgetBytes = (int64)MeshResidencyBudgetMB * 1024 * 1024;
+	int64 overBudget = ResidentMeshBytes.load() - budgetBytes;
+	if (budgetBytes <= 0 || overBudget <= 0) return;
+
+	//Leaves are always resident, only ancestors hidden behind their children can give their data up.
+	//The ones hidden longest go first, a recently hidden parent is the most likely to be merged back.
+	TArray<QuadTreeNode*> candidates;
+	for (int i = 0; i < 6; i++) {
+		QuadTreeNode::CollectHiddenAncestors(RootNodes[i], candidates);
+	}
+	candidates.Sort([](const QuadTreeNode& A, const QuadTreeNode& B) {
+		return A.LastVisibleTime < B.LastVisibleTime;
+	});
+
+	TArray<FNodeRef> evictions;
+	for (QuadTreeNode* candidate : candidates) {
+		if (overBudget <= 0) break;
+		overBudget -= candidate->ResidentBytes.load();
+		evictions.Add(candidate->GetRef());
+	}
+	if (evictions.Num() == 0) return;
+	AsyncTask(ENamedThreads::GameThread, [evictions = MoveTemp(evictions)]() {
+		RealtimeMesh::FRealtimeMeshUpdateBatch updateBatch;
+		for (const FNodeRef& nodeRef : evictions) {
+			if (FPinnedNode node = nodeRef.Pin()) {
+				node->EvictMeshData();
+			}
+		}
+	});
+}
+
+void APlanetActor::EnqueueNeighborUpdate(QuadTreeNode* InNode)
+{
+	if (InNode) {
+		NeighborUpdateQueue.Enqueue(InNode->GetRef());
+	}
+}
+
+void APlanetActor::UpdateNeighbors()
+{
+	//Drain whatever split/merge pushed since the last pass, at steady state this is empty and costs nothing
+	TSet<QuadTreeNode*> pendingSet;
+	TArray<FPinnedNode> pending;
+	FNodeRef queuedNode;
+	while (NeighborUpdateQueue.Dequeue(queuedNode)) {
+		//References from a pool replaced by a re-initialization are stale even if they still resolve
+		if (queuedNode.Pool != NodePool) continue;
+		FPinnedNode node = queuedNode.Pin();
+		if (node && node->IsLeaf() && !pendingSet.Contains(node.Get())) {
+			pendingSet.Add(node.Get());
+			pending.Add(MoveTemp(node));
+		}
+	}
+	if (pending.Num() == 0) return;
+
+	ParallelFor(pending.Num(), [&](int32 i) {
+		if (pending[i]->CheckNeighbors()) pending[i]->isEdgeRangeDirty = true;
 	});
 }
 
 void APlanetActor::UpdateMesh()
 {
 	ParallelFor(6, [&](int32 i) {
-		RootNodes[i]->UpdateAllMesh();
+		//UpdateAllMesh only queues the submission, the face stays claimed until that game thread task clears it
+		bool expected = false;
+		if (!FaceMeshRunning[i].compare_exchange_strong(expected, true)) return;
+		RootNodes[i]->UpdateAllMesh(InitGeneration.load());
 	});
 }
 
-TSharedPtr<QuadTreeNode> APlanetActor::GetNodeByIndex(const FQuadIndex& Index) const
+QuadTreeNode* APlanetActor::GetNodeByIndex(const FQuadIndex& Index) const
 {
 	// Get the root node for the specified face
-	TSharedPtr<QuadTreeNode> currentNode = RootNodes[Index.FaceId];
+	QuadTreeNode* currentNode = RootNodes[Index.FaceId];
+	if (!currentNode)
+		return nullptr;
+	FReadScopeLock FaceLock(FaceLocks[Index.FaceId]);
 
 	// If we're looking for the root node, return it immediately
 	if (Index.IsRoot())
@@ -128,7 +283,7 @@ TSharedPtr<QuadTreeNode> APlanetActor::GetNodeByIndex(const FQuadIndex& Index) c
 			return currentNode;  // Node doesn't exist at requested depth
 
 		// Move to the next child in the path
-		currentNode = currentNode->Children[quadrant];
+		currentNode = currentNode->GetChild(quadrant);
 	}
 
 	return currentNode;
@@ -169,6 +324,16 @@ FVector APlanetActor::GetCameraOverridePosition()
 	return this->CameraOverridePositionInternal;
 }
 
+int64 APlanetActor::GetResidentMeshBytes() const
+{
+	return ResidentMeshBytes.load();
+}
+
+int32 APlanetActor::GetEvictedNodeCount() const
+{
+	return EvictedNodeCount.load();
+}
+
 // Called every frame
 void APlanetActor::TickActor(float DeltaTime, ELevelTick TickType, FActorTickFunction& ThisTickFunction)
 {
@@ -211,7 +376,6 @@ void APlanetActor::ScheduleDataUpdate(float IntervalInSeconds)
 				//**********BEGIN IMPLEMENTATION BLOCK***************
 				//**********BEGIN IMPLEMENTATION BLOCK***************
 				{
-					FWriteScopeLock WriteLock(xPosLock);
 					if (IsDestroyed) return;
 					UpdateLOD();
 				}
@@ -241,7 +405,6 @@ void APlanetActor::ScheduleMeshUpdate(float IntervalInSeconds)
 				//**********BEGIN IMPLEMENTATION BLOCK***************
 				//**********BEGIN IMPLEMENTATION BLOCK***************
 				{
-					FWriteScopeLock WriteLock(xPosLock);
 					if (IsDestroyed) return;
 					UpdateMesh();
 				}
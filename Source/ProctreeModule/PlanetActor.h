@@ -8,6 +8,8 @@
 #include <Camera/CameraComponent.h>
 #include <Mesh/RealtimeMeshSimpleData.h>
 #include "PlanetSharedStructs.h"
+#include "QuadTreeNodePool.h"
+#include <atomic>
 #include "PlanetActor.generated.h"
 
 class QuadTreeNode;
@@ -56,6 +58,33 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Planet Config")
     int FaceResolution = 17;
 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Planet Config")
+	ECubeSphereProjection Projection = ECubeSphereProjection::EVERITT;
+
+	//Screen space size factor a node has to exceed before it splits
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Planet Config|LOD")
+	double LodSplitThreshold = 8.0;
+
+	//Multiplier on the split threshold a parent has to drop under before its children merge, must be > 1 to avoid thrash
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Planet Config|LOD", meta = (ClampMin = "1.0"))
+	double LodMergeHysteresis = 1.25;
+
+	//Seconds a node must remain a leaf before it can split again or be merged away
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Planet Config|LOD", meta = (ClampMin = "0.0"))
+	double MinNodeLifetime = 0.5;
+
+	//Seconds merged children are kept hidden so a quick re-split is free, 0 destroys them immediately
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Planet Config|LOD", meta = (ClampMin = "0.0"))
+	double MergedChildRetentionTime = 5.0;
+
+	//Mesh memory the planet may keep resident, hidden ancestors are evicted least recently seen first once it is exceeded. 0 disables eviction
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Planet Config|Residency", meta = (ClampMin = "0"))
+	int32 MeshResidencyBudgetMB = 1024;
+
+	//Keep hidden chunks' CPU mesh data compressed with meshoptimizer's codecs, expanded again on a worker when they show
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Planet Config|Residency")
+	bool EncodeHiddenMeshData = true;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Planet Config")
 	bool UseCameraPositionOverride = false;
 
@@ -107,15 +136,45 @@ public:
 
 	UFUNCTION(BlueprintCallable, Category = "Planet Config")
 	FVector GetCameraOverridePosition();
+
+	//CPU and GPU mesh bytes currently held by the planet's nodes
+	UFUNCTION(BlueprintCallable, Category = "Planet Config|Residency")
+	int64 GetResidentMeshBytes() const;
+
+	UFUNCTION(BlueprintCallable, Category = "Planet Config|Residency")
+	int32 GetEvictedNodeCount() const;
 	void ScheduleMeshUpdate(float IntervalInSeconds);
 	TFuture<URealtimeMeshComponent*> CreateRealtimeMeshComponentAsync();
 	//Root nodes for each face
-	TSharedPtr<QuadTreeNode> RootNodes[6];
+	QuadTreeNode* RootNodes[6] = {};
+	//Storage for every node of the planet. Shared so async work still holding a node reference keeps the memory valid
+	//across a re-initialization.
+	TSharedPtr<FQuadTreeNodePool, ESPMode::ThreadSafe> NodePool;
 
-	void UpdateMesh();
+	//Guards the Children arrays of one face. Held only while reading or swapping child arrays, never across a pass,
+	//so the LOD and mesh passes can run at the same time and different faces never contend.
+	FRWLock& GetFaceLock(uint8 InFaceId) const { return FaceLocks[InFaceId]; }
 
-	TSharedPtr<QuadTreeNode> GetNodeByIndex(const FQuadIndex& Index) const;
-	TSharedPtr<QuadTreeNode> GetLeafNodeByIndex(const FQuadIndex& Index) const;
+	void UpdateMesh();
+	//Called once the face's game thread submission has run, until then later mesh passes skip the face.
+	//A pass started before a re-initialization has nothing to release, InitializePlanet already reset the flags.
+	void EndFaceMeshPass(uint8 InFaceId, uint32 InGeneration) {
+		if (InGeneration == InitGeneration.load()) FaceMeshRunning[InFaceId] = false;
+	}
+
+	//Neighbor depths only change on split/merge, so those push the affected leaves here and the LOD pass drains it
+	TQueue<FNodeRef, EQueueMode::Mpsc> NeighborUpdateQueue;
+	void EnqueueNeighborUpdate(QuadTreeNode* InNode);
+	void UpdateNeighbors();
+
+	QuadTreeNode* GetNodeByIndex(const FQuadIndex& Index) const;
+	QuadTreeNode* GetLeafNodeByIndex(const FQuadIndex& Index) const;
+
+	//Residency accounting, nodes report their own deltas as they generate, evict and retire
+	std::atomic<int64> ResidentMeshBytes { 0 };
+	std::atomic<int32> EvictedNodeCount { 0 };
+	void AddResidentBytes(int64 InDelta) { ResidentMeshBytes += InDelta; }
+	void EnforceResidencyBudget();
     
 protected:
 	virtual void BeginPlay() override;
@@ -138,13 +197,16 @@ protected:
 	int32 TasksProcessing = 0;
 	FCriticalSection TaskCounterLock; // Lock to protect the counter
 
-	//Node Locks
-	FRWLock xPosLock;
-	FRWLock xNegLock;
-	FRWLock yPosLock;
-	FRWLock yNegLock;
-	FRWLock zPosLock;
-	FRWLock zNegLock;
+	//Per face synchronization
+	mutable FRWLock FaceLocks[6];
+	std::atomic<bool> FaceLodRunning[6] = {};
+	std::atomic<bool> FaceMeshRunning[6] = {};
+	std::atomic<bool> NeighborPassRunning { false }; //NeighborUpdateQueue is single consumer
+	std::atomic<uint32> InitGeneration { 0 }; //Bumped by InitializePlanet, passes only release face flags of their own generation
+
+	//LOD pass batching
+	static constexpr int32 LodBatchSize = 64;
+	int32 LastLodLeafCount = 0;
 
 	bool IsInitialized = false;
 };
\ No newline at end of file
@@ -78,4 +78,348 @@ const FCubeTransform FCubeTransform::FaceTransforms[6] = {
         },
         false //DO NOT FLIP WINDING
     }
-};
\ No newline at end of file
+};
+
+//Warps a single face coordinate in [-1, 1] before it is pushed out onto the sphere
+static double WarpFaceCoordinate(double u, ECubeSphereProjection InProjection) {
+    switch (InProjection) {
+    case ECubeSphereProjection::TANGENT:
+        return FMath::Tan(u * UE_DOUBLE_PI * .25);
+    case ECubeSphereProjection::EVERITT:
+        //Inverse of Everitt's quadratic sphere->cube warp with epsilon = 1.375
+        return FMath::Sign(u) * (1.375 - FMath::Sqrt(1.890625 - 1.5 * FMath::Abs(u))) / .75;
+    case ECubeSphereProjection::GNOMONIC:
+    default:
+        return u;
+    }
+}
+
+FVector FCubeTransform::ProjectToSphere(const FVector& InCubePoint, ECubeSphereProjection InProjection) {
+    if (InProjection == ECubeSphereProjection::GNOMONIC) {
+        return InCubePoint.GetSafeNormal();
+    }
+
+    //The dominant axis is the face normal, the other two are the in face coordinates
+    FVector absPoint = InCubePoint.GetAbs();
+    int normalAxis = absPoint.X >= absPoint.Y ? (absPoint.X >= absPoint.Z ? 0 : 2) : (absPoint.Y >= absPoint.Z ? 1 : 2);
+    double halfExtent = absPoint[normalAxis];
+    if (halfExtent <= 0.0) {
+        return FVector::ZeroVector;
+    }
+
+    FVector warpedPoint = InCubePoint / halfExtent;
+    for (int axis = 0; axis < 3; axis++) {
+        if (axis != normalAxis) {
+            warpedPoint[axis] = WarpFaceCoordinate(FMath::Clamp(warpedPoint[axis], -1.0, 1.0), InProjection);
+        }
+    }
+    return warpedPoint.GetSafeNormal();
+}
+
+//Builds the edge ring triangles (in vertex grid indices) for one combination of coarser neighbors
+static void BuildEdgeTriangles(int InFaceResolution, bool topLodChange, bool bottomLodChange, bool leftLodChange, bool rightLodChange, TArray<FIndex3UI>& OutTriangles) {
+    int ModifiedResolution = InFaceResolution + 2;
+    int tResolution = InFaceResolution;
+
+    FIndex3UI topOddTri;
+    FIndex3UI bottomOddTri;
+    FIndex3UI leftOddTri;
+    FIndex3UI rightOddTri;
+
+    //The internal cases here can probably be abstracted
+    for (int i = 1; i < tResolution; i++) {
+        {
+            //TOP EDGE TRIANGLES
+            int x = i;
+            int y = 1;
+
+            int topLeft = x * ModifiedResolution + y;
+            int bottomLeft = (x + 1) * ModifiedResolution + y;
+
+            //             TOP LEFT, TOP RIGHT,  BOTTOM LEFT, BOTTOM RIGHT
+            int quad[4] = { topLeft, topLeft + 1, bottomLeft, bottomLeft + 1 };
+
+            //Odd quads
+            if (x % 2 != 0) {
+                //Persist odd "top right" triangles to process in even iterations
+                topOddTri = FIndex3UI(quad[3], quad[0], quad[2]);
+                //Always generate this triangle unless it is on the corner
+                if (x != 1) {
+                    OutTriangles.Add(FIndex3UI(quad[0], quad[3], quad[1]));
+                }
+            }
+            //Even quads
+            else {
+                //If there is a lod change, we modify the previous iterations triangle instead of generating a new one
+                if (topLodChange) {
+                    topOddTri[2] = quad[2];
+                    OutTriangles.Add(topOddTri);
+                }
+                //If there is no lod change, add the last iterations triangle and the new triangle
+                else {
+                    OutTriangles.Add(topOddTri);
+                    OutTriangles.Add(FIndex3UI(quad[0], quad[2], quad[1]));
+                }
+                //Always generate this triangle unless it is on the corner
+                if (x != tResolution - 1) {
+                    OutTriangles.Add(FIndex3UI(quad[1], quad[2], quad[3]));
+                }
+            }
+        }
+
+        {
+            //BOTTOM EDGE TRIANGLES
+            int x = i;
+            int y = tResolution - 1;
+
+            int topLeft = x * ModifiedResolution + y;
+            int bottomLeft = (x + 1) * ModifiedResolution + y;
+
+            //             TOP LEFT, TOP RIGHT,  BOTTOM LEFT, BOTTOM RIGHT
+            int quad[4] = { bottomLeft, bottomLeft + 1, topLeft, topLeft + 1 };
+
+            //Odd quads
+            if (x % 2 != 0) {
+                //Persist odd "top right" triangles to process in even iterations
+                bottomOddTri = FIndex3UI(quad[3], quad[0], quad[1]);
+                //Always generate this triangle unless it is on the corner
+                if (x != 1) {
+                    OutTriangles.Add(FIndex3UI(quad[3], quad[2], quad[0]));
+                }
+            }
+            //Even quads
+            else {
+                //If there is a lod change, we modify the previous iterations triangle instead of generating a new one
+                if (bottomLodChange) {
+                    bottomOddTri[2] = quad[1];
+                    OutTriangles.Add(bottomOddTri);
+                }
+                //If there is no lod change, add the last iterations triangle and the new triangle
+                else {
+                    OutTriangles.Add(bottomOddTri);
+                    OutTriangles.Add(FIndex3UI(quad[1], quad[3], quad[2]));
+                }
+                //Always generate this triangle unless it is on the corner
+                if (x != tResolution - 1) {
+                    OutTriangles.Add(FIndex3UI(quad[0], quad[1], quad[2]));
+                }
+            }
+        }
+
+        {
+            //LEFT EDGE TRIANGLES
+            int y = i;
+            int x = 1;
+
+            int topLeft = x * ModifiedResolution + y;
+            int bottomLeft = (x + 1) * ModifiedResolution + y;
+
+            //             TOP LEFT, TOP RIGHT,  BOTTOM LEFT, BOTTOM RIGHT
+            int quad[4] = { topLeft, bottomLeft, topLeft + 1, bottomLeft + 1 };
+
+            //Odd quads
+            if (y % 2 != 0) {
+                //Persist odd "top right" triangles to process in even iterations
+                leftOddTri = FIndex3UI(quad[0], quad[3], quad[2]);
+                //Always generate this triangle unless it is on the corner
+                if (y != 1) {
+                    OutTriangles.Add(FIndex3UI(quad[3], quad[0], quad[1]));
+                }
+            }
+            //Even quads
+            else {
+                //If there is a lod change, we modify the previous iterations triangle instead of generating a new one
+                if (leftLodChange) {
+                    leftOddTri[2] = quad[2];
+                    OutTriangles.Add(leftOddTri);
+                }
+                //If there is no lod change, add the last iterations triangle and the new triangle
+                else {
+                    OutTriangles.Add(leftOddTri);
+                    OutTriangles.Add(FIndex3UI(quad[2], quad[0], quad[1]));
+                }
+                //Always generate this triangle unless it is on the corner
+                if (y != tResolution - 1) {
+                    OutTriangles.Add(FIndex3UI(quad[2], quad[1], quad[3]));
+                }
+            }
+        }
+
+        {
+            //RIGHT EDGE TRIANGLES
+            int y = i;
+            int x = tResolution - 1;
+
+            int topLeft = x * ModifiedResolution + y;
+            int bottomLeft = (x + 1) * ModifiedResolution + y;
+
+            //             TOP LEFT, TOP RIGHT,  BOTTOM LEFT, BOTTOM RIGHT
+            int quad[4] = { topLeft + 1 , bottomLeft + 1, topLeft, bottomLeft };
+
+            //Odd quads
+            if (y % 2 != 0) {
+                //Persist odd "top right" triangles to process in even iterations
+                rightOddTri = FIndex3UI(quad[0], quad[3], quad[1]);
+                //Always generate this triangle unless it is on the corner
+                if (y != 1) {
+                    OutTriangles.Add(FIndex3UI(quad[2], quad[3], quad[0]));
+                }
+            }
+            //Even quads
+            else {
+                //If there is a lod change, we modify the previous iterations triangle instead of generating a new one
+                if (rightLodChange) {
+                    rightOddTri[2] = quad[1];
+                    OutTriangles.Add(rightOddTri);
+                }
+                //If there is no lod change, add the last iterations triangle and the new triangle
+                else {
+                    OutTriangles.Add(rightOddTri);
+                    OutTriangles.Add(FIndex3UI(quad[3], quad[1], quad[2]));
+                }
+                //Always generate this triangle unless it is on the corner
+                if (y != tResolution - 1) {
+                    OutTriangles.Add(FIndex3UI(quad[1], quad[0], quad[2]));
+                }
+            }
+        }
+    }
+}
+
+const FEdgeStitchTopology& FEdgeStitchTopology::Get(int InFaceResolution, bool bInFlipWinding) {
+    static FCriticalSection CacheLock;
+    static TMap<int32, TUniquePtr<FEdgeStitchTopology>> Cache;
+
+    FScopeLock Lock(&CacheLock);
+    int32 key = InFaceResolution * 2 + (bInFlipWinding ? 1 : 0);
+    if (const TUniquePtr<FEdgeStitchTopology>* existing = Cache.Find(key)) {
+        return **existing;
+    }
+
+    TUniquePtr<FEdgeStitchTopology> topology = MakeUnique<FEdgeStitchTopology>();
+    TArray<FIndex3UI> gridTriangles;
+    for (uint8 variant = 0; variant < NumVariants; variant++) {
+        topology->VariantStart[variant] = gridTriangles.Num();
+        BuildEdgeTriangles(InFaceResolution,
+            (variant & (1 << (uint8)EdgeOrientation::UP)) != 0,
+            (variant & (1 << (uint8)EdgeOrientation::DOWN)) != 0,
+            (variant & (1 << (uint8)EdgeOrientation::LEFT)) != 0,
+            (variant & (1 << (uint8)EdgeOrientation::RIGHT)) != 0,
+            gridTriangles);
+        topology->VariantCount[variant] = gridTriangles.Num() - topology->VariantStart[variant];
+    }
+
+    //Compact the grid indices so each edge vertex is emitted once no matter how many variants reference it
+    TMap<int32, int32> gridToEdge;
+    topology->Triangles.Reserve(gridTriangles.Num());
+    for (FIndex3UI tri : gridTriangles) {
+        if (bInFlipWinding) {
+            tri = FIndex3UI(tri[0], tri[2], tri[1]);
+        }
+        for (int corner = 0; corner < 3; corner++) {
+            int32 gridIndex = tri[corner];
+            if (const int32* edgeIndex = gridToEdge.Find(gridIndex)) {
+                tri[corner] = *edgeIndex;
+            }
+            else {
+                tri[corner] = topology->GridVertices.Add(gridIndex);
+                gridToEdge.Add(gridIndex, tri[corner]);
+            }
+        }
+        topology->Triangles.Add(tri);
+    }
+
+    return *Cache.Add(key, MoveTemp(topology));
+}
+
+void FLodLeafBounds::SetNum(int32 InNum)
+{
+    Num = InNum;
+    int32 padded = Align(InNum, 4);
+    TArray<double>* columns[] = { &LandX, &LandY, &LandZ, &SeaX, &SeaY, &SeaZ, &Radius,
+        &ParentLandX, &ParentLandY, &ParentLandZ, &ParentSeaX, &ParentSeaY, &ParentSeaZ, &ParentRadius };
+    for (TArray<double>* column : columns) {
+        column->SetNumUninitialized(padded, false);
+    }
+    Flags.SetNumUninitialized(padded, false);
+    for (int32 i = InNum; i < padded; i++) {
+        SetLeaf(i, FVector::ZeroVector, FVector::ZeroVector, 0.0, FVector::ZeroVector, FVector::ZeroVector, 0.0, 0);
+    }
+}
+
+void FLodLeafBounds::SetLeaf(int32 InIndex, const FVector& InLand, const FVector& InSea, double InRadius, const FVector& InParentLand, const FVector& InParentSea, double InParentRadius, uint8 InFlags)
+{
+    LandX[InIndex] = InLand.X;
+    LandY[InIndex] = InLand.Y;
+    LandZ[InIndex] = InLand.Z;
+    SeaX[InIndex] = InSea.X;
+    SeaY[InIndex] = InSea.Y;
+    SeaZ[InIndex] = InSea.Z;
+    Radius[InIndex] = InRadius;
+    ParentLandX[InIndex] = InParentLand.X;
+    ParentLandY[InIndex] = InParentLand.Y;
+    ParentLandZ[InIndex] = InParentLand.Z;
+    ParentSeaX[InIndex] = InParentSea.X;
+    ParentSeaY[InIndex] = InParentSea.Y;
+    ParentSeaZ[InIndex] = InParentSea.Z;
+    ParentRadius[InIndex] = InParentRadius;
+    Flags[InIndex] = InFlags;
+}
+
+//Squared distance from the camera to the nearer of the land and sea centroids, four leaves at a time
+static FORCEINLINE VectorRegister4Double NearestCentroidDistSq(const FLodViewSnapshot& InView,
+    const double* InLandX, const double* InLandY, const double* InLandZ,
+    const double* InSeaX, const double* InSeaY, const double* InSeaZ)
+{
+    const VectorRegister4Double camX = MakeVectorRegisterDouble(InView.CameraLocal.X, InView.CameraLocal.X, InView.CameraLocal.X, InView.CameraLocal.X);
+    const VectorRegister4Double camY = MakeVectorRegisterDouble(InView.CameraLocal.Y, InView.CameraLocal.Y, InView.CameraLocal.Y, InView.CameraLocal.Y);
+    const VectorRegister4Double camZ = MakeVectorRegisterDouble(InView.CameraLocal.Z, InView.CameraLocal.Z, InView.CameraLocal.Z, InView.CameraLocal.Z);
+
+    VectorRegister4Double dx = VectorSubtract(VectorLoad(InLandX), camX);
+    VectorRegister4Double dy = VectorSubtract(VectorLoad(InLandY), camY);
+    VectorRegister4Double dz = VectorSubtract(VectorLoad(InLandZ), camZ);
+    VectorRegister4Double landDistSq = VectorMultiplyAdd(dx, dx, VectorMultiplyAdd(dy, dy, VectorMultiply(dz, dz)));
+
+    dx = VectorSubtract(VectorLoad(InSeaX), camX);
+    dy = VectorSubtract(VectorLoad(InSeaY), camY);
+    dz = VectorSubtract(VectorLoad(InSeaZ), camZ);
+    VectorRegister4Double seaDistSq = VectorMultiplyAdd(dx, dx, VectorMultiplyAdd(dy, dy, VectorMultiply(dz, dz)));
+
+    return VectorMin(landDistSq, seaDistSq);
+}
+
+void FLodLeafBounds::Evaluate(const FLodViewSnapshot& InView, TArray<FLodCommand>& OutCommands) const
+{
+    //Split when k * r > fov * d and merge when k * h * R < fov * D. Both sides are positive so the comparisons are
+    //done squared and no square roots are needed.
+    const double fovSq = InView.FovFactor * InView.FovFactor;
+    const double splitSq = InView.SplitThreshold * InView.SplitThreshold;
+    const double mergeSq = InView.MergeThreshold * InView.MergeThreshold;
+    const VectorRegister4Double fovSq4 = MakeVectorRegisterDouble(fovSq, fovSq, fovSq, fovSq);
+    const VectorRegister4Double splitSq4 = MakeVectorRegisterDouble(splitSq, splitSq, splitSq, splitSq);
+    const VectorRegister4Double mergeSq4 = MakeVectorRegisterDouble(mergeSq, mergeSq, mergeSq, mergeSq);
+
+    for (int32 i = 0; i < Num; i += 4) {
+        VectorRegister4Double distSq = NearestCentroidDistSq(InView, LandX.GetData() + i, LandY.GetData() + i, LandZ.GetData() + i, SeaX.GetData() + i, SeaY.GetData() + i, SeaZ.GetData() + i);
+        VectorRegister4Double radius = VectorLoad(Radius.GetData() + i);
+        int32 splitMask = VectorMaskBits(VectorCompareGT(VectorMultiply(splitSq4, VectorMultiply(radius, radius)), VectorMultiply(fovSq4, distSq)));
+
+        VectorRegister4Double parentDistSq = NearestCentroidDistSq(InView, ParentLandX.GetData() + i, ParentLandY.GetData() + i, ParentLandZ.GetData() + i, ParentSeaX.GetData() + i, ParentSeaY.GetData() + i, ParentSeaZ.GetData() + i);
+        VectorRegister4Double parentRadius = VectorLoad(ParentRadius.GetData() + i);
+        int32 mergeMask = VectorMaskBits(VectorCompareGT(VectorMultiply(fovSq4, parentDistSq), VectorMultiply(mergeSq4, VectorMultiply(parentRadius, parentRadius))));
+
+        int32 laneCount = FMath::Min(4, Num - i);
+        for (int32 lane = 0; lane < laneCount; lane++) {
+            uint8 flags = Flags[i + lane];
+            if ((flags & AllowSplit) && ((flags & ForceSplit) || (splitMask & (1 << lane)))) {
+                OutCommands.Add({ i + lane, ELodCommand::Split });
+            }
+            else if ((flags & AllowMerge) && (mergeMask & (1 << lane))) {
+                OutCommands.Add({ i + lane, ELodCommand::Merge });
+            }
+            else if (flags & MergePending) {
+                OutCommands.Add({ i + lane, ELodCommand::ClearMerge });
+            }
+        }
+    }
+}
\ No newline at end of file
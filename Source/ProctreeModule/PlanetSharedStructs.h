@@ -3,6 +3,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
 #include <Mesh/RealtimeMeshSimpleData.h>
+#include <Mesh/RealtimeMeshStreamPool.h>
 #include "PlanetSharedStructs.generated.h"
 
 class QuadTreeNode;
@@ -281,19 +282,27 @@ public:
 	FDoubleBounds mountainPeakMultiplierBounds = { 1, 1 };
 };
 
+//Builders over a stream set, held by value so they go away with the stack frame building the mesh.
+//The streams come out of the shared stream pool already reserved, a rebuild reuses allocations released earlier.
 struct PROCTREEMODULE_API FMeshStreamBuilders {
-
-	//URealtimeMeshStreamSet* StreamSet;
-
-	TRealtimeMeshStreamBuilder<FVector, FVector3f>* PositionBuilder;
-	TRealtimeMeshStreamBuilder<FRealtimeMeshTangentsHighPrecision, FRealtimeMeshTangentsNormalPrecision>* TangentBuilder;
-	TRealtimeMeshStreamBuilder<FVector2f, FVector2DHalf>* TexCoordsBuilder;
-	TRealtimeMeshStreamBuilder<FColor>* ColorBuilder;
-	TRealtimeMeshStreamBuilder<TIndex3<uint32>>* TrianglesBuilder;
-	TRealtimeMeshStreamBuilder<uint32, uint16>* PolygroupsBuilder;
+	FMeshStreamBuilders(FRealtimeMeshStreamSet& StreamSet, int32 InNumVerts, int32 InNumTriangles)
+		: NumVerts(InNumVerts)
+		, NumTriangles(InNumTriangles)
+		, PositionBuilder(RealtimeMesh::FRealtimeMeshStreamPool::Get().AddStream(StreamSet, FRealtimeMeshStreams::Position, GetRealtimeMeshBufferLayout<FVector3f>(), InNumVerts))
+		, TangentBuilder(RealtimeMesh::FRealtimeMeshStreamPool::Get().AddStream(StreamSet, FRealtimeMeshStreams::Tangents, GetRealtimeMeshBufferLayout<FRealtimeMeshTangentsNormalPrecision>(), InNumVerts))
+		, TexCoordsBuilder(RealtimeMesh::FRealtimeMeshStreamPool::Get().AddStream(StreamSet, FRealtimeMeshStreams::TexCoords, GetRealtimeMeshBufferLayout<FVector2DHalf>(), InNumVerts))
+		, ColorBuilder(RealtimeMesh::FRealtimeMeshStreamPool::Get().AddStream(StreamSet, FRealtimeMeshStreams::Color, GetRealtimeMeshBufferLayout<FColor>(), InNumVerts))
+		, TrianglesBuilder(RealtimeMesh::FRealtimeMeshStreamPool::Get().AddStream(StreamSet, FRealtimeMeshStreams::Triangles, GetRealtimeMeshBufferLayout<TIndex3<uint32>>(), InNumTriangles)) {
+	}
 
 	int32 NumVerts;
 	int32 NumTriangles;
+
+	TRealtimeMeshStreamBuilder<FVector, FVector3f> PositionBuilder;
+	TRealtimeMeshStreamBuilder<FRealtimeMeshTangentsHighPrecision, FRealtimeMeshTangentsNormalPrecision> TangentBuilder;
+	TRealtimeMeshStreamBuilder<FVector2f, FVector2DHalf> TexCoordsBuilder;
+	TRealtimeMeshStreamBuilder<FColor> ColorBuilder;
+	TRealtimeMeshStreamBuilder<TIndex3<uint32>> TrianglesBuilder;
 };
 
 UENUM(BlueprintType)
@@ -314,6 +323,14 @@ enum class EFaceDirection : uint8 {
 	Z_NEG = 5 UMETA(DisplayName = "Z-")
 };
 
+//Controls how points on the unit cube are warped before being pushed out onto the sphere
+UENUM(BlueprintType)
+enum class ECubeSphereProjection : uint8 {
+	GNOMONIC = 0 UMETA(DisplayName = "Gnomonic"), //Plain normalize, samples bunch up ~5x near cube corners
+	TANGENT = 1 UMETA(DisplayName = "Tangent Adjusted"), //tan(u * pi/4) warp, close to uniform
+	EVERITT = 2 UMETA(DisplayName = "Everitt") //Quadratic approximation of an equal area mapping, cheaper than tangent
+};
+
 enum PROCTREEMODULE_API EChildPosition {
 	BOTTOM_LEFT = 0, //0b00,
 	TOP_LEFT = 1, //0b01,
@@ -336,6 +353,95 @@ struct PROCTREEMODULE_API FCubeTransform {
 	bool bFlipWinding;
 
 	static const FCubeTransform FaceTransforms[6];
+
+	//Maps a point on the surface of the cube (any half extent) to a unit direction on the sphere.
+	//Every caller must go through this so shared edge points land in the same place on both sides of a seam.
+	static FVector ProjectToSphere(const FVector& InCubePoint, ECubeSphereProjection InProjection);
+};
+
+//Edge ring topology for every combination of coarser neighbors. It only depends on the face resolution and winding,
+//so it is built once and shared by every node; a neighbor LOD change just selects a different variant range.
+struct PROCTREEMODULE_API FEdgeStitchTopology {
+	static constexpr int32 NumVariants = 16;
+
+	TArray<int32> GridVertices; //Indices into the node's (FaceResolution + 2)^2 vertex grid, in edge stream order
+	TArray<FIndex3UI> Triangles; //All variants back to back, indexing into GridVertices
+	int32 VariantStart[NumVariants];
+	int32 VariantCount[NumVariants];
+
+	//Bit (uint8)EdgeOrientation is set when the neighbor on that edge is coarser than the node
+	static uint8 MakeVariant(bool bLeftLodChange, bool bRightLodChange, bool bUpLodChange, bool bDownLodChange) {
+		return (bLeftLodChange ? 1 << (uint8)EdgeOrientation::LEFT : 0)
+			| (bRightLodChange ? 1 << (uint8)EdgeOrientation::RIGHT : 0)
+			| (bUpLodChange ? 1 << (uint8)EdgeOrientation::UP : 0)
+			| (bDownLodChange ? 1 << (uint8)EdgeOrientation::DOWN : 0);
+	}
+
+	FRealtimeMeshStreamRange GetVariantRange(uint8 InVariant) const {
+		return FRealtimeMeshStreamRange(0, GridVertices.Num(), VariantStart[InVariant] * 3, (VariantStart[InVariant] + VariantCount[InVariant]) * 3);
+	}
+
+	static const FEdgeStitchTopology& Get(int InFaceResolution, bool bInFlipWinding);
+};
+
+//Sentinel for an empty child or retained block link
+constexpr uint32 InvalidNodeBlock = MAX_uint32;
+
+//Weak reference to a pooled QuadTreeNode. Index is the node's pool slot, Generation has to match the slot's current
+//generation or the node has been freed since the handle was taken.
+struct PROCTREEMODULE_API FNodeHandle {
+	uint32 Index = MAX_uint32;
+	uint32 Generation = 0;
+
+	bool IsSet() const { return Index != MAX_uint32; }
+	bool operator==(const FNodeHandle& Other) const { return Index == Other.Index && Generation == Other.Generation; }
+	friend uint32 GetTypeHash(const FNodeHandle& InHandle) { return HashCombine(InHandle.Index, InHandle.Generation); }
+};
+
+//Camera and actor state captured once per LOD pass. Everything is in planet local space, the actor scale is uniform
+//so it cancels out of the projected size comparisons.
+struct PROCTREEMODULE_API FLodViewSnapshot {
+	FVector CameraLocal = FVector::ZeroVector;
+	double FovFactor = 0.0; //2 * tan(fov / 2), projected size per unit of distance
+	double SplitThreshold = 0.0;
+	double MergeThreshold = 0.0; //Split threshold widened by the merge hysteresis
+	double Now = 0.0;
+};
+
+enum class ELodCommand : uint8 {
+	Split,
+	Merge,
+	ClearMerge //Leaf voted to merge last pass but no longer does
+};
+
+struct PROCTREEMODULE_API FLodCommand {
+	int32 LeafIndex;
+	ELodCommand Command;
+};
+
+//Per pass leaf bounds laid out as structure of arrays so the split/merge metrics run four leaves per SIMD op
+struct PROCTREEMODULE_API FLodLeafBounds {
+	enum EFlags : uint8 {
+		AllowSplit = 1 << 0, //Below MaxDepth
+		ForceSplit = 1 << 1, //Shallower than MinDepth, must split
+		AllowMerge = 1 << 2, //Parent has a mesh and is at or below MinDepth
+		MergePending = 1 << 3 //Leaf currently votes to merge
+	};
+
+	int32 Num = 0;
+	TArray<double> LandX, LandY, LandZ;
+	TArray<double> SeaX, SeaY, SeaZ;
+	TArray<double> Radius;
+	TArray<double> ParentLandX, ParentLandY, ParentLandZ;
+	TArray<double> ParentSeaX, ParentSeaY, ParentSeaZ;
+	TArray<double> ParentRadius;
+	TArray<uint8> Flags;
+
+	//Sizes every array, padded to a multiple of four so the tail needs no scalar loop
+	void SetNum(int32 InNum);
+	void SetLeaf(int32 InIndex, const FVector& InLand, const FVector& InSea, double InRadius, const FVector& InParentLand, const FVector& InParentSea, double InParentRadius, uint8 InFlags);
+	//Appends a command for every leaf that needs to act this pass, leaves with nothing to do are left out
+	void Evaluate(const FLodViewSnapshot& InView, TArray<FLodCommand>& OutCommands) const;
 };
 
 struct PROCTREEMODULE_API FQuadIndex {
@@ -3,12 +3,26 @@
 #include "Async/Async.h"
 #include "CoreMinimal.h"
 #include "PlanetActor.h"
+#include "QuadTreeNodePool.h"
 #include "FastNoise/FastNoise.h"
 #include "HAL/Runnable.h"
 #include <Mesh/RealtimeMeshSimpleData.h>
 #include "ProceduralMeshComponent.h"
 #include "Mesh/RealtimeMeshDistanceField.h"
 #include <Mesh/RealtimeMeshAlgo.h>
+#include "RenderProxy/RealtimeMeshProxyCommandBatch.h"
+#include "RealtimeMeshThreadingSubsystem.h"
+
+//Encode/decode work goes through the mesh threading subsystem's priority queue. Without one (no engine subsystem yet,
+//commandlets, shutdown) it runs on the large thread pool like a restore does.
+static void LaunchNodeTask(ERealtimeMeshTaskPriority InPriority, TUniqueFunction<void()>&& InWork) {
+	if (URealtimeMeshThreadingSubsystem* threadingSubsystem = URealtimeMeshThreadingSubsystem::Get()) {
+		threadingSubsystem->LaunchTask(InPriority, MoveTemp(InWork));
+	}
+	else {
+		Async(EAsyncExecution::LargeThreadPool, MoveTemp(InWork));
+	}
+}
 
 //This structure is for internal use only, anytime it's data is needed it should be wrapped in a FMeshUpdateData struct
 QuadTreeNode::QuadTreeNode(APlanetActor* InParentActor, TSharedPtr<INoiseGenerator> InNoiseGen, FCubeTransform InFaceTransform, FQuadIndex InIndex, FVector InCenter, float InSize, float InRadius, int InMinDepth, int InMaxDepth) : Index(InIndex)
@@ -31,88 +45,98 @@ QuadTreeNode::QuadTreeNode(APlanetActor* InParentActor, TSharedPtr<INoiseGenerat
 	int myDepth = Index.GetDepth();
 	
 	FaceResolution = ParentActor->FaceResolution;
+	Projection = ParentActor->Projection;
 
 	NeighborLods[0] = myDepth;
 	NeighborLods[1] = myDepth;
 	NeighborLods[2] = myDepth;
 	NeighborLods[3] = myDepth;
+
+	LastLodChangeTime = FPlatformTime::Seconds();
 }
 
 //Externally Called Actions and their counterpart functions
-void QuadTreeNode::UpdateLod()
-{
-	TArray<TSharedPtr<QuadTreeNode>> leaves;
-	CollectLeaves(AsShared(), leaves);
-	ParallelFor(leaves.Num(), [&](int32 i) {
-		leaves[i]->TrySetLod();
-	});
+void QuadTreeNode::WriteLodBounds(FLodLeafBounds& OutBounds, int32 InIndex) const {
+	if (!IsInitialized || !HasGenerated) {
+		OutBounds.SetLeaf(InIndex, FVector::ZeroVector, FVector::ZeroVector, 0.0, FVector::ZeroVector, FVector::ZeroVector, 0.0, 0);
+		return;
+	}
+	int myDepth = GetDepth();
+	uint8 flags = 0;
+	if (myDepth < MaxDepth) flags |= FLodLeafBounds::AllowSplit;
+	if (myDepth < MinDepth) flags |= FLodLeafBounds::ForceSplit;
+	if (CanMerge) flags |= FLodLeafBounds::MergePending;
+
+	//Centroids are stored relative to the unperturbed center on the sphere, the metric picks the nearer of land and sea
+	FVector land = CenterOnSphere + LandCentroid;
+	FVector sea = RenderSea ? CenterOnSphere + SeaCentroid : land;
+
+	QuadTreeNode* tParent = GetParent();
+	if (tParent && tParent->HasGenerated && tParent->GetDepth() >= MinDepth) {
+		flags |= FLodLeafBounds::AllowMerge;
+		FVector parentLand = tParent->CenterOnSphere + tParent->LandCentroid;
+		FVector parentSea = tParent->RenderSea ? tParent->CenterOnSphere + tParent->SeaCentroid : parentLand;
+		OutBounds.SetLeaf(InIndex, land, sea, MaxNodeRadius, parentLand, parentSea, tParent->MaxNodeRadius, flags);
+	}
+	else {
+		OutBounds.SetLeaf(InIndex, land, sea, MaxNodeRadius, land, sea, MaxNodeRadius, flags);
+	}
 }
-void QuadTreeNode::TrySetLod() {
-	if (IsInitialized && IsLeaf()) {
-		double k = 8;
-		double fov = ParentActor->GetCameraFOV();
-		FVector lastCamPos = ParentActor->GetLastCameraPosition();
-		auto lastCamRot = ParentActor->GetLastCameraRotation();
-
-		//Since we are doing origin rebasing frequently, the actors location can "change" arbitrarily and needs to be accounted for
-		FVector planetCenter = ParentActor->GetActorLocation();
-
-		// Calculate the world-space position of the *unperturbed* chunk center on the sphere
-		FVector unperturbedPoint = Center.GetSafeNormal() * SphereRadius;
-
-		//Transform world space to local space by subtracting the world offset
-		FVector NodeCentroid = LandCentroid + unperturbedPoint;
-		if (RenderSea && FVector::Dist(SeaCentroid + unperturbedPoint, lastCamPos) < FVector::Dist(LandCentroid + unperturbedPoint, lastCamPos)) NodeCentroid = SeaCentroid + unperturbedPoint;
-		FVector adjustedCentroid = NodeCentroid * ParentActor->GetActorScale().X + planetCenter;
-
-		auto ParentCentroid = adjustedCentroid;
-		auto ParentSize = MaxNodeRadius * ParentActor->GetActorScale().X;
-
-		double planetRadius = FVector::Distance(ParentActor->GetActorLocation(), adjustedCentroid);
-
-		if (Parent.IsValid()) {
-			TSharedPtr<QuadTreeNode> tParent = Parent.Pin();
-			//Calculate the world-space position of the *unperturbed* parent center on the sphere
-			FVector pUnperturbedPoint = tParent->Center.GetSafeNormal() * SphereRadius;
-
-			ParentCentroid = tParent->LandCentroid + pUnperturbedPoint;
-			if (tParent->RenderSea && FVector::Dist(tParent->SeaCentroid + pUnperturbedPoint, lastCamPos) < FVector::Dist(tParent->LandCentroid + pUnperturbedPoint, lastCamPos)) ParentCentroid = tParent->SeaCentroid + pUnperturbedPoint;
-			ParentCentroid = ParentCentroid * ParentActor->GetActorScale().X + planetCenter;
-			ParentSize = tParent->MaxNodeRadius * ParentActor->GetActorScale().X;
-		}
-
-		double d1 = FVector::Distance(lastCamPos, adjustedCentroid);
-		double d2 = FVector::Distance(lastCamPos, ParentCentroid);
-		if (ShouldSplit(d1, fov, k)) {
-			CanMerge = false;
-			if (LastRenderedState) {
-				QuadTreeNode::Split(AsShared());
-			}
-		}
-		else if (ShouldMerge(d2, ParentSize, fov, k)) {
-			CanMerge = true;
-			if (Index.GetQuadrant() == 3)
-				Parent.Pin()->TryMerge();
+void QuadTreeNode::ReleaseExpiredChildren(double InNow) {
+	//Children kept around after a merge are dropped once the camera has had its chance to come back
+	bool hasExpired;
+	{
+		FReadScopeLock FaceLock(ParentActor->GetFaceLock(Index.FaceId));
+		hasExpired = RetainedBlock != InvalidNodeBlock && InNow - LastLodChangeTime.load() > ParentActor->MergedChildRetentionTime;
+	}
+	if (hasExpired) {
+		ReleaseRetainedChildren(this);
+	}
+}
+void QuadTreeNode::ApplyLodCommand(ELodCommand InCommand, double InNow) {
+	//A node has to stay a leaf for a while before it may split again or be merged away, this keeps a camera
+	//hovering on a threshold from restructuring the same node every pass
+	bool hasMinLifetime = InNow - LastLodChangeTime.load() >= ParentActor->MinNodeLifetime;
+	switch (InCommand) {
+	case ELodCommand::Split:
+		CanMerge = false;
+		if (GetState() == ENodeState::Visible && hasMinLifetime) {
+			QuadTreeNode::Split(this);
 		}
-		else {
-			CanMerge = false;
+		break;
+	case ELodCommand::Merge:
+		CanMerge = hasMinLifetime;
+		if (Index.GetQuadrant() == 3) {
+			QuadTreeNode* tParent = GetParent();
+			if (tParent) tParent->TryMerge();
 		}
+		break;
+	case ELodCommand::ClearMerge:
+		CanMerge = false;
+		break;
 	}
 }
-void QuadTreeNode::UpdateNeighbors() {
-	TArray<TSharedPtr<QuadTreeNode>> leaves;
-	CollectLeaves(AsShared(), leaves);
-	TArray<TSharedPtr<QuadTreeNode>> updateLeaves;
-	ParallelFor(leaves.Num(), [&](int32 i) {
-		if (leaves[i]->CheckNeighbors()) leaves[i]->UpdateEdgeMeshBuffer();
-	});
+void QuadTreeNode::NotifyNeighbors() {
+	//Called after this node's subtree changed shape. Only same depth neighbors can be looking at this node, coarser
+	//neighbors resolve their lookup to one of our ancestors and never see the change.
+	int myDepth = GetDepth();
+	for (uint8 edge = 0; edge < 4; edge++) {
+		QuadTreeNode* neighbor = ParentActor->GetNodeByIndex(Index.GetNeighborIndex((EdgeOrientation)edge));
+		if (!neighbor || neighbor->GetDepth() != myDepth) continue;
+
+		TArray<QuadTreeNode*> neighborLeaves;
+		CollectLeaves(neighbor, neighborLeaves);
+		for (QuadTreeNode* leaf : neighborLeaves) {
+			ParentActor->EnqueueNeighborUpdate(leaf);
+		}
+	}
 }
 bool QuadTreeNode::CheckNeighbors() {
 	//TODO: Edge processing of neighbor can be broken out into it's own function and it would reduce complexity in this function quite a bit
 	if (!HasGenerated) return false; //Cant do neighbor updates until after base mesh data is generated
 	int myIndex = Index.GetQuadrant();
-	TSharedPtr<QuadTreeNode> n1;
-	TSharedPtr<QuadTreeNode> n2;
+	QuadTreeNode* n1 = nullptr;
+	QuadTreeNode* n2 = nullptr;
 	bool neighborStateChange = false;
 	switch (myIndex) {
 	case (uint8)EChildPosition::BOTTOM_LEFT:
@@ -191,202 +215,568 @@ bool QuadTreeNode::CheckNeighbors() {
 	}
 	return neighborStateChange;
 }
-void QuadTreeNode::UpdateAllMesh() {
-	TArray<TSharedPtr<QuadTreeNode>> leaves;
-	CollectLeaves(AsShared(), leaves);	
-	ParallelFor(leaves.Num(), [&](int32 i) {
-		leaves[i]->UpdateMesh();
+void QuadTreeNode::UpdateAllMesh(uint32 InGeneration) {
+	//Root only, the face's mesh pass ends when the submission below has run
+	TArray<QuadTreeNode*> leaves;
+	CollectLeaves(this, leaves);
+	if (leaves.Num() == 0) {
+		ParentActor->EndFaceMeshPass(Index.FaceId, InGeneration);
+		return;
+	}
+	TArray<FNodeRef> leafRefs;
+	leafRefs.Reserve(leaves.Num());
+	for (QuadTreeNode* leaf : leaves) {
+		leafRefs.Add(leaf->GetRef());
+	}
+	//One game thread task and one render command for the whole face instead of one per leaf
+	AsyncTask(ENamedThreads::GameThread, [planet = TWeakObjectPtr<APlanetActor>(ParentActor), faceId = Index.FaceId, InGeneration, leafRefs = MoveTemp(leafRefs)]() {
+		{
+			RealtimeMesh::FRealtimeMeshUpdateBatch updateBatch;
+			for (const FNodeRef& leafRef : leafRefs) {
+				if (FPinnedNode node = leafRef.Pin()) {
+					node->SubmitMeshUpdates();
+				}
+			}
+		}
+		//Released even if the leaves are gone, a stale generation is ignored after a re-initialization
+		if (planet.IsValid()) {
+			planet->EndFaceMeshPass(faceId, InGeneration);
+		}
 	});
 }
 void QuadTreeNode::UpdateMesh() {
-	AsyncTask(ENamedThreads::GameThread, [this]() {
-		FReadScopeLock ReadLock(MeshDataLock);
-		if (!IsInitialized || !HasGenerated) return;
-		if (isEdgeDirty) {
-			isEdgeDirty = false;
-			if (RenderSea) {
-				auto SeaUpdateStream = FRealtimeMeshStreamSet(SeaMeshStreamEdge);
-				RtMesh->UpdateSectionGroup(SeaGroupKeyEdge, SeaUpdateStream);
-			}
-			auto UpdateStream = FRealtimeMeshStreamSet(LandMeshStreamEdge);
-			RtMesh->UpdateSectionGroup(LandGroupKeyEdge, UpdateStream);
-			RtMesh->UpdateSectionConfig(LandSectionKeyEdge, RtMesh->GetSectionConfig(LandSectionKeyEdge), GetDepth() >= MaxDepth - 3);
-		}
-		if (isPatchDirty) {
-			isPatchDirty = false;
-			if (RenderSea) {
-				auto SeaUpdateStream = FRealtimeMeshStreamSet(SeaMeshStreamInner);
-				RtMesh->UpdateSectionGroup(SeaGroupKeyInner, SeaUpdateStream);
-			}
-			auto UpdateStream = FRealtimeMeshStreamSet(LandMeshStreamInner);
-			RtMesh->UpdateSectionGroup(LandGroupKeyInner, UpdateStream).Then([this](TFuture<ERealtimeMeshProxyUpdateStatus> completedFuture) {
-				AsyncTask(ENamedThreads::GameThread, [this]() {
-					LastRenderedState = true;
-					if (Parent.IsValid()) { 
-						auto tParent = Parent.Pin();
-						if (tParent->Children[0]->LastRenderedState && tParent->Children[1]->LastRenderedState && tParent->Children[2]->LastRenderedState && tParent->Children[3]->LastRenderedState) {
-							while (tParent) {
-								tParent->SetChunkVisibility(false);
-								tParent = tParent->Parent.Pin();
+	AsyncTask(ENamedThreads::GameThread, [nodeRef = GetRef()]() {
+		if (FPinnedNode node = nodeRef.Pin()) {
+			node->SubmitMeshUpdates();
+		}
+	});
+}
+void QuadTreeNode::SubmitMeshUpdates() {
+	//Write lock, the freshly built stream sets are moved into the section groups rather than copied
+	//A rebuild that keeps every stream size (regeneration of a resident chunk) is written into the existing GPU buffers
+	FWriteScopeLock WriteLock(MeshDataLock);
+	ENodeState state = GetState();
+	if (!IsInitialized || state == ENodeState::Allocated || state == ENodeState::Generating || state == ENodeState::Evicted || state == ENodeState::Retiring) return;
+	//Everything below goes to the render thread as one command, the returned futures all complete with it
+	RealtimeMesh::FRealtimeMeshUpdateBatch updateBatch;
+	if (isMeshDirty.exchange(false)) {
+		//Only the first upload brings the node on screen, a later one keeps whatever visibility it has
+		bool firstUpload = TryTransition(ENodeState::Ready, ENodeState::Uploading);
+		isEdgeRangeDirty = true;
+		if (RenderSea) {
+			RtMesh->UpdateSectionGroupInPlace(SeaGroupKey, MoveTemp(SeaMeshStream));
+		}
+		RtMesh->UpdateSectionGroupInPlace(LandGroupKey, MoveTemp(LandMeshStream)).Then([nodeRef = GetRef(), firstUpload](TFuture<ERealtimeMeshProxyUpdateStatus> completedFuture) {
+			if (!firstUpload) return;
+			AsyncTask(ENamedThreads::GameThread, [nodeRef]() {
+				FPinnedNode node = nodeRef.Pin();
+				if (!node) return;
+				//A restored ancestor stays hidden behind its children, only a leaf comes on screen
+				if (!node->IsLeaf()) {
+					if (node->TryTransition(ENodeState::Uploading, ENodeState::Hidden) && node->ParentActor->EncodeHiddenMeshData) {
+						LaunchNodeTask(ERealtimeMeshTaskPriority::Background, [nodeRef]() {
+							if (FPinnedNode hiddenNode = nodeRef.Pin()) {
+								hiddenNode->EncodeMeshData();
 							}
+						});
+					}
+					return;
+				}
+				if (!node->TryTransition(ENodeState::Uploading, ENodeState::Visible)) return;
+				QuadTreeNode* tParent = node->GetParent();
+				if (tParent) {
+					bool allSiblingsVisible = true;
+					{
+						FReadScopeLock FaceLock(node->ParentActor->GetFaceLock(node->Index.FaceId));
+						allSiblingsVisible = !tParent->IsLeaf();
+						for (int i = 0; allSiblingsVisible && i < 4; i++) {
+							allSiblingsVisible &= tParent->GetChild(i)->GetState() == ENodeState::Visible;
 						}
 					}
-				});
+					if (allSiblingsVisible) {
+						while (tParent) {
+							tParent->SetChunkVisibility(false);
+							tParent = tParent->GetParent();
+						}
+					}
+				}
 			});
-			RtMesh->UpdateSectionConfig(LandSectionKeyInner, RtMesh->GetSectionConfig(LandSectionKeyInner), GetDepth() >= MaxDepth - 3);
+		});
+		SeaMeshStream.Empty();
+		LandMeshStream.Empty();
+		FRealtimeMeshStreamRange patchRange = GetPatchStreamRange();
+		if (RenderSea) {
+			RtMesh->UpdateSectionRange(SeaSectionKeyInner, patchRange);
 		}
-	});
+		RtMesh->UpdateSectionRange(LandSectionKeyInner, patchRange);
+		bool createCollision = GetDepth() >= MaxDepth - 3;
+		RtMesh->UpdateSectionConfig(LandSectionKeyInner, RtMesh->GetSectionConfig(LandSectionKeyInner), createCollision);
+		RtMesh->UpdateSectionConfig(LandSectionKeyEdge, RtMesh->GetSectionConfig(LandSectionKeyEdge), createCollision);
+		if (firstUpload && !IsLeaf()) {
+			SetChunkVisibility(false);
+		}
+		//The streams just moved into the section groups, that is the only change here that moves the residency count.
+		//A clean node skips the walk over its arrays and streams entirely.
+		AccountResidentBytes();
+	}
+	if (isEdgeRangeDirty.exchange(false)) {
+		//The edge ring holds every stitching variant, only draw the one matching the current neighbor depths
+		FRealtimeMeshStreamRange edgeRange = GetEdgeStreamRange();
+		if (RenderSea) {
+			RtMesh->UpdateSectionRange(SeaSectionKeyEdge, edgeRange);
+		}
+		RtMesh->UpdateSectionRange(LandSectionKeyEdge, edgeRange);
+	}
 }
 
 //LOD and restructuring operations
-//Helper function used in ShouldSplit/ShouldMerge
-float s(float z, float hFov) {
-	return 2.0f * z * FMath::Tan(FMath::DegreesToRadians(hFov) / 2.0f);
-}
-bool QuadTreeNode::ShouldMerge(double d2, double parentSize, double fov, double k) {
-	return (Parent.IsValid() && Parent.Pin()->GetDepth() >= MinDepth) && k * 1.05 * parentSize < s(d2, fov);
-}
-bool QuadTreeNode::ShouldSplit(double d1, double fov, double k) {
-	int d = GetDepth();
-	if (d >= MaxDepth) return false;
-	return d < MinDepth || (k * MaxNodeRadius * ParentActor->GetActorScale().X > s(d1, fov));
+void QuadTreeNode::Split(QuadTreeNode* inNode)
+{
+	if (!inNode || !inNode->IsAlive() || !inNode->IsLeaf() || !inNode->TryBeginRestructure()) return;
+	if (inNode->RetainedBlock != InvalidNodeBlock) {
+		//Recently merged, the old children still have their components and mesh data so just show them again
+		Async(EAsyncExecution::TaskGraphMainThread, [nodeRef = inNode->GetRef()]() {
+			FPinnedNode node = nodeRef.Pin();
+			if (!node) return;
+			RealtimeMesh::FRealtimeMeshUpdateBatch updateBatch;
+			double now = FPlatformTime::Seconds();
+			{
+				FWriteScopeLock FaceLock(node->ParentActor->GetFaceLock(node->Index.FaceId));
+				node->ChildBlock = node->RetainedBlock;
+				node->RetainedBlock = InvalidNodeBlock;
+			}
+			for (int i = 0; i < 4; i++) {
+				QuadTreeNode* child = node->GetChild(i);
+				child->LastLodChangeTime = now;
+				child->SetChunkVisibility(true);
+				node->ParentActor->EnqueueNeighborUpdate(child);
+			}
+			node->SetChunkVisibility(false);
+			node->NotifyNeighbors();
+			node->EndRestructure();
+		});
+		return;
+	}
+	//The children check their own neighbors once generated, GenerateMeshData queues them for the neighbor pass
+	inNode->CreateChildren();
+	inNode->NotifyNeighbors();
+	Async(EAsyncExecution::TaskGraphMainThread, [nodeRef = inNode->GetRef()]() {
+		FPinnedNode node = nodeRef.Pin();
+		if (!node || node->IsLeaf()) return;
+		for (int i = 0; i < 4; i++) {
+			node->GetChild(i)->InitializeChunk(); // Initialize component on main thread then dispatch mesh update
+		}
+		Async(EAsyncExecution::LargeThreadPool, [nodeRef]() {
+			FPinnedNode node = nodeRef.Pin();
+			if (!node || node->IsLeaf()) return;
+			for (int i = 0; i < 4; i++) {
+				//A merge can release the children while they generate, pin them like the parent
+				if (FPinnedNode child = node->GetChild(i)->GetRef().Pin()) {
+					child->GenerateMeshData();
+				}
+			}
+			node->EndRestructure();
+		});
+	});
 }
-void QuadTreeNode::Split(TSharedPtr<QuadTreeNode> inNode)
+void QuadTreeNode::CreateChildren()
 {
-	if (!inNode.IsValid() || !inNode->IsLeaf() || inNode->IsRestructuring) return;
-	inNode->IsRestructuring = true;
-	int newDepth = inNode->Index.GetDepth() + 1;
 	//Children laid out according to morton XY ordered indexing
 	FVector2d childOffsets[4] = {
-		FVector2d(-inNode->QuarterSize, -inNode->QuarterSize), // Bottom-left  0b00  0
-		FVector2d(-inNode->QuarterSize,  inNode->QuarterSize), // Top-left     0b01  1
-		FVector2d(inNode->QuarterSize,  -inNode->QuarterSize), // Bottom-right 0b10  2
-		FVector2d(inNode->QuarterSize,   inNode->QuarterSize)  // Top-right    0b11  3
+		FVector2d(-QuarterSize, -QuarterSize), // Bottom-left  0b00  0
+		FVector2d(-QuarterSize,  QuarterSize), // Top-left     0b01  1
+		FVector2d(QuarterSize,  -QuarterSize), // Bottom-right 0b10  2
+		FVector2d(QuarterSize,   QuarterSize)  // Top-right    0b11  3
 	};
 
+	//All four siblings go into one pool block so they sit next to each other in memory
+	uint32 block = Pool->AllocateBlock();
 	for (int i = 0; i < 4; i++) {
 		// Start with parent center
-		FVector childCenter = inNode->Center;
-		childCenter[inNode->FaceTransform.AxisMap[0]] += inNode->FaceTransform.AxisDir[0] * childOffsets[i].X;
-		childCenter[inNode->FaceTransform.AxisMap[1]] += inNode->FaceTransform.AxisDir[1] * childOffsets[i].Y;
-		inNode->Children.Add(MakeShared<QuadTreeNode>(inNode->ParentActor, inNode->NoiseGen, inNode->FaceTransform, inNode->Index.GetChildIndex(i), childCenter, inNode->HalfSize, inNode->SphereRadius, inNode->MinDepth, inNode->MaxDepth));
-		inNode->Children[i]->Parent = inNode.ToWeakPtr();
+		FVector childCenter = Center;
+		childCenter[FaceTransform.AxisMap[0]] += FaceTransform.AxisDir[0] * childOffsets[i].X;
+		childCenter[FaceTransform.AxisMap[1]] += FaceTransform.AxisDir[1] * childOffsets[i].Y;
+		QuadTreeNode* child = Pool->Construct(block, i, [&](void* Memory) {
+			return new (Memory) QuadTreeNode(ParentActor, NoiseGen, FaceTransform, Index.GetChildIndex(i), childCenter, HalfSize, SphereRadius, MinDepth, MaxDepth);
+		});
+		child->Parent = Handle;
 	}
+	//Publish the block only once every sibling is constructed
+	FWriteScopeLock FaceLock(ParentActor->GetFaceLock(Index.FaceId));
+	ChildBlock = block;
+}
+void QuadTreeNode::AllocateToDepth(QuadTreeNode* inNode, int inDepth, TArray<QuadTreeNode*>& OutLeaves)
+{
+	//Builds bare structure only, the nodes above inDepth never get a chunk or mesh since nothing merges into them
+	if (inNode->GetDepth() >= inDepth) {
+		OutLeaves.Add(inNode);
+		return;
+	}
+	inNode->CreateChildren();
 	for (int i = 0; i < 4; i++) {
-		inNode->Children[i]->CheckNeighbors();
+		AllocateToDepth(inNode->GetChild(i), inDepth, OutLeaves);
 	}
-	Async(EAsyncExecution::TaskGraphMainThread, [inNode]() {
-		for (TSharedPtr<QuadTreeNode> child : inNode->Children) {
-			child->InitializeChunk(); // Initialize component on main thread then dispatch mesh update
-		}
-		Async(EAsyncExecution::LargeThreadPool, [inNode]() {
-			int newLod = inNode->Index.GetDepth() + 1;
-			for (int i = 0; i < 4; i++) {
-				inNode->Children[i]->GenerateMeshData();
-			}
-			inNode->IsRestructuring = false;
-		});
-	});
 }
 void QuadTreeNode::TryMerge()
 {
-	if (IsLeaf()) return;
-
 	bool willMerge = true;
-	for (TSharedPtr<QuadTreeNode> child : Children)
 	{
-		if (!child->CanMerge || !child->LastRenderedState)
+		FReadScopeLock FaceLock(ParentActor->GetFaceLock(Index.FaceId));
+		if (IsLeaf()) return;
+		for (int i = 0; i < 4; i++)
 		{
-			willMerge = false;
+			QuadTreeNode* child = GetChild(i);
+			if (!child->CanMerge || child->GetState() != ENodeState::Visible)
+			{
+				willMerge = false;
+			}
 		}
 	}
 	if (willMerge) {
-		QuadTreeNode::Merge(AsShared());
+		QuadTreeNode::Merge(this);
 	}
 }
-void QuadTreeNode::Merge(TSharedPtr<QuadTreeNode> inNode)
+void QuadTreeNode::Merge(QuadTreeNode* inNode)
 {
-	if (!inNode.IsValid() || inNode->IsLeaf() || inNode->IsRestructuring) return;
-	inNode->CheckNeighbors();
-	AsyncTask(ENamedThreads::GameThread, [inNode]() mutable {
-		inNode->IsRestructuring = true;
-		inNode->SetChunkVisibility(true);
-		inNode->RemoveChildren(inNode->AsShared());
-		inNode->IsRestructuring = false;
-		});
-}
-void QuadTreeNode::RemoveChildren(TSharedPtr<QuadTreeNode> InNode)
-{
-	if (!InNode.IsValid()) {
+	if (!inNode || !inNode->IsAlive() || inNode->IsLeaf()) return;
+	if (!inNode->IsInitialized || !inNode->HasGenerated) return; //Structural ancestor from startup, it has nothing to show
+	//An ancestor evicted under the residency budget is regenerated first, the merge goes ahead on a later pass
+	ENodeState state = inNode->GetState();
+	if (state == ENodeState::Evicted) {
+		inNode->RestoreMeshData();
 		return;
 	}
+	if (state != ENodeState::Hidden && state != ENodeState::Visible) return;
+	if (!inNode->TryBeginRestructure()) return;
+	if (inNode->CheckNeighbors()) inNode->isEdgeRangeDirty = true;
+	AsyncTask(ENamedThreads::GameThread, [nodeRef = inNode->GetRef()]() {
+		FPinnedNode node = nodeRef.Pin();
+		if (!node) return;
+		if (node->IsLeaf()) {
+			node->EndRestructure();
+			return;
+		}
+		RealtimeMesh::FRealtimeMeshUpdateBatch updateBatch;
+		node->SetChunkVisibility(true);
+		node->LastLodChangeTime = FPlatformTime::Seconds();
 
-	TArray<TSharedPtr<QuadTreeNode>> nodeStack;
-	TArray<TSharedPtr<QuadTreeNode>> processOrder;
-	nodeStack.Push(InNode);
-	TSet<TSharedPtr<QuadTreeNode>> visitedNodes;
-
-	while (nodeStack.Num() > 0) {
-		TSharedPtr<QuadTreeNode> currentNode = nodeStack.Last();
-		bool allChildrenProcessed = true;
-		if (!currentNode->IsLeaf()) {
-			for (int i = currentNode->Children.Num() - 1; i >= 0; --i) {
-				if (currentNode->Children[i].IsValid() && !visitedNodes.Contains(currentNode->Children[i])) {
-					nodeStack.Push(currentNode->Children[i]);
-					allChildrenProcessed = false;
-				}
+		bool canRetain = node->ParentActor->MergedChildRetentionTime > 0.0 && node->RetainedBlock == InvalidNodeBlock;
+		for (int i = 0; i < 4; i++) {
+			canRetain &= node->GetChild(i)->IsLeaf();
+		}
+		if (canRetain) {
+			//Hide rather than destroy, a re-split inside the grace period can then reuse them without regenerating
+			for (int i = 0; i < 4; i++) {
+				node->GetChild(i)->SetChunkVisibility(false);
+			}
+			{
+				FWriteScopeLock FaceLock(node->ParentActor->GetFaceLock(node->Index.FaceId));
+				node->RetainedBlock = node->ChildBlock;
+				node->ChildBlock = InvalidNodeBlock;
 			}
+			node->NotifyNeighbors();
+			node->ParentActor->EnqueueNeighborUpdate(node.Get());
 		}
-		if (allChildrenProcessed) {
-			nodeStack.Pop();
-			processOrder.Add(currentNode);
-			visitedNodes.Add(currentNode);
+		else {
+			node->RemoveChildren(node.Get());
+		}
+		node->EndRestructure();
+		});
+}
+void QuadTreeNode::ReleaseRetainedChildren(QuadTreeNode* inNode)
+{
+	if (!inNode || !inNode->TryBeginRestructure()) return;
+	AsyncTask(ENamedThreads::GameThread, [nodeRef = inNode->GetRef()]() {
+		FPinnedNode node = nodeRef.Pin();
+		if (!node) return;
+		uint32 released = InvalidNodeBlock;
+		{
+			//Traversals read RetainedBlock under the face lock, unlink it the same way RemoveChildren does.
+			//The LOD pass decided before this task ran, a re-split or a newer merge since then keeps the block.
+			FWriteScopeLock FaceLock(node->ParentActor->GetFaceLock(node->Index.FaceId));
+			bool hasExpired = FPlatformTime::Seconds() - node->LastLodChangeTime.load() > node->ParentActor->MergedChildRetentionTime;
+			if (hasExpired) {
+				released = node->RetainedBlock;
+				node->RetainedBlock = InvalidNodeBlock;
+			}
 		}
+		node->DestroyBlock(released);
+		node->EndRestructure();
+	});
+}
+void QuadTreeNode::RemoveChildren(QuadTreeNode* InNode)
+{
+	if (!InNode) {
+		return;
 	}
+
 	//Join game thread to perform component destructions
-	AsyncTask(ENamedThreads::GameThread, [this, processOrder, InNode]() {
-		for (const auto& node : processOrder) {
-			// Skip the root node as we only want to process children
-			if (node != InNode) {
-				node->DestroyChunk();
-			}
-			node->Children.Reset();
+	AsyncTask(ENamedThreads::GameThread, [nodeRef = InNode->GetRef()]() {
+		FPinnedNode node = nodeRef.Pin();
+		if (!node) return;
+		uint32 childBlock;
+		uint32 retainedBlock;
+		{
+			//Detach first, once the links are gone no traversal can reach the subtree anymore
+			FWriteScopeLock FaceLock(node->ParentActor->GetFaceLock(node->Index.FaceId));
+			childBlock = node->ChildBlock;
+			retainedBlock = node->RetainedBlock;
+			node->ChildBlock = InvalidNodeBlock;
+			node->RetainedBlock = InvalidNodeBlock;
 		}
+		node->DestroyBlock(childBlock);
+		node->DestroyBlock(retainedBlock);
+		node->NotifyNeighbors();
+		node->ParentActor->EnqueueNeighborUpdate(node.Get());
 	});
 }
+void QuadTreeNode::DestroyBlock(uint32 InBlock)
+{
+	//Tears down a detached sibling block and everything below it, the pool frees the memory after its grace period
+	if (InBlock == InvalidNodeBlock) return;
+	for (int i = 0; i < 4; i++) {
+		QuadTreeNode* child = Pool->GetChild(InBlock, i);
+		DestroyBlock(child->ChildBlock);
+		DestroyBlock(child->RetainedBlock);
+		child->DestroyChunk();
+	}
+	Pool->ReleaseBlock(InBlock);
+}
+
+//State transitions
+bool QuadTreeNode::TryTransition(ENodeState InFrom, ENodeState InTo) {
+	return State.compare_exchange_strong(InFrom, InTo);
+}
+void QuadTreeNode::SetRenderedState(bool bInVisible) {
+	//Visibility only applies once the mesh is on the proxy, a node still uploading becomes visible when the upload lands
+	ENodeState target = bInVisible ? ENodeState::Visible : ENodeState::Hidden;
+	ENodeState current = State.load();
+	while (current == ENodeState::Visible || current == ENodeState::Hidden) {
+		if (State.compare_exchange_weak(current, target)) {
+			if (current == target) return;
+			if (!bInVisible) {
+				LastVisibleTime = FPlatformTime::Seconds();
+				if (!ParentActor->EncodeHiddenMeshData) return;
+			}
+			//Hidden chunks keep their GPU buffers but only a compressed CPU copy, it is expanded again once they show
+			//Expanding is on the way to the screen so it jumps the queue, compressing can wait behind everything else
+			ERealtimeMeshTaskPriority priority = bInVisible ? ERealtimeMeshTaskPriority::Interactive : ERealtimeMeshTaskPriority::Background;
+			LaunchNodeTask(priority, [nodeRef = GetRef(), bInVisible]() {
+				if (FPinnedNode node = nodeRef.Pin()) {
+					if (!bInVisible) {
+						node->EncodeMeshData();
+					}
+					else if (node->IsMeshEncoded.load()) {
+						if (node->DecodeMeshData()) {
+							node->AccountUploadBytes();
+						}
+						else {
+							//The source arrays went with the encoded copy, rebuild from noise like a restore would
+							node->GenerateMeshData();
+						}
+						node->UpdateMesh();
+					}
+				}
+			});
+			return;
+		}
+	}
+}
+bool QuadTreeNode::TryBeginRestructure() {
+	bool expected = false;
+	return IsRestructuring.compare_exchange_strong(expected, true);
+}
+void QuadTreeNode::EndRestructure() {
+	IsRestructuring = false;
+}
 
 //Property Getters/Child Collection
 bool QuadTreeNode::IsLeaf() const
 {
-	return Children.Num() == 0;
+	return ChildBlock == InvalidNodeBlock;
 }
 int QuadTreeNode::GetDepth() const
 {
 	return Index.GetDepth();
 }
-void QuadTreeNode::CollectLeaves(TSharedPtr<QuadTreeNode> InNode, TArray<TSharedPtr<QuadTreeNode>>& OutLeafNodes) {
-	FReadScopeLock ReadLock(InNode->MeshDataLock);
-	if (!InNode.IsValid()) {
+QuadTreeNode* QuadTreeNode::GetChild(int InChild) const
+{
+	return Pool->GetChild(ChildBlock, InChild);
+}
+QuadTreeNode* QuadTreeNode::GetParent() const
+{
+	return Pool->Resolve(Parent);
+}
+bool QuadTreeNode::IsAlive() const
+{
+	return Pool->Resolve(Handle) == this;
+}
+FNodeRef QuadTreeNode::GetRef() const
+{
+	return FNodeRef{ Pool->AsShared(), Handle };
+}
+void QuadTreeNode::CollectLeaves(QuadTreeNode* InNode, TArray<QuadTreeNode*>& OutLeafNodes) {
+	if (!InNode) {
 		return;
 	}
+	FReadScopeLock FaceLock(InNode->ParentActor->GetFaceLock(InNode->Index.FaceId));
 
-	TArray<TSharedPtr<QuadTreeNode>> nodeStack;
+	TArray<QuadTreeNode*, TInlineAllocator<64>> nodeStack;
 	nodeStack.Push(InNode);
 	while (nodeStack.Num() > 0) {
-		TSharedPtr<QuadTreeNode> currentNode = nodeStack.Pop();
-		if (!currentNode.IsValid()) {
+		QuadTreeNode* currentNode = nodeStack.Pop(false);
+		if (currentNode->IsLeaf()) {
+			OutLeafNodes.Add(currentNode);
 			continue;
 		}
+		for (int i = 3; i >= 0; --i) {
+			nodeStack.Add(currentNode->GetChild(i));
+		}
+	}
+}
+
+void QuadTreeNode::CollectHiddenAncestors(QuadTreeNode* InNode, TArray<QuadTreeNode*>& OutNodes) {
+	if (!InNode) {
+		return;
+	}
+	FReadScopeLock FaceLock(InNode->ParentActor->GetFaceLock(InNode->Index.FaceId));
+
+	TArray<QuadTreeNode*, TInlineAllocator<64>> nodeStack;
+	nodeStack.Push(InNode);
+	while (nodeStack.Num() > 0) {
+		QuadTreeNode* currentNode = nodeStack.Pop(false);
 		if (currentNode->IsLeaf()) {
-			OutLeafNodes.Add(currentNode);
 			continue;
 		}
-		for (int i = currentNode->Children.Num() - 1; i >= 0; --i) {
-			if (currentNode && currentNode->Children[i].IsValid()) {
-				nodeStack.Add(currentNode->Children[i]);
-			}
+		if (currentNode->IsInitialized && currentNode->GetState() == ENodeState::Hidden) {
+			OutNodes.Add(currentNode);
 		}
+		for (int i = 3; i >= 0; --i) {
+			nodeStack.Add(currentNode->GetChild(i));
+		}
+	}
+}
+
+//Residency
+SIZE_T QuadTreeNode::ComputeResidentBytes() const {
+	SIZE_T bytes = LandVertices.GetAllocatedSize() + LandNormals.GetAllocatedSize() + LandColors.GetAllocatedSize()
+		+ SeaVertices.GetAllocatedSize() + SeaNormals.GetAllocatedSize() + SeaColors.GetAllocatedSize()
+		+ TexCoords.GetAllocatedSize() + AllTriangles.GetAllocatedSize() + PatchTriangleIndices.GetAllocatedSize();
+	for (const FRealtimeMeshStreamSet* streams : { &LandMeshStream, &SeaMeshStream }) {
+		streams->ForEach([&bytes](const FRealtimeMeshStream& Stream) { bytes += Stream.GetAllocatedSize(); });
+	}
+	bytes += LandMeshEncoded.GetAllocatedSize() + SeaMeshEncoded.GetAllocatedSize();
+	//Uploaded data lives on the GPU and, unless swapped for the encoded copy, in the section groups' CPU copy
+	return bytes + UploadedBytes + (IsMeshEncoded ? 0 : UploadedBytes);
+}
+void QuadTreeNode::AccountResidentBytes() {
+	int64 residentBytes = (int64)ComputeResidentBytes();
+	ParentActor->AddResidentBytes(residentBytes - ResidentBytes.exchange(residentBytes));
+}
+void QuadTreeNode::AccountUploadBytes() {
+	FWriteScopeLock WriteLock(MeshDataLock);
+	UploadedBytes = 0;
+	for (const FRealtimeMeshStreamSet* streams : { &LandMeshStream, &SeaMeshStream }) {
+		streams->ForEach([this](const FRealtimeMeshStream& Stream) { UploadedBytes += Stream.GetResourceDataSize(); });
+	}
+	AccountResidentBytes();
+}
+void QuadTreeNode::EncodeMeshData() {
+	FWriteScopeLock WriteLock(MeshDataLock);
+	//Shown again while this was queued, or an upload is still pending
+	if (IsMeshEncoded || !HasGenerated || GetState() != ENodeState::Hidden || isMeshDirty) return;
+	//The uploaded streams live in the section groups, swap their CPU copy for the encoded one. Returning no
+	//updated streams leaves the GPU buffers alone. Anything rebuilt from the section groups while hidden (proxy
+	//recreation, collision) sees them empty, DecodeMeshData pushes the streams back in before the chunk shows.
+	FRealtimeMeshEncodedStreamSet* encoded[2] = { &LandMeshEncoded, &SeaMeshEncoded };
+	for (int i = 0; i < 2; i++) {
+		if (!SectionGroups[i]) continue;
+		SectionGroups[i]->EditMeshData([&](FRealtimeMeshStreamSet& Streams) {
+			URealtimeMeshDataOptimizer::EncodeStreamSet(Streams, *encoded[i]);
+			//The CPU copy has exactly the layouts and sizes the next rebuild asks for, hand it to the pool instead of freeing it
+			RealtimeMesh::FRealtimeMeshStreamPool::Get().Release(Streams);
+			return TSet<FRealtimeMeshStreamKey>();
+		});
+	}
+	//The source arrays are only read while building the streams, GenerateMeshData rebuilds them if it ever runs again
+	LandVertices.Empty();
+	LandNormals.Empty();
+	LandColors.Empty();
+	SeaVertices.Empty();
+	SeaNormals.Empty();
+	SeaColors.Empty();
+	TexCoords.Empty();
+	AllTriangles.Empty();
+	PatchTriangleIndices.Empty();
+	IsMeshEncoded = true;
+	AccountResidentBytes();
+}
+bool QuadTreeNode::DecodeMeshData() {
+	FWriteScopeLock WriteLock(MeshDataLock);
+	if (!IsMeshEncoded) return false;
+	//Shown again or restored after eviction, either way the streams go into fresh stream sets that the next mesh pass
+	//moves into the section groups and uploads. The groups sat empty while encoded, so whatever rebuilt from them in
+	//the meantime (proxy, collision) only matches again once they are pushed back.
+	FRealtimeMeshEncodedStreamSet* encoded[2] = { &LandMeshEncoded, &SeaMeshEncoded };
+	FRealtimeMeshStreamSet* streams[2] = { &LandMeshStream, &SeaMeshStream };
+	bool decoded = true;
+	for (int i = 0; i < 2; i++) {
+		decoded &= URealtimeMeshDataOptimizer::DecodeStreamSet(*encoded[i], *streams[i]);
 	}
+	if (decoded) {
+		isMeshDirty = true;
+	}
+	LandMeshEncoded.Empty();
+	SeaMeshEncoded.Empty();
+	IsMeshEncoded = false;
+	AccountResidentBytes();
+	return decoded;
+}
+void QuadTreeNode::EvictMeshData() {
+	//Only a hidden ancestor gives its data up, Merge brings it back through RestoreMeshData before showing it again.
+	//An encoded copy is small enough to keep, restoring from it skips the noise pass.
+	if (!IsInitialized || IsLeaf() || !TryTransition(ENodeState::Hidden, ENodeState::Evicted)) return;
+	{
+		FWriteScopeLock WriteLock(MeshDataLock);
+		LandVertices.Empty();
+		LandNormals.Empty();
+		LandColors.Empty();
+		SeaVertices.Empty();
+		SeaNormals.Empty();
+		SeaColors.Empty();
+		TexCoords.Empty();
+		AllTriangles.Empty();
+		PatchTriangleIndices.Empty();
+		for (FRealtimeMeshStreamSet* streams : { &LandMeshStream, &SeaMeshStream }) {
+			RealtimeMesh::FRealtimeMeshStreamPool::Get().Release(*streams);
+		}
+		isMeshDirty = false;
+		isEdgeRangeDirty = false;
+		UploadedBytes = 0;
+		AccountResidentBytes();
+	}
+	//Empty stream sets release the GPU buffers, the component and section groups stay so a restore is only an upload
+	RtMesh->UpdateSectionGroup(LandGroupKey, FRealtimeMeshStreamSet());
+	RtMesh->UpdateSectionGroup(SeaGroupKey, FRealtimeMeshStreamSet());
+	ParentActor->EvictedNodeCount++;
+}
+void QuadTreeNode::RestoreMeshData() {
+	if (!TryTransition(ENodeState::Evicted, ENodeState::Generating)) return;
+	ParentActor->EvictedNodeCount--;
+	Async(EAsyncExecution::LargeThreadPool, [nodeRef = GetRef()]() {
+		FPinnedNode node = nodeRef.Pin();
+		if (!node) return;
+		//An encoded copy only needs expanding and uploading, without one the mesh is rebuilt from noise
+		if (node->DecodeMeshData()) {
+			node->AccountUploadBytes();
+			node->TryTransition(ENodeState::Generating, ENodeState::Ready);
+			node->ParentActor->EnqueueNeighborUpdate(node.Get());
+		}
+		else {
+			node->GenerateMeshData();
+		}
+		node->UpdateMesh();
+	});
 }
 
 ////MESH STUFF - Must invoke on game thread
@@ -414,31 +804,48 @@ void QuadTreeNode::InitializeChunk() {
 	ChunkComponent->SetRealtimeMesh(RtMesh);
 
 	// Calculate the world-space position of the *unperturbed* chunk center on the sphere
-	FVector unperturbedPoint = Center.GetSafeNormal() * SphereRadius;
+	FVector unperturbedPoint = ProjectToSphere(Center) * SphereRadius;
 
 	// Set the world offset.
 	ChunkComponent->AddWorldOffset(unperturbedPoint + ParentActor->GetActorLocation());
 
-	RtMesh->CreateSectionGroup(LandGroupKeyInner, LandMeshStreamInner);
-	RtMesh->CreateSectionGroup(SeaGroupKeyInner, SeaMeshStreamInner);
-
-	RtMesh->CreateSectionGroup(LandGroupKeyEdge, LandMeshStreamEdge);
-	RtMesh->CreateSectionGroup(SeaGroupKeyEdge, SeaMeshStreamEdge);
+	//The streams carry no polygroups, so the groups don't auto-create sections. Patch and edge sections share a
+	//material slot, merging draws them as one batch and joins them into one element when the edge variant sits
+	//right after the patch (no coarser neighbors).
+	RtMesh->CreateSectionGroup(LandGroupKey, LandMeshStream);
+	RtMesh->CreateSectionGroup(SeaGroupKey, SeaMeshStream);
+	FRealtimeMeshStreamRange emptyRange(0, 0, 0, 0);
+	RtMesh->CreateSection(LandSectionKeyInner, FRealtimeMeshSectionConfig(ERealtimeMeshSectionDrawType::Static, 0), emptyRange);
+	RtMesh->CreateSection(LandSectionKeyEdge, FRealtimeMeshSectionConfig(ERealtimeMeshSectionDrawType::Static, 0), emptyRange);
+	RtMesh->CreateSection(SeaSectionKeyInner, FRealtimeMeshSectionConfig(ERealtimeMeshSectionDrawType::Static, 1), emptyRange);
+	RtMesh->CreateSection(SeaSectionKeyEdge, FRealtimeMeshSectionConfig(ERealtimeMeshSectionDrawType::Static, 1), emptyRange);
+	RtMesh->SetMergeCompatibleSections(true);
+	SectionGroups[0] = RtMesh->GetSectionGroup(LandGroupKey);
+	SectionGroups[1] = RtMesh->GetSectionGroup(SeaGroupKey);
 
 	IsInitialized = true;
+	TryTransition(ENodeState::Allocated, ENodeState::Generating);
 }
 void QuadTreeNode::SetChunkVisibility(bool inVisibility) {
+	if (!IsInitialized || GetState() == ENodeState::Retiring) return;
+	RealtimeMesh::FRealtimeMeshUpdateBatch updateBatch;
 	if (RenderSea) {
 		RtMesh->SetSectionVisibility(SeaSectionKeyEdge, inVisibility);
 		RtMesh->SetSectionVisibility(SeaSectionKeyInner, inVisibility);
 	}
 
 	RtMesh->SetSectionVisibility(LandSectionKeyInner, inVisibility);
-	RtMesh->SetSectionVisibility(LandSectionKeyEdge, inVisibility).Then([this, inVisibility](TFuture<ERealtimeMeshProxyUpdateStatus> completedFuture) {
-		LastRenderedState = inVisibility;
+	RtMesh->SetSectionVisibility(LandSectionKeyEdge, inVisibility).Then([nodeRef = GetRef(), inVisibility](TFuture<ERealtimeMeshProxyUpdateStatus> completedFuture) {
+		if (FPinnedNode node = nodeRef.Pin()) {
+			node->SetRenderedState(inVisibility);
+		}
 	});
 }
 void QuadTreeNode::DestroyChunk() {
+	if (State.exchange(ENodeState::Retiring) == ENodeState::Evicted) {
+		ParentActor->EvictedNodeCount--;
+	}
+	ParentActor->AddResidentBytes(-ResidentBytes.exchange(0));
 	if (IsInitialized && ChunkComponent) {
 		ParentActor->RemoveOwnedComponent(ChunkComponent);
 		ChunkComponent->DestroyComponent();
@@ -446,29 +853,21 @@ void QuadTreeNode::DestroyChunk() {
 }
 
 //Mesh Data Generation, can be multithreaded
-FMeshStreamBuilders QuadTreeNode::InitializeStreamBuilders(FRealtimeMeshStreamSet& inMeshStream, int inResolution) {
-	//TODO: Needs optimization to account for edge vs center patch cases (edge case uses different amount of verts/tris
-	FMeshStreamBuilders Builders;
-
-	inMeshStream.Empty();
-	Builders.NumVerts = inResolution * inResolution + (inResolution * 8);
-	Builders.NumTriangles = (inResolution - 1) * (inResolution - 1) * 2;
-
-	Builders.PositionBuilder = new TRealtimeMeshStreamBuilder<FVector, FVector3f>(inMeshStream.AddStream(FRealtimeMeshStreams::Position, GetRealtimeMeshBufferLayout<FVector3f>()));
-	Builders.TangentBuilder = new TRealtimeMeshStreamBuilder<FRealtimeMeshTangentsHighPrecision, FRealtimeMeshTangentsNormalPrecision>(inMeshStream.AddStream(FRealtimeMeshStreams::Tangents, GetRealtimeMeshBufferLayout<FRealtimeMeshTangentsNormalPrecision>()));
-	Builders.TexCoordsBuilder = new TRealtimeMeshStreamBuilder<FVector2f, FVector2DHalf>(inMeshStream.AddStream(FRealtimeMeshStreams::TexCoords, GetRealtimeMeshBufferLayout<FVector2DHalf>()));
-	Builders.ColorBuilder = new TRealtimeMeshStreamBuilder<FColor>(inMeshStream.AddStream(FRealtimeMeshStreams::Color, GetRealtimeMeshBufferLayout<FColor>()));
-	Builders.TrianglesBuilder = new TRealtimeMeshStreamBuilder<TIndex3<uint32>>(inMeshStream.AddStream(FRealtimeMeshStreams::Triangles, GetRealtimeMeshBufferLayout<TIndex3<uint32>>()));
-	Builders.PolygroupsBuilder = new TRealtimeMeshStreamBuilder<uint32, uint16>(inMeshStream.AddStream(FRealtimeMeshStreams::PolyGroups, GetRealtimeMeshBufferLayout<uint16>()));
-
-	Builders.PositionBuilder->Reserve(Builders.NumVerts);
-	Builders.TangentBuilder->Reserve(Builders.NumVerts);
-	Builders.TexCoordsBuilder->Reserve(Builders.NumVerts);
-	Builders.ColorBuilder->Reserve(Builders.NumVerts);
-	Builders.TrianglesBuilder->Reserve(Builders.NumTriangles);
-	Builders.PolygroupsBuilder->Reserve(Builders.NumTriangles);
-
-	return Builders;
+FMeshStreamBuilders QuadTreeNode::InitializeStreamBuilders(FRealtimeMeshStreamSet& inMeshStream, int inNumVertices, int inNumTriangles) {
+	//Leftover streams (a decoded copy, an upload that never went out) go back to the pool before the builders take new ones
+	RealtimeMesh::FRealtimeMeshStreamPool::Get().Release(inMeshStream);
+	return FMeshStreamBuilders(inMeshStream, inNumVertices, inNumTriangles);
+}
+void QuadTreeNode::AppendGatheredVertices(FMeshStreamBuilders& Builders, const TArray<FVector>& Vertices, const TArray<FColor>& Colors, const TArray<FVector3f>& Normals, TConstArrayView<int32> Indices) {
+	//Positions and texcoords narrow to float/half through the builders' vectorized bulk converters
+	Builders.PositionBuilder.AppendIndexed(MakeArrayView(Vertices), Indices);
+	Builders.ColorBuilder.AppendIndexed(MakeArrayView(Colors), Indices);
+	Builders.TexCoordsBuilder.AppendIndexed(MakeArrayView(TexCoords), Indices);
+	Builders.TangentBuilder.AppendGenerator(Indices.Num(), [&](int32 i, int32) {
+		FRealtimeMeshTangentsHighPrecision tangent;
+		tangent.SetNormal(Normals[Indices[i]]);
+		return tangent;
+	});
 }
 FColor QuadTreeNode::EncodeDepthColor(float depth) {
 	//Encodes depth in vertex color
@@ -520,17 +919,22 @@ FVector QuadTreeNode::GetFacePoint(float step, double x, double y) {
 	return result;
 }
 
+FVector QuadTreeNode::ProjectToSphere(const FVector& InCubePoint) const {
+	//Face points, child centers and neighbor edges all live on the cube, so warping only here keeps shared edges watertight
+	return FCubeTransform::ProjectToSphere(InCubePoint, Projection);
+}
+
 int QuadTreeNode::GenerateVertex(double x, double y, double step) {
 	FVector facePoint = GetFacePoint(step, x, y); // Face point relative to Center.
 
 	// Calculate world-space position of the *unperturbed* chunk center on the sphere
-	FVector unperturbedPoint = Center.GetSafeNormal() * SphereRadius;
+	FVector unperturbedPoint = ProjectToSphere(Center) * SphereRadius;
 
 	// Now get the actual point on the face in world space
 	FVector worldPoint = Center + facePoint;
 
 	// Normalize the world space point (still without noise).
-	FVector normalizedPoint = worldPoint.GetSafeNormal();
+	FVector normalizedPoint = ProjectToSphere(worldPoint);
 
 	// Add noise to get the final land position.
 	FVector landPoint = NoiseGen->GetNoiseFromPosition(normalizedPoint) * SphereRadius;
@@ -566,6 +970,9 @@ void QuadTreeNode::GenerateMeshData() {
 	if (!NoiseGen || !IsInitialized) return;
 	{
 		FWriteScopeLock WriteLock(MeshDataLock);
+		LandMeshEncoded.Empty();
+		SeaMeshEncoded.Empty();
+		IsMeshEncoded = false;
 		LandVertices.Reset();
 		SeaVertices.Reset();
 		LandNormals.Reset();
@@ -577,7 +984,7 @@ void QuadTreeNode::GenerateMeshData() {
 		PatchTriangleIndices.Reset();
 
 		FVector sphereCenter = ParentActor->GetActorLocation();
-		CenterOnSphere = Center.GetSafeNormal() * SphereRadius;
+		CenterOnSphere = ProjectToSphere(Center) * SphereRadius;
 
 		float step = (Size) / (float)(ParentActor->FaceResolution - 1);
 		int ModifiedResolution = ParentActor->FaceResolution + 2;
@@ -585,16 +992,17 @@ void QuadTreeNode::GenerateMeshData() {
 
 		LandCentroid = FVector::ZeroVector;
 		SeaCentroid = FVector::ZeroVector;
+		VisibleVertexCount = 0;
 		MinLandRadius = SphereRadius * 10.0;
 		MaxLandRadius = 0.0;
 		MaxNodeRadius = 0.0;
 
 		// Calculate the world-space position of the *unperturbed* chunk center on the sphere
-		FVector unperturbedPoint = Center.GetSafeNormal() * SphereRadius;
+		FVector unperturbedPoint = ProjectToSphere(Center) * SphereRadius;
 
 		for (int32 x = 0; x < ModifiedResolution; x++) {
 			for (int32 y = 0; y < ModifiedResolution; y++) {
-				int idx = GenerateVertex(x - 1, y - 1, step);
+				GenerateVertex(x - 1, y - 1, step);
 			}
 		}
 
@@ -648,32 +1056,33 @@ void QuadTreeNode::GenerateMeshData() {
 		SeaCentroid = SeaCentroid / VisibleVertexCount;
 
 		uint32 numPos = (uint32)LandVertices.Num();
+
+		// Calculate the normals by averaging the normals of neighboring triangles, one pass accumulating each face into its corners
+		TArray<FVector> normalSums;
+		normalSums.SetNumZeroed(numPos);
+		for (const FIndex3UI& tri : AllTriangles)
+		{
+			// Use LOCAL vertex positions for the normal calculation
+			const FVector& P0 = LandVertices[tri[0]];
+			const FVector& P1 = LandVertices[tri[1]];
+			const FVector& P2 = LandVertices[tri[2]];
+
+			// Calculate the face normal using LOCAL vertex positions
+			FVector FaceNormal = FVector::CrossProduct(P1 - P0, P2 - P0).GetSafeNormal();
+
+			normalSums[tri[0]] += FaceNormal;
+			normalSums[tri[1]] += FaceNormal;
+			normalSums[tri[2]] += FaceNormal;
+		}
+
+		LandNormals.Reserve(numPos);
+		SeaNormals.Reserve(numPos);
 		for (uint32 i = 0; i < numPos; i++)
 		{
 			MaxNodeRadius = FMath::Max(MaxNodeRadius, FVector::Dist(LandCentroid, LandVertices[i]));
-			FVector vertexNormal = FVector::ZeroVector;
-
-			// Calculate the normal by averaging the normals of neighboring triangles
-			for (int32 j = 0; j < AllTriangles.Num(); j++)
-			{
-				auto tri = AllTriangles[j];
-				if (tri[0] == i || tri[1] == i || tri[2] == i)
-				{
-					// Use LOCAL vertex positions for the normal calculation
-					const FVector& P0 = LandVertices[tri[0]];
-					const FVector& P1 = LandVertices[tri[1]];
-					const FVector& P2 = LandVertices[tri[2]];
-
-					// Calculate the face normal using LOCAL vertex positions
-					FVector FaceNormal = FVector::CrossProduct(P1 - P0, P2 - P0).GetSafeNormal();
-
-					// Add the face normal to the vertex normal
-					vertexNormal += FaceNormal;
-				}
-			}
 
 			// Normalize the resulting vertex normal
-			vertexNormal = vertexNormal.GetSafeNormal();
+			FVector vertexNormal = normalSums[i].GetSafeNormal();
 
 			// Since we're working in local space now, use the local position relative to the unperturbed point for the reference vector
 			FVector referenceVector = (LandVertices[i]+unperturbedPoint).GetSafeNormal(); // Directly use the normalized local vector.
@@ -695,306 +1104,70 @@ void QuadTreeNode::GenerateMeshData() {
 		if (MinLandRadius - seaThreshold < SphereRadius) RenderSea = true;
 		HasGenerated = true;
 	}
-	UpdateEdgeMeshBuffer();
-	UpdatePatchMeshBuffer();
+	UpdateMeshBuffers();
+	AccountUploadBytes();
+	TryTransition(ENodeState::Generating, ENodeState::Ready);
+	ParentActor->EnqueueNeighborUpdate(this);
 }
-void QuadTreeNode::UpdateEdgeMeshBuffer() {
+void QuadTreeNode::UpdateMeshBuffers() {
 	if (!HasGenerated) return;
 
 	FWriteScopeLock WriteLock(MeshDataLock);
-	float step = (Size) / (float)(ParentActor->FaceResolution - 1);
-	int ModifiedResolution = ParentActor->FaceResolution + 2;
-
-	int curLodLevel = GetDepth();
-
-	int tResolution = ParentActor->FaceResolution;
-
-	bool leftLodChange = Index.GetDepth() > NeighborLods[(uint8)EdgeOrientation::LEFT];
-	bool topLodChange = Index.GetDepth() > NeighborLods[(uint8)EdgeOrientation::UP];
-	bool rightLodChange = Index.GetDepth() > NeighborLods[(uint8)EdgeOrientation::RIGHT];
-	bool bottomLodChange = Index.GetDepth() > NeighborLods[(uint8)EdgeOrientation::DOWN];
-
-	TArray<FIndex3UI> BufferTriangles;
-
-	FIndex3UI topOddTri;
-	FIndex3UI bottomOddTri;
-	FIndex3UI leftOddTri;
-	FIndex3UI rightOddTri;
-
-	//The internal cases here can probably be abstracted
-	for (int i = 1; i < tResolution; i++) {
-		{ 
-			//TOP EDGE TRIANGLES
-			int x = i;
-			int y = 1;
-			
-			int topLeft = x * ModifiedResolution + y;
-			int bottomLeft = (x + 1) * ModifiedResolution + y;
-
-			//			   TOP LEFT, TOP RIGHT,  BOTTOM LEFT, BOTTOM RIGHT
-			int quad[4] = { topLeft, topLeft + 1, bottomLeft, bottomLeft + 1 };
-
-			//Odd quads
-			if (x % 2 != 0) {
-				//Persist odd "top right" triangles to process in even iterations
-				topOddTri = FIndex3UI(quad[3], quad[0], quad[2]);
-				//Always generate this triangle unless it is on the corner
-				if (x != 1) {
-					BufferTriangles.Add(FIndex3UI(quad[0], quad[3], quad[1]));
-				}
-			}
-			//Even quads
-			else {
-				//If there is a lod change, we modify the previous iterations triangle instead of generating a new one
-				if (topLodChange) {
-					topOddTri[2] = quad[2];
-					BufferTriangles.Add(topOddTri);
-				}
-				//If there is no lod change, add the last iterations triangle and the new triangle
-				else {
-					BufferTriangles.Add(topOddTri);
-					BufferTriangles.Add(FIndex3UI(quad[0], quad[2], quad[1]));
-				}
-				//Always generate this triangle unless it is on the corner
-				if (x != tResolution - 1) {
-					BufferTriangles.Add(FIndex3UI(quad[1], quad[2], quad[3]));
-				}
-			}
-		}
-
-		{ 
-			//BOTTOM EDGE TRIANGLES
-			int x = i;
-			int y = tResolution - 1;
-			
-			int topLeft = x * ModifiedResolution + y;
-			int bottomLeft = (x + 1) * ModifiedResolution + y;
-
-			//			   TOP LEFT, TOP RIGHT,  BOTTOM LEFT, BOTTOM RIGHT
-			int quad[4] = { bottomLeft, bottomLeft + 1, topLeft, topLeft + 1 };
-
-			//Odd quads
-			if (x % 2 != 0) {
-				//Persist odd "top right" triangles to process in even iterations
-				bottomOddTri = FIndex3UI(quad[3], quad[0], quad[1]);
-				//Always generate this triangle unless it is on the corner
-				if (x != 1) {
-					BufferTriangles.Add(FIndex3UI(quad[3], quad[2], quad[0]));
-				}
-			}
-			//Even quads
-			else {
-				//If there is a lod change, we modify the previous iterations triangle instead of generating a new one
-				if (bottomLodChange) {
-					bottomOddTri[2] = quad[1];
-					BufferTriangles.Add(bottomOddTri);
-				}
-				//If there is no lod change, add the last iterations triangle and the new triangle
-				else {
-					BufferTriangles.Add(bottomOddTri);
-					BufferTriangles.Add(FIndex3UI(quad[1], quad[3], quad[2]));
-				}
-				//Always generate this triangle unless it is on the corner
-				if (x != tResolution - 1) {
-					BufferTriangles.Add(FIndex3UI(quad[0], quad[1], quad[2]));
-				}
-			}
-		}
-
-		{
-			//LEFT EDGE TRIANGLES
-			int y = i;
-			int x = 1;
-
-			int topLeft = x * ModifiedResolution + y;
-			int bottomLeft = (x + 1) * ModifiedResolution + y;
-
-			//			   TOP LEFT, TOP RIGHT,  BOTTOM LEFT, BOTTOM RIGHT
-			int quad[4] = { topLeft, bottomLeft, topLeft + 1, bottomLeft + 1 };
-
-			//Odd quads
-			if (y % 2 != 0) {
-				//Persist odd "top right" triangles to process in even iterations
-				leftOddTri = FIndex3UI(quad[0], quad[3], quad[2]);
-				//Always generate this triangle unless it is on the corner
-				if (y != 1) {
-					BufferTriangles.Add(FIndex3UI(quad[3], quad[0], quad[1]));
-				}
-			}
-			//Even quads
-			else {
-				//If there is a lod change, we modify the previous iterations triangle instead of generating a new one
-				if (leftLodChange) {
-					leftOddTri[2] = quad[2];
-					BufferTriangles.Add(leftOddTri);
-				}
-				//If there is no lod change, add the last iterations triangle and the new triangle
-				else {
-					BufferTriangles.Add(leftOddTri);
-					BufferTriangles.Add(FIndex3UI(quad[2], quad[0], quad[1]));
-				}
-				//Always generate this triangle unless it is on the corner
-				if (y != tResolution - 1) {
-					BufferTriangles.Add(FIndex3UI(quad[2], quad[1], quad[3]));
-				}
-			}
-		}
-
-		{
-			//RIGHT EDGE TRIANGLES
-			int y = i;
-			int x = tResolution - 1;
-
-			int topLeft = x * ModifiedResolution + y;
-			int bottomLeft = (x + 1) * ModifiedResolution + y;
-
-			//			   TOP LEFT, TOP RIGHT,  BOTTOM LEFT, BOTTOM RIGHT
-			int quad[4] = { topLeft + 1 , bottomLeft + 1, topLeft, bottomLeft };
-
-			//Odd quads
-			if (y % 2 != 0) {
-				//Persist odd "top right" triangles to process in even iterations
-				rightOddTri = FIndex3UI(quad[0], quad[3], quad[1]);
-				//Always generate this triangle unless it is on the corner
-				if (y != 1) {
-					BufferTriangles.Add(FIndex3UI(quad[2], quad[3], quad[0]));
-				}
-			}
-			//Even quads
-			else {
-				//If there is a lod change, we modify the previous iterations triangle instead of generating a new one
-				if (rightLodChange) {
-					rightOddTri[2] = quad[1];
-					BufferTriangles.Add(rightOddTri);
-				}
-				//If there is no lod change, add the last iterations triangle and the new triangle
-				else {
-					BufferTriangles.Add(rightOddTri);
-					BufferTriangles.Add(FIndex3UI(quad[3], quad[1], quad[2]));
-				}
-				//Always generate this triangle unless it is on the corner
-				if (y != tResolution - 1) {
-					BufferTriangles.Add(FIndex3UI(quad[1], quad[0], quad[2]));
-				}
-			}
-		}
-	}
-
-	auto landEdgeBuilders = InitializeStreamBuilders(LandMeshStreamEdge, ParentActor->FaceResolution);
-	auto seaEdgeBuilders = InitializeStreamBuilders(SeaMeshStreamEdge, ParentActor->FaceResolution);
-
-	for (FIndex3UI tri : BufferTriangles) {
-		if (FaceTransform.bFlipWinding) {
-			tri = FIndex3UI(tri[0], tri[2], tri[1]);
-		}
-		int lv0 = landEdgeBuilders.PositionBuilder->Add(LandVertices[tri[0]]);
-		landEdgeBuilders.ColorBuilder->Add(LandColors[tri[0]]);
-		landEdgeBuilders.TexCoordsBuilder->Add(TexCoords[tri[0]]);
-		FRealtimeMeshTangentsHighPrecision lTan0;
-		lTan0.SetNormal(LandNormals[tri[0]]);
-		landEdgeBuilders.TangentBuilder->Add(lTan0);
-
-		int lv1 = landEdgeBuilders.PositionBuilder->Add(LandVertices[tri[1]]);
-		landEdgeBuilders.ColorBuilder->Add(LandColors[tri[1]]);
-		landEdgeBuilders.TexCoordsBuilder->Add(TexCoords[tri[1]]);
-		FRealtimeMeshTangentsHighPrecision lTan1;
-		lTan1.SetNormal(LandNormals[tri[1]]);
-		landEdgeBuilders.TangentBuilder->Add(lTan1);
-
-		int lv2 = landEdgeBuilders.PositionBuilder->Add(LandVertices[tri[2]]);
-		landEdgeBuilders.ColorBuilder->Add(LandColors[tri[2]]);
-		landEdgeBuilders.TexCoordsBuilder->Add(TexCoords[tri[2]]);
-		FRealtimeMeshTangentsHighPrecision lTan2;
-		lTan2.SetNormal(LandNormals[tri[2]]);
-		landEdgeBuilders.TangentBuilder->Add(lTan2);
-
-		landEdgeBuilders.TrianglesBuilder->Add(FIndex3UI(lv0, lv1, lv2));
-		landEdgeBuilders.PolygroupsBuilder->Add(0);
-
-		int sv0 = seaEdgeBuilders.PositionBuilder->Add(SeaVertices[tri[0]]);
-		seaEdgeBuilders.ColorBuilder->Add(SeaColors[tri[0]]);
-		seaEdgeBuilders.TexCoordsBuilder->Add(TexCoords[tri[0]]);
-		FRealtimeMeshTangentsHighPrecision sTan0;
-		sTan0.SetNormal(SeaNormals[tri[0]]);
-		seaEdgeBuilders.TangentBuilder->Add(sTan0);
-
-		int sv1 = seaEdgeBuilders.PositionBuilder->Add(SeaVertices[tri[1]]);
-		seaEdgeBuilders.ColorBuilder->Add(SeaColors[tri[1]]);
-		seaEdgeBuilders.TexCoordsBuilder->Add(TexCoords[tri[1]]);
-		FRealtimeMeshTangentsHighPrecision sTan1;
-		sTan1.SetNormal(SeaNormals[tri[1]]);
-		seaEdgeBuilders.TangentBuilder->Add(sTan1);
-
-		int sv2 = seaEdgeBuilders.PositionBuilder->Add(SeaVertices[tri[2]]);
-		seaEdgeBuilders.ColorBuilder->Add(SeaColors[tri[2]]);
-		seaEdgeBuilders.TexCoordsBuilder->Add(TexCoords[tri[2]]);
-		FRealtimeMeshTangentsHighPrecision sTan2;
-		sTan2.SetNormal(SeaNormals[tri[2]]);
-		seaEdgeBuilders.TangentBuilder->Add(sTan2);
-
-		seaEdgeBuilders.TrianglesBuilder->Add(FIndex3UI(sv0, sv1, sv2));
-		seaEdgeBuilders.PolygroupsBuilder->Add(1);
-	}
-	isEdgeDirty = true;
-}
-void QuadTreeNode::UpdatePatchMeshBuffer() {
-	if (!HasGenerated) return;
-	FReadScopeLock ReadLock(MeshDataLock);
-	auto landBuilders = InitializeStreamBuilders(LandMeshStreamInner, ParentActor->FaceResolution);
-	auto seaBuilders = InitializeStreamBuilders(SeaMeshStreamInner, ParentActor->FaceResolution);
+	//Every stitching variant is uploaded once, neighbor LOD changes only move the drawn index range (see GetEdgeStreamRange)
+	const FEdgeStitchTopology& topology = FEdgeStitchTopology::Get(ParentActor->FaceResolution, FaceTransform.bFlipWinding);
 
+	//Patch triangles don't share vertices, expand them to one vertex per corner and gather the attributes in bulk
+	TArray<int32> patchVertexIndices;
+	patchVertexIndices.Reserve(PatchTriangleIndices.Num() * 3);
 	for (int32 patchIdx : PatchTriangleIndices) {
-		FIndex3UI tri = AllTriangles[patchIdx];
-
-		int lv0 = landBuilders.PositionBuilder->Add(LandVertices[tri[0]]);
-		landBuilders.ColorBuilder->Add(LandColors[tri[0]]);
-		landBuilders.TexCoordsBuilder->Add(TexCoords[tri[0]]);
-		FRealtimeMeshTangentsHighPrecision lTan0;
-		lTan0.SetNormal(LandNormals[tri[0]]);
-		landBuilders.TangentBuilder->Add(lTan0);
-
-		int lv1 = landBuilders.PositionBuilder->Add(LandVertices[tri[1]]);
-		landBuilders.ColorBuilder->Add(LandColors[tri[1]]);
-		landBuilders.TexCoordsBuilder->Add(TexCoords[tri[1]]);
-		FRealtimeMeshTangentsHighPrecision lTan1;
-		lTan1.SetNormal(LandNormals[tri[1]]);
-		landBuilders.TangentBuilder->Add(lTan1);
-
-		int lv2 = landBuilders.PositionBuilder->Add(LandVertices[tri[2]]);
-		landBuilders.ColorBuilder->Add(LandColors[tri[2]]);
-		landBuilders.TexCoordsBuilder->Add(TexCoords[tri[2]]);
-		FRealtimeMeshTangentsHighPrecision lTan2;
-		lTan2.SetNormal(LandNormals[tri[2]]);
-		landBuilders.TangentBuilder->Add(lTan2);
-
-		FIndex3UI newLandTri = FIndex3UI(lv0, lv1, lv2);
-		landBuilders.TrianglesBuilder->Add(newLandTri);
-		landBuilders.PolygroupsBuilder->Add(0);
-
-		int sv0 = seaBuilders.PositionBuilder->Add(SeaVertices[tri[0]]);
-		seaBuilders.ColorBuilder->Add(SeaColors[tri[0]]);
-		seaBuilders.TexCoordsBuilder->Add(TexCoords[tri[0]]);
-		FRealtimeMeshTangentsHighPrecision sTan0;
-		sTan0.SetNormal(SeaNormals[tri[0]]);
-		seaBuilders.TangentBuilder->Add(sTan0);
-
-		int sv1 = seaBuilders.PositionBuilder->Add(SeaVertices[tri[1]]);
-		seaBuilders.ColorBuilder->Add(SeaColors[tri[1]]);
-		seaBuilders.TexCoordsBuilder->Add(TexCoords[tri[1]]);
-		FRealtimeMeshTangentsHighPrecision sTan1;
-		sTan1.SetNormal(SeaNormals[tri[1]]);
-		seaBuilders.TangentBuilder->Add(sTan1);
-
-		int sv2 = seaBuilders.PositionBuilder->Add(SeaVertices[tri[2]]);
-		seaBuilders.ColorBuilder->Add(SeaColors[tri[2]]);
-		seaBuilders.TexCoordsBuilder->Add(TexCoords[tri[2]]);
-		FRealtimeMeshTangentsHighPrecision sTan2;
-		sTan2.SetNormal(SeaNormals[tri[2]]);
-		seaBuilders.TangentBuilder->Add(sTan2);
-
-		FIndex3UI newSeaTri = FIndex3UI(sv0, sv1, sv2);
-		seaBuilders.TrianglesBuilder->Add(newSeaTri);
-		seaBuilders.PolygroupsBuilder->Add(1);
-	}
-	isPatchDirty = true;
+		const FIndex3UI& tri = AllTriangles[patchIdx];
+		patchVertexIndices.Add(tri[0]);
+		patchVertexIndices.Add(tri[1]);
+		patchVertexIndices.Add(tri[2]);
+	}
+	PatchTriangleCount = PatchTriangleIndices.Num();
+
+	//Sized from this node's patch and the shared edge ring, so the pooled streams are acquired at exactly the rows written
+	const int32 numTriangles = PatchTriangleCount + topology.Triangles.Num();
+	const int32 numVertices = patchVertexIndices.Num() + topology.GridVertices.Num();
+	auto landBuilders = InitializeStreamBuilders(LandMeshStream, numVertices, numTriangles);
+	auto seaBuilders = InitializeStreamBuilders(SeaMeshStream, numVertices, numTriangles);
+
+	//Patch first, then the edge ring, so variant 0 (no coarser neighbors) continues the patch's index range
+	AppendGatheredVertices(landBuilders, LandVertices, LandColors, LandNormals, patchVertexIndices);
+	AppendGatheredVertices(landBuilders, LandVertices, LandColors, LandNormals, topology.GridVertices);
+	AppendGatheredVertices(seaBuilders, SeaVertices, SeaColors, SeaNormals, patchVertexIndices);
+	AppendGatheredVertices(seaBuilders, SeaVertices, SeaColors, SeaNormals, topology.GridVertices);
+
+	const int32 patchCount = PatchTriangleCount;
+	const int32 edgeVertexOffset = patchVertexIndices.Num();
+	auto combinedTriangle = [&topology, patchCount, edgeVertexOffset](int32 triIdx, int32) {
+		if (triIdx < patchCount) {
+			return FIndex3UI(triIdx * 3, triIdx * 3 + 1, triIdx * 3 + 2);
+		}
+		const FIndex3UI& tri = topology.Triangles[triIdx - patchCount];
+		return FIndex3UI(tri[0] + edgeVertexOffset, tri[1] + edgeVertexOffset, tri[2] + edgeVertexOffset);
+	};
+	landBuilders.TrianglesBuilder.AppendGenerator(numTriangles, combinedTriangle);
+	seaBuilders.TrianglesBuilder.AppendGenerator(numTriangles, combinedTriangle);
+	isMeshDirty = true;
+}
+uint8 QuadTreeNode::GetEdgeVariant() const {
+	int myDepth = Index.GetDepth();
+	return FEdgeStitchTopology::MakeVariant(
+		myDepth > NeighborLods[(uint8)EdgeOrientation::LEFT],
+		myDepth > NeighborLods[(uint8)EdgeOrientation::RIGHT],
+		myDepth > NeighborLods[(uint8)EdgeOrientation::UP],
+		myDepth > NeighborLods[(uint8)EdgeOrientation::DOWN]);
+}
+FRealtimeMeshStreamRange QuadTreeNode::GetPatchStreamRange() const {
+	return FRealtimeMeshStreamRange(0, PatchTriangleCount * 3, 0, PatchTriangleCount * 3);
+}
+FRealtimeMeshStreamRange QuadTreeNode::GetEdgeStreamRange() const {
+	//The edge ring sits after the patch's one-vertex-per-corner triangles in both the vertex and index streams
+	const int32 patchElements = PatchTriangleCount * 3;
+	FRealtimeMeshStreamRange variantRange = FEdgeStitchTopology::Get(FaceResolution, FaceTransform.bFlipWinding).GetVariantRange(GetEdgeVariant());
+	return FRealtimeMeshStreamRange(
+		variantRange.Vertices.GetLowerBoundValue() + patchElements, variantRange.Vertices.GetUpperBoundValue() + patchElements,
+		variantRange.Indices.GetLowerBoundValue() + patchElements, variantRange.Indices.GetUpperBoundValue() + patchElements);
 }
\ No newline at end of file
@@ -8,12 +8,30 @@
 #include "FastNoise/FastNoise.h"
 
 #include <Mesh/RealtimeMeshSimpleData.h>
+#include "RealtimeMeshDataOptimizer.h"
 #include "PlanetNoise.h"
+#include <atomic>
 
 class APlanetActor;
 class URealtimeMeshSimple; // Forward declaration
-
-class PROCTREEMODULE_API QuadTreeNode : public TSharedFromThis<QuadTreeNode>
+namespace RealtimeMesh { class FRealtimeMeshSectionGroupSimple; }
+class FQuadTreeNodePool;
+struct FNodeRef;
+
+//Lifecycle of a node's chunk. Transitions are made with compare/exchange so the LOD pass, the mesh pass and the
+//render thread callbacks can all touch a node without a global lock.
+enum class ENodeState : uint8 {
+	Allocated,	//Structural only, no chunk or mesh
+	Generating,	//Chunk created, mesh data being built on a worker
+	Ready,		//Mesh data built, waiting for the mesh pass to upload it
+	Uploading,	//Section groups submitted, waiting on the proxy
+	Visible,	//Drawn
+	Hidden,		//Has a mesh but is covered by its children or retained after a merge
+	Evicted,	//Hidden ancestor whose CPU and GPU mesh data was released under the residency budget
+	Retiring	//Chunk destroyed or being destroyed, terminal
+};
+
+class PROCTREEMODULE_API QuadTreeNode
 {
 public:
 	QuadTreeNode(
@@ -32,9 +50,12 @@ public:
 	APlanetActor* ParentActor;
 	TSharedPtr<INoiseGenerator> NoiseGen;
 
-	//Family & Neighbor Data
-	TWeakPtr<QuadTreeNode> Parent;
-	TArray<TSharedPtr<QuadTreeNode>> Children;
+	//Family & Neighbor Data, nodes live in the planet's pool and link to each other by handle/block index
+	FQuadTreeNodePool* Pool = nullptr;
+	FNodeHandle Handle; //Stamped by the pool on construction
+	FNodeHandle Parent;
+	uint32 ChildBlock = InvalidNodeBlock; //Four children in morton order
+	uint32 RetainedBlock = InvalidNodeBlock; //Hidden children of a recent merge, reused if the node splits again
 	int NeighborLods[4] = { 0,0,0,0 };
 	
 	//Initialization Data
@@ -53,23 +74,27 @@ public:
 	double QuarterSize;
 
 	//State
-	bool HasGenerated = false;
-	bool IsRestructuring = false;
-	bool CanMerge = false;
-	bool IsInitialized = false;
-	bool LastRenderedState = false;
+	std::atomic<ENodeState> State { ENodeState::Allocated };
+	std::atomic<bool> HasGenerated { false };
+	std::atomic<bool> IsRestructuring { false }; //Held by whoever is splitting/merging this node
+	std::atomic<bool> CanMerge { false };
+	std::atomic<bool> IsInitialized { false };
 	bool RenderSea = false;
+	std::atomic<double> LastLodChangeTime { 0.0 }; //When this node last became a leaf, drives the min lifetime and retention timers. Written on the game thread, read by the LOD pass
+	double LastVisibleTime = 0.0; //When this node was last hidden, orders eviction of hidden ancestors
+	std::atomic<int64> ResidentBytes { 0 }; //What this node currently contributes to the planet's residency counter
 
 	//Computed Bound/Centroid Data
-	FVector LandCentroid;
-	FVector SeaCentroid;
-	FVector SphereCentroid;
-	double MaxNodeRadius;
-	double MinLandRadius;
-	double MaxLandRadius;
+	FVector LandCentroid = FVector::ZeroVector;
+	FVector SeaCentroid = FVector::ZeroVector;
+	FVector SphereCentroid = FVector::ZeroVector;
+	double MaxNodeRadius = 0.0;
+	double MinLandRadius = 0.0;
+	double MaxLandRadius = 0.0;
 
 	//Mesh State Data
 	int FaceResolution;
+	ECubeSphereProjection Projection;
 	TArray<FVector> LandVertices;
 	TArray<FVector3f> LandNormals;
 	TArray<FColor> LandColors;
@@ -83,38 +108,68 @@ public:
 	//RT Mesh
 	//Mesh Keys
 	FRealtimeMeshLODKey LodKey = FRealtimeMeshLODKey::FRealtimeMeshLODKey(0);
-	FRealtimeMeshSectionGroupKey LandGroupKeyInner = FRealtimeMeshSectionGroupKey::Create(LodKey, "land_inner");
-	FRealtimeMeshSectionGroupKey SeaGroupKeyInner = FRealtimeMeshSectionGroupKey::Create(LodKey, "sea_inner");
-	FRealtimeMeshSectionKey LandSectionKeyInner = FRealtimeMeshSectionKey::CreateForPolyGroup(LandGroupKeyInner, 0);
-	FRealtimeMeshSectionKey SeaSectionKeyInner = FRealtimeMeshSectionKey::CreateForPolyGroup(SeaGroupKeyInner, 1);
-	FRealtimeMeshSectionGroupKey LandGroupKeyEdge = FRealtimeMeshSectionGroupKey::Create(LodKey, "land_edge");
-	FRealtimeMeshSectionGroupKey SeaGroupKeyEdge = FRealtimeMeshSectionGroupKey::Create(LodKey, "sea_edge");
-	FRealtimeMeshSectionKey LandSectionKeyEdge = FRealtimeMeshSectionKey::CreateForPolyGroup(LandGroupKeyEdge, 0);
-	FRealtimeMeshSectionKey SeaSectionKeyEdge = FRealtimeMeshSectionKey::CreateForPolyGroup(SeaGroupKeyEdge, 1);
+	//One group per material holding the patch followed by the edge ring, so the merged draw path can join the two sections
+	FRealtimeMeshSectionGroupKey LandGroupKey = FRealtimeMeshSectionGroupKey::Create(LodKey, "land");
+	FRealtimeMeshSectionGroupKey SeaGroupKey = FRealtimeMeshSectionGroupKey::Create(LodKey, "sea");
+	FRealtimeMeshSectionKey LandSectionKeyInner = FRealtimeMeshSectionKey::Create(LandGroupKey, "inner");
+	FRealtimeMeshSectionKey SeaSectionKeyInner = FRealtimeMeshSectionKey::Create(SeaGroupKey, "inner");
+	FRealtimeMeshSectionKey LandSectionKeyEdge = FRealtimeMeshSectionKey::Create(LandGroupKey, "edge");
+	FRealtimeMeshSectionKey SeaSectionKeyEdge = FRealtimeMeshSectionKey::Create(SeaGroupKey, "edge");
 	
 	//Streams, Chunks, & RT Mesh
-	FRealtimeMeshStreamSet LandMeshStreamInner;
-	FRealtimeMeshStreamSet SeaMeshStreamInner;
-	FRealtimeMeshStreamSet LandMeshStreamEdge;
-	FRealtimeMeshStreamSet SeaMeshStreamEdge;
+	FRealtimeMeshStreamSet LandMeshStream;
+	FRealtimeMeshStreamSet SeaMeshStream;
+	int32 PatchTriangleCount = 0; //Patch triangles at the front of each stream set, the edge ring starts right after them
+
+	//Land, sea. Held so workers can reach the groups' CPU copy without the UObject
+	TSharedPtr<RealtimeMesh::FRealtimeMeshSectionGroupSimple> SectionGroups[2];
+
+	//Compressed copies of the uploaded streams, these replace the section groups' CPU copy while the node is hidden
+	FRealtimeMeshEncodedStreamSet LandMeshEncoded;
+	FRealtimeMeshEncodedStreamSet SeaMeshEncoded;
+	std::atomic<bool> IsMeshEncoded = false;
+	int64 UploadedBytes = 0; //Size of what was last uploaded
 	URealtimeMeshComponent* ChunkComponent;
 	URealtimeMeshSimple* RtMesh;
 	
 	//LOD Update Functions
-	void UpdateLod();
-	void UpdateNeighbors();//Recursively propagates neighbor updates 
+	void NotifyNeighbors();//Queues neighbor checks for the leaves bordering this node after a split/merge
 	bool CheckNeighbors(); //Checks the relevant neighbors for a node
-	void TrySetLod();
+	void WriteLodBounds(FLodLeafBounds& OutBounds, int32 InIndex) const; //Fills this leaf's slot of the pass's SoA buffer
+	void ReleaseExpiredChildren(double InNow);
+	void ApplyLodCommand(ELodCommand InCommand, double InNow);
 	void TryMerge();
-	bool ShouldMerge(double d2, double parentSize, double fov, double k);
-	static void Merge(TSharedPtr<QuadTreeNode> inNode);
-	bool ShouldSplit(double d1, double fov, double k);
-	static void Split(TSharedPtr<QuadTreeNode> inNode);
+	static void Merge(QuadTreeNode* inNode);
+	static void Split(QuadTreeNode* inNode);
+	void CreateChildren();
+	static void AllocateToDepth(QuadTreeNode* inNode, int inDepth, TArray<QuadTreeNode*>& OutLeaves);
+	static void ReleaseRetainedChildren(QuadTreeNode* inNode);
+
+	//State transitions
+	ENodeState GetState() const { return State.load(); }
+	bool TryTransition(ENodeState InFrom, ENodeState InTo);
+	void SetRenderedState(bool bInVisible); //Visible/Hidden unless the node is already retiring
+	bool TryBeginRestructure();
+	void EndRestructure();
 
 	//Data checks, leaf collection
 	bool IsLeaf() const;
 	int GetDepth() const; //This also represents the current LOD level
-	static void CollectLeaves(TSharedPtr<QuadTreeNode> InNode, TArray<TSharedPtr<QuadTreeNode>>& LeafNodes);
+	QuadTreeNode* GetChild(int InChild) const;
+	QuadTreeNode* GetParent() const; //Null for roots or once the parent has been freed
+	bool IsAlive() const;
+	FNodeRef GetRef() const; //For capture by async work, resolves to null if the node is freed in the meantime
+	static void CollectLeaves(QuadTreeNode* InNode, TArray<QuadTreeNode*>& LeafNodes);
+	static void CollectHiddenAncestors(QuadTreeNode* InNode, TArray<QuadTreeNode*>& OutNodes);
+
+	//Residency
+	SIZE_T ComputeResidentBytes() const; //CPU arrays, raw and encoded streams plus the GPU copy of the streams
+	void AccountResidentBytes(); //Caller holds MeshDataLock
+	void AccountUploadBytes(); //Records the current streams as what the GPU holds
+	void EncodeMeshData(); //Worker thread
+	bool DecodeMeshData(); //Worker thread
+	void EvictMeshData(); //Game thread
+	void RestoreMeshData();
 
 	//Chunk lifecycle
 	void InitializeChunk();
@@ -122,20 +177,27 @@ public:
 	void DestroyChunk();
 
 	//Mesh Generation
-	FMeshStreamBuilders InitializeStreamBuilders(FRealtimeMeshStreamSet& inMeshStream, int Resolution);
+	FMeshStreamBuilders InitializeStreamBuilders(FRealtimeMeshStreamSet& inMeshStream, int NumVertices, int NumTriangles);
+	//Appends Vertices[i], Colors[i], TexCoords[i] and tangents from Normals[i] for each i in Indices
+	void AppendGatheredVertices(FMeshStreamBuilders& Builders, const TArray<FVector>& Vertices, const TArray<FColor>& Colors, const TArray<FVector3f>& Normals, TConstArrayView<int32> Indices);
 	FColor EncodeDepthColor(float depth);
 	FVector GetFacePoint(float step, double x, double y);
+	FVector ProjectToSphere(const FVector& InCubePoint) const;
 	int VisibleVertexCount = 0;
 	int GenerateVertex(double x, double y, double step);
-	void RemoveChildren(TSharedPtr<QuadTreeNode> InNode);
-	bool isPatchDirty = false;
-	bool isEdgeDirty = false;
-
-	void UpdateEdgeMeshBuffer();
-	void UpdatePatchMeshBuffer();
+	void RemoveChildren(QuadTreeNode* InNode);
+	void DestroyBlock(uint32 InBlock);
+	std::atomic<bool> isMeshDirty { false };
+	std::atomic<bool> isEdgeRangeDirty { false };
+
+	void UpdateMeshBuffers(); //Patch then edge ring, into the land and sea stream sets
+	uint8 GetEdgeVariant() const;
+	FRealtimeMeshStreamRange GetPatchStreamRange() const;
+	FRealtimeMeshStreamRange GetEdgeStreamRange() const;
 	void GenerateMeshData();
 	void UpdateMesh(); 
-	void UpdateAllMesh();
+	void SubmitMeshUpdates(); //Game thread side of UpdateMesh
+	void UpdateAllMesh(uint32 InGeneration); //Root only, InGeneration is the planet's init generation that claimed the face
 protected:
 	FRWLock MeshDataLock;
 };
\ No newline at end of file
@@ -0,0 +1,131 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "QuadTreeNodePool.h"
+
+FQuadTreeNodePool::~FQuadTreeNodePool()
+{
+	for (uint32 pageIndex = 0; pageIndex < MaxPages; pageIndex++) {
+		FPage* page = Pages[pageIndex].load();
+		if (!page) break;
+		for (uint32 slot = 0; slot < SlotsPerPage; slot++) {
+			if (page->Constructed[slot]) {
+				reinterpret_cast<QuadTreeNode*>(&page->Nodes[slot])->~QuadTreeNode();
+			}
+		}
+		delete page;
+	}
+}
+
+uint32 FQuadTreeNodePool::AllocateBlock()
+{
+	FScopeLock Lock(&AllocLock);
+	if (FreeBlocks.Num() > 0) {
+		return FreeBlocks.Pop(false);
+	}
+	uint32 block = NextUnusedBlock++;
+	uint32 pageIndex = block / BlocksPerPage;
+	check(pageIndex < MaxPages);
+	if (!Pages[pageIndex].load(std::memory_order_relaxed)) {
+		Pages[pageIndex].store(new FPage(), std::memory_order_release);
+	}
+	return block;
+}
+
+QuadTreeNode* FQuadTreeNodePool::Construct(uint32 InBlock, uint32 InSlot, TFunctionRef<QuadTreeNode*(void*)> InPlacementNew)
+{
+	uint32 slotIndex = InBlock * SlotsPerBlock + InSlot;
+	FPage* page = Pages[slotIndex / SlotsPerPage].load(std::memory_order_acquire);
+	uint32 pageSlot = slotIndex % SlotsPerPage;
+	check(!page->Constructed[pageSlot]);
+
+	QuadTreeNode* node = InPlacementNew(&page->Nodes[pageSlot]);
+	node->Pool = this;
+	node->Handle.Index = slotIndex;
+	node->Handle.Generation = page->Generations[pageSlot].load();
+	page->Constructed[pageSlot] = true;
+	return node;
+}
+
+void FQuadTreeNodePool::ReleaseBlock(uint32 InBlock)
+{
+	if (InBlock == InvalidNodeBlock) return;
+	FPage* page = Pages[(InBlock * SlotsPerBlock) / SlotsPerPage].load(std::memory_order_acquire);
+	for (uint32 slot = 0; slot < SlotsPerBlock; slot++) {
+		page->Generations[(InBlock * SlotsPerBlock + slot) % SlotsPerPage].fetch_add(1);
+	}
+	FScopeLock Lock(&AllocLock);
+	PendingBlocks.Add({ InBlock, FPlatformTime::Seconds() });
+}
+
+void FQuadTreeNodePool::Reclaim(double InNow)
+{
+	FScopeLock Lock(&AllocLock);
+	//Pending blocks are appended in release order, so the expired ones are always at the front. A pinned one stays
+	//pending without holding up the ones behind it.
+	for (int32 i = 0; i < PendingBlocks.Num() && InNow - PendingBlocks[i].ReleaseTime >= ReclaimDelaySeconds;) {
+		uint32 block = PendingBlocks[i].Block;
+		if (IsBlockPinned(block)) {
+			i++;
+			continue;
+		}
+		DestroyBlock(block);
+		FreeBlocks.Add(block);
+		PendingBlocks.RemoveAt(i, 1, false);
+	}
+}
+
+void FQuadTreeNodePool::DestroyBlock(uint32 InBlock)
+{
+	FPage* page = Pages[(InBlock * SlotsPerBlock) / SlotsPerPage].load(std::memory_order_acquire);
+	for (uint32 slot = 0; slot < SlotsPerBlock; slot++) {
+		uint32 pageSlot = (InBlock * SlotsPerBlock + slot) % SlotsPerPage;
+		if (page->Constructed[pageSlot]) {
+			reinterpret_cast<QuadTreeNode*>(&page->Nodes[pageSlot])->~QuadTreeNode();
+			page->Constructed[pageSlot] = false;
+		}
+	}
+}
+
+QuadTreeNode* FQuadTreeNodePool::Resolve(FNodeHandle InHandle) const
+{
+	if (!InHandle.IsSet() || InHandle.Index / SlotsPerPage >= MaxPages) return nullptr;
+	FPage* page = Pages[InHandle.Index / SlotsPerPage].load(std::memory_order_acquire);
+	if (!page || page->Generations[InHandle.Index % SlotsPerPage].load() != InHandle.Generation) return nullptr;
+	return reinterpret_cast<QuadTreeNode*>(&page->Nodes[InHandle.Index % SlotsPerPage]);
+}
+
+FPinnedNode FQuadTreeNodePool::Pin(FNodeHandle InHandle)
+{
+	if (!InHandle.IsSet() || InHandle.Index / SlotsPerPage >= MaxPages) return FPinnedNode();
+	FPage* page = Pages[InHandle.Index / SlotsPerPage].load(std::memory_order_acquire);
+	if (!page) return FPinnedNode();
+	uint32 pageSlot = InHandle.Index % SlotsPerPage;
+	//Pin before checking the generation. Release bumps the generation before the block can be reclaimed, so either
+	//Reclaim sees this pin and skips the block or the generation check here fails.
+	page->Pins[pageSlot].fetch_add(1);
+	if (page->Generations[pageSlot].load() != InHandle.Generation) {
+		page->Pins[pageSlot].fetch_sub(1);
+		return FPinnedNode();
+	}
+	return FPinnedNode(AsShared(), reinterpret_cast<QuadTreeNode*>(&page->Nodes[pageSlot]), InHandle.Index);
+}
+
+bool FQuadTreeNodePool::IsBlockPinned(uint32 InBlock) const
+{
+	FPage* page = Pages[(InBlock * SlotsPerBlock) / SlotsPerPage].load(std::memory_order_acquire);
+	for (uint32 slot = 0; slot < SlotsPerBlock; slot++) {
+		if (page->Pins[(InBlock * SlotsPerBlock + slot) % SlotsPerPage].load() > 0) return true;
+	}
+	return false;
+}
+
+void FQuadTreeNodePool::Unpin(uint32 InSlot)
+{
+	FPage* page = Pages[InSlot / SlotsPerPage].load(std::memory_order_acquire);
+	page->Pins[InSlot % SlotsPerPage].fetch_sub(1);
+}
+
+int32 FQuadTreeNodePool::GetLiveBlockCount() const
+{
+	FScopeLock Lock(&AllocLock);
+	return (int32)NextUnusedBlock - FreeBlocks.Num() - PendingBlocks.Num();
+}
\ No newline at end of file
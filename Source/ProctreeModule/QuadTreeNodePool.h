@@ -0,0 +1,122 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "QuadTreeNode.h"
+#include <atomic>
+
+class FPinnedNode;
+
+//Owns every QuadTreeNode of a planet. Nodes live in fixed pages that never move and are handed out four at a time so
+//siblings sit next to each other; parents address their children by a single 32 bit block index. Lifetime is tracked
+//with per slot generation counters, a released block fails to resolve immediately. Its memory is only destroyed and
+//reused once nothing has it pinned, async work pins the nodes it uses so it can outlast any delay. The grace period on
+//top covers the tree passes, which walk raw child pointers under the face lock rather than pinning every node.
+class PROCTREEMODULE_API FQuadTreeNodePool : public TSharedFromThis<FQuadTreeNodePool, ESPMode::ThreadSafe>
+{
+public:
+	static constexpr uint32 SlotsPerBlock = 4;
+	static constexpr uint32 BlocksPerPage = 64;
+	static constexpr uint32 SlotsPerPage = BlocksPerPage * SlotsPerBlock;
+	static constexpr uint32 MaxPages = 4096;
+	static constexpr double ReclaimDelaySeconds = 2.0;
+
+	FQuadTreeNodePool() = default;
+	~FQuadTreeNodePool();
+
+	uint32 AllocateBlock();
+	//Placement constructs a node in a slot of an allocated block and stamps its pool handle
+	QuadTreeNode* Construct(uint32 InBlock, uint32 InSlot, TFunctionRef<QuadTreeNode*(void*)> InPlacementNew);
+	void ReleaseBlock(uint32 InBlock);
+	//Destroys released blocks whose grace period is over and that nothing has pinned, and makes them available again
+	void Reclaim(double InNow);
+
+	FORCEINLINE QuadTreeNode* GetNode(uint32 InSlot) const {
+		FPage* page = Pages[InSlot / SlotsPerPage].load(std::memory_order_acquire);
+		return reinterpret_cast<QuadTreeNode*>(&page->Nodes[InSlot % SlotsPerPage]);
+	}
+	FORCEINLINE QuadTreeNode* GetChild(uint32 InBlock, uint32 InChild) const {
+		return GetNode(InBlock * SlotsPerBlock + InChild);
+	}
+	QuadTreeNode* Resolve(FNodeHandle InHandle) const;
+	//Resolves and keeps the node's memory alive until the returned pin goes away
+	FPinnedNode Pin(FNodeHandle InHandle);
+
+	int32 GetLiveBlockCount() const;
+
+private:
+	struct FPage {
+		TTypeCompatibleBytes<QuadTreeNode> Nodes[SlotsPerPage];
+		std::atomic<uint32> Generations[SlotsPerPage];
+		std::atomic<uint32> Pins[SlotsPerPage];
+		bool Constructed[SlotsPerPage];
+	};
+	struct FPendingBlock {
+		uint32 Block;
+		double ReleaseTime;
+	};
+
+	void DestroyBlock(uint32 InBlock);
+	bool IsBlockPinned(uint32 InBlock) const;
+	void Unpin(uint32 InSlot);
+
+	friend class FPinnedNode;
+
+	std::atomic<FPage*> Pages[MaxPages] = {};
+	uint32 NextUnusedBlock = 0;
+	TArray<uint32> FreeBlocks;
+	TArray<FPendingBlock> PendingBlocks;
+	mutable FCriticalSection AllocLock;
+};
+
+//A resolved node that can't be destroyed until this goes away. Hold it for as long as the node is used, not just
+//for the lookup.
+class PROCTREEMODULE_API FPinnedNode {
+public:
+	FPinnedNode() = default;
+	FPinnedNode(FPinnedNode&& Other) : Pool(MoveTemp(Other.Pool)), Node(Other.Node), Slot(Other.Slot) { Other.Node = nullptr; }
+	FPinnedNode& operator=(FPinnedNode&& Other) {
+		if (this != &Other) {
+			Reset();
+			Pool = MoveTemp(Other.Pool);
+			Node = Other.Node;
+			Slot = Other.Slot;
+			Other.Node = nullptr;
+		}
+		return *this;
+	}
+	FPinnedNode(const FPinnedNode&) = delete;
+	FPinnedNode& operator=(const FPinnedNode&) = delete;
+	~FPinnedNode() { Reset(); }
+
+	void Reset() {
+		if (Node) {
+			Pool->Unpin(Slot);
+			Node = nullptr;
+		}
+		Pool.Reset();
+	}
+
+	QuadTreeNode* Get() const { return Node; }
+	QuadTreeNode* operator->() const { return Node; }
+	QuadTreeNode& operator*() const { return *Node; }
+	explicit operator bool() const { return Node != nullptr; }
+
+private:
+	friend class FQuadTreeNodePool;
+	FPinnedNode(TSharedPtr<FQuadTreeNodePool, ESPMode::ThreadSafe> InPool, QuadTreeNode* InNode, uint32 InSlot) : Pool(MoveTemp(InPool)), Node(InNode), Slot(InSlot) {}
+
+	TSharedPtr<FQuadTreeNodePool, ESPMode::ThreadSafe> Pool;
+	QuadTreeNode* Node = nullptr;
+	uint32 Slot = 0;
+};
+
+//What async work captures in place of a shared pointer. Holding the pool keeps the pages around, pinning the handle
+//fails once the node has been released.
+struct PROCTREEMODULE_API FNodeRef {
+	TSharedPtr<FQuadTreeNodePool, ESPMode::ThreadSafe> Pool;
+	FNodeHandle Handle;
+
+	FPinnedNode Pin() const { return Pool.IsValid() ? Pool->Pin(Handle) : FPinnedNode(); }
+};
\ No newline at end of file